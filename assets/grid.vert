@@ -3,9 +3,14 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec4 aColor;
 layout (location = 2) in float aVisibility;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec3 viewPosition;
+    float ambientStrength;
+    vec3 lightColor;
+};
 uniform float detailVisibility1;
 uniform float detailVisibility2;
 
@@ -13,8 +18,7 @@ out vec4 vertexColor;
 out float visibility;
 
 void main() {
-    vec4 viewPos = view * model * vec4(aPos, 1.0);
-    gl_Position = projection * viewPos;
+    gl_Position = viewProjection * vec4(aPos, 1.0);
 
     visibility = aVisibility;
     vertexColor = aColor;
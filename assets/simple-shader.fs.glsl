@@ -6,10 +6,23 @@ in vec2 TexCoord;
 in vec3 FragPos;
 in vec3 Normal;
 
-uniform float viewPos;
-uniform vec3 lightColor;
-uniform float ambientStrength;
-uniform vec3 albedo;
+layout (std140) uniform FrameData
+{
+	mat4 view;
+	mat4 projection;
+	mat4 viewProjection;
+	vec3 viewPosition;
+	float ambientStrength;
+	vec3 lightColor;
+};
+
+layout (std140) uniform MaterialData
+{
+	vec3 albedo;
+	float metallic;
+	float roughness;
+	float ao;
+};
 
 void main()
 {
@@ -17,7 +30,7 @@ void main()
 	vec3 norm = normalize(Normal);
 
 	// Calculate view direction
-	vec3 viewDir = normalize(viewPos - FragPos);
+	vec3 viewDir = normalize(viewPosition - FragPos);
 
 	// Ambient lighting
 	vec3 ambient = ambientStrength * lightColor;
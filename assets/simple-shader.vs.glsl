@@ -3,19 +3,46 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
+layout (location = 3) in mat4 aModel; // Per instance, locations 3-6
+// Per instance inverse transpose of the model matrix, computed on the CPU when the transform changes
+layout (location = 7) in mat3 aNormalMatrix; // Locations 7-9
+// Per instance dequantization for compact vertex buffers; scale 1 and offset 0 for float meshes
+layout (location = 10) in vec4 aPositionScale;
+layout (location = 11) in vec4 aPositionOffset;
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoord;
 
-uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+layout (std140) uniform FrameData
+{
+	mat4 view;
+	mat4 projection;
+	mat4 viewProjection;
+	vec3 viewPosition;
+	float ambientStrength;
+	vec3 lightColor;
+};
+
+// Set per geometry arena pool; only octahedral quantized pools use it
+uniform bool octahedralNormals;
+
+vec3 decodeOctahedral(vec2 e)
+{
+	vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+	float t = max(-n.z, 0.0);
+	n.x += n.x >= 0.0 ? -t : t;
+	n.y += n.y >= 0.0 ? -t : t;
+	return normalize(n);
+}
 
 void main()
 {
-	FragPos = vec3(model * vec4(aPos, 1.0));
-	Normal = mat3(transpose(inverse(model))) * aNormal;
+	vec3 position = aPositionOffset.xyz + aPos * aPositionScale.xyz;
+	vec3 normal = octahedralNormals ? decodeOctahedral(aNormal.xy) : aNormal;
+
+	FragPos = vec3(aModel * vec4(position, 1.0));
+	Normal = aNormalMatrix * normal;
 	TexCoord = aTexCoords;
-	gl_Position = projection * view * vec4(FragPos, 1.0);
+	gl_Position = viewProjection * vec4(FragPos, 1.0);
 }
\ No newline at end of file
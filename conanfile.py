@@ -10,6 +10,12 @@ class ThreeDive(ConanFile):
     settings = "os", "compiler", "build_type", "arch"
     generators = "CMakeDeps", "CMakeToolchain"
     tool_requires = "cmake/3.22.6"
+    # glGetProgramBinary/glProgramBinary are core in 4.1 and exposed to 3.3 contexts via the ARB extension.
+    # Multi-draw indirect with base instances is 4.3; it is detected at runtime through its extensions.
+    default_options = {
+        "glad/*:gl_version": "4.1",
+        "glad/*:extensions": "GL_ARB_get_program_binary,GL_ARB_multi_draw_indirect,GL_ARB_base_instance",
+    }
 
     def requirements(self):
         requirements = self.conan_data.get('requirements', [])
@@ -148,6 +148,9 @@ namespace s3Dive {
         };
 
         std::visit(updateProjectionVisitor, cameraVariant_);
+
+        const auto& camera = getCamera();
+        frustum_ = Frustum::fromViewProjection(camera.getProjectionMatrix() * camera.getViewMatrix());
     }
 
     const Camera& CameraController::getCamera() const
@@ -160,6 +163,11 @@ namespace s3Dive {
         return std::visit([](auto& camera) -> Camera& { return camera; }, cameraVariant_);
     }
 
+    const Frustum& CameraController::getFrustum() const
+    {
+        return frustum_;
+    }
+
     void CameraController::updatePerspectiveProjection(PerspectiveCamera& camera) const {
         glm::mat4 projectionMatrix = glm::perspective(glm::radians(settings_.fieldOfView), aspectRatio_, settings_.nearPlane, settings_.farPlane);
         camera.setProjectionMatrix(projectionMatrix);
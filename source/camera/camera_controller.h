@@ -11,6 +11,7 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include "../events/event.h"
 #include "camera.h"
+#include "frustum.h"
 #include "perspective_camera.h"
 #include "orthographic_camera.h"
 
@@ -42,6 +43,8 @@ namespace s3Dive {
         [[nodiscard]] float getDistanceToTarget() const;
         [[nodiscard]] const Camera& getCamera() const;
         [[nodiscard]] Camera& getCamera();
+        // Planes of the current camera, refreshed by update()
+        [[nodiscard]] const Frustum& getFrustum() const;
 
         template<class... Ts> struct overloaded : Ts... { using Ts::operator()...; };
         template<class... Ts> overloaded(Ts...) -> overloaded<Ts...>;
@@ -51,6 +54,7 @@ namespace s3Dive {
         using CameraVariant = std::variant<PerspectiveCamera, OrthographicCamera>;
         CameraVariant cameraVariant_;
         CameraSettings settings_;
+        Frustum frustum_;
 
         glm::vec3 position_{};
         glm::vec2 lastMousePos_{};
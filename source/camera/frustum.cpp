@@ -0,0 +1,47 @@
+#include "frustum.h"
+
+namespace s3Dive {
+
+    Frustum Frustum::fromViewProjection(const glm::mat4& viewProjection) {
+        // glm is column-major, so row i of the matrix is (m[0][i], m[1][i], m[2][i], m[3][i])
+        auto row = [&viewProjection](int i) {
+            return glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+        };
+        const glm::vec4 x = row(0);
+        const glm::vec4 y = row(1);
+        const glm::vec4 z = row(2);
+        const glm::vec4 w = row(3);
+
+        Frustum frustum;
+        frustum.planes[Left] = w + x;
+        frustum.planes[Right] = w - x;
+        frustum.planes[Bottom] = w + y;
+        frustum.planes[Top] = w - y;
+        frustum.planes[Near] = w + z;
+        frustum.planes[Far] = w - z;
+        for (auto& plane : frustum.planes) {
+            plane /= glm::length(glm::vec3(plane));
+        }
+        return frustum;
+    }
+
+    bool Frustum::intersectsBox(const glm::vec3& center, const glm::vec3& extent) const {
+        for (const auto& plane : planes) {
+            const glm::vec3 normal(plane);
+            if (glm::dot(normal, center) + plane.w < -glm::dot(glm::abs(normal), extent)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Frustum::intersectsSphere(const glm::vec3& center, float radius) const {
+        for (const auto& plane : planes) {
+            if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace s3Dive
@@ -0,0 +1,25 @@
+#ifndef THREEDIVE_FRUSTUM_H
+#define THREEDIVE_FRUSTUM_H
+
+#include <array>
+#include <glm/glm.hpp>
+
+namespace s3Dive {
+
+    // Six world-space planes (xyz = inward unit normal, w = distance) bounding what a camera sees
+    struct Frustum {
+        enum Plane { Left, Right, Bottom, Top, Near, Far, PlaneCount };
+
+        std::array<glm::vec4, PlaneCount> planes{};
+
+        // Gribb-Hartmann extraction from an OpenGL projection * view matrix (clip z in [-w, w])
+        [[nodiscard]] static Frustum fromViewProjection(const glm::mat4& viewProjection);
+
+        // Conservative: boxes straddling a corner outside two planes count as visible
+        [[nodiscard]] bool intersectsBox(const glm::vec3& center, const glm::vec3& extent) const;
+        [[nodiscard]] bool intersectsSphere(const glm::vec3& center, float radius) const;
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_FRUSTUM_H
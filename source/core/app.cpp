@@ -1,6 +1,10 @@
 #include "app.h"
 #include <glm/gtc/type_ptr.hpp>
+#include "../renderer/GeometryArena.h"
 #include "../renderer/RenderCommand.h"
+#include "../renderer/Renderer.h"
+#include "../renderer/TextureCache.h"
+#include "../platform/openGLRender/gl_program_binary_cache.h"
 #include "geo_generator.h"
 #include "window.h"
 #include <spdlog/spdlog.h>
@@ -28,26 +32,26 @@ namespace s3Dive {
         });
     }
 
-    App::~App() = default;
+    App::~App() {
+        // Pixel buffers must be released while the window's GL context is still alive
+        TextureCache::instance().shutdown();
+        Renderer::shutdown();
+        GeometryArena::instance().shutdown();
+    }
 
     bool App::initialize() {
-        RenderCommand::init();
+        Renderer::init();
         initializeGrid();
         initializeSystems();
 
-
-        glEnable(GL_DEPTH_TEST);
-
         gridShader_.initFromFiles("grid.vert", "grid.frag");
         defaultShaderProgram_.initFromFiles("simple-shader.vs.glsl", "simple-shader.fs.glsl");
+        GLProgramBinaryCache::instance().logStatistics();
+        Renderer::bindUniformBlocks(gridShader_);
+        Renderer::bindUniformBlocks(defaultShaderProgram_);
 
-        try {
-            meshLoadingSystem_.loadModel(scene_, "obj.fbx");
-                spdlog::info("Model added successfully with UUID: {}");
-        } catch (const std::exception& e) {
-            spdlog::error("Failed to add model: {}", e.what());
-            // Handle the error appropriately
-        }
+        // Meshes show up progressively as meshLoadingSystem_ uploads them in run()
+        meshLoadingSystem_.loadModelAsync(scene_, "obj.fbx");
         // Create default lights
         //createDefaultLights();
 
@@ -59,8 +63,8 @@ namespace s3Dive {
         while (!glfwWindowShouldClose(window_->getNativeWindow())) {
             window_->onUpdate();
             cameraController_.update();
-            systems_.update(scene_, 0);
-            defaultRenderSystem.update(scene_, 0);
+            scheduler_.update(scene_, 0);
+            TextureCache::instance().update();
 
             onRender();
         }
@@ -70,34 +74,32 @@ namespace s3Dive {
         RenderCommand::clear(GLRenderer::BufferBit::Depth, GLRenderer::BufferBit::Color);
         RenderCommand::setClearColor(glm::vec4(0.266f, 0.26f, 0.25f, 1.0f));
 
-        const auto& camera = cameraController_.getCamera();
-        glm::mat4 projection = camera.getProjectionMatrix();
-        glm::mat4 view = camera.getViewMatrix();
-        glm::mat4 model(1.0f);
-
-        // Set uniforms for grid shader
-        gridShader_.use();
-        gridShader_.updateShaderUniform("model", glm::value_ptr(model));
-        gridShader_.updateShaderUniform("view", glm::value_ptr(view));
-        gridShader_.updateShaderUniform("projection", glm::value_ptr(projection));
+        // Camera and lighting for every program, including the grid
+        Renderer::beginScene(cameraController_.getCamera());
 
         // Render grid
         systems_.render(scene_, gridShader_, cameraController_);
 
         defaultRenderSystem.render(scene_, defaultShaderProgram_, cameraController_);
+        Renderer::endScene();
     }
 
 
     void App::initializeGrid() {
         auto gridEntity = scene_.createEntity();
-        scene_.addComponent<SceneGridComponent>(scene_.getEntityUUID(gridEntity).value());
+        scene_.addComponent<SceneGridComponent>(scene_.getUUID(gridEntity));
 
     }
 
 
     void App::initializeSystems() {
-        //systems_.push_back(std::make_unique<SceneGridSystem>());
-        // Add other systems as needed
+        // Registration order settles conflicts: meshes are loaded before their world matrices are computed,
+        // and both before anything reads them this frame; the spatial index follows the bounds RenderSystem keeps
+        scheduler_.add(meshLoadingSystem_, "ModelLoadingSystem");
+        scheduler_.add(transformSystem_, "TransformSystem");
+        scheduler_.add(systems_, "SceneGridSystem");
+        scheduler_.add(defaultRenderSystem, "RenderSystem");
+        scheduler_.add(spatialIndexSystem_, "SpatialIndexSystem");
     }
 
     void App::createDefaultLights() {
@@ -10,6 +10,9 @@
 #include "window.h"
 #include "../scene/MeshLoadingSystem.h"
 #include "../scene/RenderSystem.h"
+#include "../scene/TransformSystem.h"
+#include "../scene/SpatialIndexSystem.h"
+#include "../scene/SystemScheduler.h"
 #include <memory>
 #include <vector>
 
@@ -36,6 +39,9 @@ namespace s3Dive {
         SceneGridSystem systems_;
         RenderSystem defaultRenderSystem;
         ModelLoadingSystem meshLoadingSystem_;
+        TransformSystem transformSystem_;
+        SpatialIndexSystem spatialIndexSystem_;
+        SystemScheduler scheduler_;
 
 
         void onRender();
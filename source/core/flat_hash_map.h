@@ -0,0 +1,160 @@
+#ifndef THREEDIVE_FLAT_HASH_MAP_H
+#define THREEDIVE_FLAT_HASH_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "hash.h"
+
+namespace s3Dive {
+
+    // Open-addressing hash map with linear probing over one contiguous slot array, for small trivially copyable
+    // keys and values looked up far more often than they change. A lookup is a hash and, on a hit, usually a
+    // single cache line, against a node allocation and a pointer chase per entry for std::unordered_map. Erasing
+    // shifts the rest of the probe run back instead of leaving tombstones, so lookups never slow down over time.
+    // Key and Value must be default constructible; pointers to values are invalidated by any insert or erase.
+    template<typename Key, typename Value, typename Hash = std::hash<Key>>
+    class FlatHashMap {
+    public:
+        FlatHashMap() = default;
+
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+        [[nodiscard]] std::size_t capacity() const noexcept { return slots_.size(); }
+
+        // Grows so count entries fit without rehashing
+        void reserve(std::size_t count) {
+            std::size_t capacity = kMinCapacity;
+            while (count * kMaxLoadDenominator > capacity * kMaxLoadNumerator) {
+                capacity *= 2;
+            }
+            if (capacity > slots_.size()) {
+                rehash(capacity);
+            }
+        }
+
+        // Costs the capacity, not the size; keeps the slot array
+        void clear() noexcept {
+            if (size_ == 0) {
+                return;
+            }
+            std::fill(used_.begin(), used_.end(), uint8_t{0});
+            size_ = 0;
+        }
+
+        [[nodiscard]] Value* find(const Key& key) noexcept {
+            const std::size_t index = findIndex(key);
+            return index != kNotFound ? &slots_[index].value : nullptr;
+        }
+
+        [[nodiscard]] const Value* find(const Key& key) const noexcept {
+            const std::size_t index = findIndex(key);
+            return index != kNotFound ? &slots_[index].value : nullptr;
+        }
+
+        [[nodiscard]] bool contains(const Key& key) const noexcept { return findIndex(key) != kNotFound; }
+
+        // Inserts or overwrites; true when the key was new
+        bool insertOrAssign(const Key& key, const Value& value) {
+            if ((size_ + 1) * kMaxLoadDenominator > slots_.size() * kMaxLoadNumerator) {
+                rehash(slots_.empty() ? kMinCapacity : slots_.size() * 2);
+            }
+            const std::size_t mask = slots_.size() - 1;
+            for (std::size_t index = homeIndex(key);; index = (index + 1) & mask) {
+                if (!used_[index]) {
+                    used_[index] = 1;
+                    slots_[index] = {key, value};
+                    ++size_;
+                    return true;
+                }
+                if (slots_[index].key == key) {
+                    slots_[index].value = value;
+                    return false;
+                }
+            }
+        }
+
+        // True when the key was present
+        bool erase(const Key& key) noexcept {
+            std::size_t hole = findIndex(key);
+            if (hole == kNotFound) {
+                return false;
+            }
+            // Pull later entries of the run into the hole unless that would move them before their home slot
+            const std::size_t mask = slots_.size() - 1;
+            for (std::size_t index = (hole + 1) & mask; used_[index]; index = (index + 1) & mask) {
+                const std::size_t home = homeIndex(slots_[index].key);
+                if (((index - home) & mask) >= ((index - hole) & mask)) {
+                    slots_[hole] = slots_[index];
+                    hole = index;
+                }
+            }
+            used_[hole] = 0;
+            --size_;
+            return true;
+        }
+
+        // Calls f(key, value) for every entry, in no particular order
+        template<typename F>
+        void forEach(F&& f) const {
+            for (std::size_t i = 0; i < slots_.size(); ++i) {
+                if (used_[i]) {
+                    f(slots_[i].key, slots_[i].value);
+                }
+            }
+        }
+
+    private:
+        struct Slot {
+            Key key;
+            Value value;
+        };
+
+        static constexpr std::size_t kNotFound = ~std::size_t{0};
+        static constexpr std::size_t kMinCapacity = 16;
+        // Linear probing degrades quickly past this load
+        static constexpr std::size_t kMaxLoadNumerator = 3;
+        static constexpr std::size_t kMaxLoadDenominator = 4;
+
+        // std::hash of an integer is the integer itself on common standard libraries; mix before masking
+        [[nodiscard]] std::size_t homeIndex(const Key& key) const noexcept {
+            return static_cast<std::size_t>(hash::mix64(static_cast<uint64_t>(Hash{}(key)))) & (slots_.size() - 1);
+        }
+
+        [[nodiscard]] std::size_t findIndex(const Key& key) const noexcept {
+            if (size_ == 0) {
+                return kNotFound;
+            }
+            const std::size_t mask = slots_.size() - 1;
+            for (std::size_t index = homeIndex(key); used_[index]; index = (index + 1) & mask) {
+                if (slots_[index].key == key) {
+                    return index;
+                }
+            }
+            return kNotFound;
+        }
+
+        void rehash(std::size_t capacity) {
+            std::vector<Slot> slots(capacity);
+            std::vector<uint8_t> used(capacity, 0);
+            slots.swap(slots_);
+            used.swap(used_);
+            size_ = 0;
+            for (std::size_t i = 0; i < slots.size(); ++i) {
+                if (used[i]) {
+                    insertOrAssign(slots[i].key, slots[i].value);
+                }
+            }
+        }
+
+        std::vector<Slot> slots_;    // Power-of-two sized
+        std::vector<uint8_t> used_; // Kept apart so probing an empty slot does not pull in a whole Slot
+        std::size_t size_ = 0;
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_FLAT_HASH_MAP_H
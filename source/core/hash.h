@@ -0,0 +1,45 @@
+#ifndef THREEDIVE_HASH_H
+#define THREEDIVE_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace s3Dive::hash {
+
+    inline constexpr uint64_t kFnvOffsetBasis = 0xcbf29ce484222325ULL;
+    inline constexpr uint64_t kFnvPrime = 0x100000001b3ULL;
+
+    // 64-bit FNV-1a; seed with a previous result to hash several ranges as one
+    [[nodiscard]] constexpr uint64_t fnv1a64(std::string_view data, uint64_t seed = kFnvOffsetBasis) noexcept {
+        uint64_t value = seed;
+        for (char c : data) {
+            value ^= static_cast<uint8_t>(c);
+            value *= kFnvPrime;
+        }
+        return value;
+    }
+
+    [[nodiscard]] inline uint64_t fnv1a64(const void* data, std::size_t size, uint64_t seed = kFnvOffsetBasis) noexcept {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        uint64_t value = seed;
+        for (std::size_t i = 0; i < size; ++i) {
+            value ^= bytes[i];
+            value *= kFnvPrime;
+        }
+        return value;
+    }
+
+    // MurmurHash3 finalizer: spreads every input bit over the whole word, for hashes that are used masked
+    [[nodiscard]] constexpr uint64_t mix64(uint64_t value) noexcept {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+        return value;
+    }
+
+} // namespace s3Dive::hash
+
+#endif //THREEDIVE_HASH_H
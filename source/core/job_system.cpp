@@ -0,0 +1,240 @@
+#include "job_system.h"
+
+namespace s3Dive {
+
+    namespace {
+
+        // Set on worker threads only, so jobs can tell which deque is theirs
+        thread_local const JobSystem* tCurrentJobSystem = nullptr;
+        thread_local std::size_t tCurrentWorkerIndex = 0;
+        // Jobs running on this thread; a job that waits runs others nested inside its own busy time
+        thread_local int tJobDepth = 0;
+
+        // Steal attempts before an idle worker goes to sleep; covers the gap between the jobs of a tight loop
+        constexpr int kIdleSpinCount = 64;
+
+        uint64_t elapsedNanoseconds(std::chrono::steady_clock::time_point since) {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - since).count());
+        }
+
+    } // namespace
+
+    TaskGroup::TaskGroup(JobSystem& jobSystem) : jobSystem_(jobSystem) {}
+
+    TaskGroup::TaskGroup() : TaskGroup(JobSystem::instance()) {}
+
+    void TaskGroup::wait() {
+        while (pending_.load(std::memory_order_acquire) != 0) {
+            if (!jobSystem_.tryRunOne()) {
+                std::this_thread::yield();
+            }
+        }
+        // The last job drops the count while holding the lock; taking it here guarantees that job is done
+        // with this group before the caller is free to destroy it
+        std::lock_guard lock(continuationMutex_);
+    }
+
+    void TaskGroup::onJobFinished() {
+        uint32_t expected = pending_.load(std::memory_order_relaxed);
+        while (expected > 1) {
+            if (pending_.compare_exchange_weak(expected, expected - 1, std::memory_order_acq_rel)) {
+                return;
+            }
+        }
+
+        // Possibly the last job: decide about the continuation before the count can reach zero
+        std::function<void()> continuation;
+        TaskGroup* continuationGroup = nullptr;
+        {
+            std::lock_guard lock(continuationMutex_);
+            if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1 && continuation_) {
+                continuation = std::move(continuation_);
+                continuation_ = nullptr;
+                continuationGroup = continuationGroup_;
+            }
+        }
+        // This group may already be gone; only locals from here on
+        if (continuation) {
+            jobSystem_.push({std::move(continuation), continuationGroup});
+        }
+    }
+
+    JobSystem::JobSystem(std::size_t workerCount) {
+        workerCount = std::max<std::size_t>(workerCount, 1);
+        workers_.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; ++i) {
+            workers_.push_back(std::make_unique<Worker>());
+        }
+        threads_.reserve(workerCount);
+        for (std::size_t i = 0; i < workerCount; ++i) {
+            threads_.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    JobSystem::~JobSystem() {
+        {
+            std::lock_guard lock(sleepMutex_);
+            stopping_ = true;
+        }
+        sleepCondition_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    JobSystem& JobSystem::instance() {
+        static JobSystem jobSystem;
+        return jobSystem;
+    }
+
+    std::size_t JobSystem::defaultWorkerCount() noexcept {
+        // The thread that waits on a task group runs jobs too, so one worker fewer than hardware threads
+        const auto hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    int JobSystem::getCurrentWorkerIndex() const noexcept {
+        return tCurrentJobSystem == this ? static_cast<int>(tCurrentWorkerIndex) : -1;
+    }
+
+    void JobSystem::push(Job job) {
+        const int currentWorker = getCurrentWorkerIndex();
+        const std::size_t workerIndex = currentWorker >= 0
+                                        ? static_cast<std::size_t>(currentWorker)
+                                        : nextExternalWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+        auto& worker = *workers_[workerIndex];
+        {
+            std::lock_guard lock(worker.mutex);
+            worker.jobs.push_back(std::move(job));
+        }
+
+        // Sequentially consistent on both sides: either the sleeper sees the job or this sees the sleeper
+        queuedJobs_.fetch_add(1);
+        if (sleepingWorkers_.load() > 0) {
+            std::lock_guard lock(sleepMutex_);
+            sleepCondition_.notify_one();
+        }
+    }
+
+    bool JobSystem::pop(std::size_t workerIndex, Job& job) {
+        auto& worker = *workers_[workerIndex];
+        std::lock_guard lock(worker.mutex);
+        if (worker.jobs.empty()) {
+            return false;
+        }
+        job = std::move(worker.jobs.back());
+        worker.jobs.pop_back();
+        queuedJobs_.fetch_sub(1);
+        return true;
+    }
+
+    bool JobSystem::steal(std::size_t thiefIndex, Job& job) {
+        // Start after the thief so workers do not all pile onto worker 0
+        const std::size_t workerCount = workers_.size();
+        for (std::size_t offset = 1; offset <= workerCount; ++offset) {
+            const std::size_t victimIndex = (thiefIndex + offset) % workerCount;
+            if (victimIndex == thiefIndex) {
+                continue;
+            }
+            auto& victim = *workers_[victimIndex];
+            std::lock_guard lock(victim.mutex);
+            if (victim.jobs.empty()) {
+                continue;
+            }
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            queuedJobs_.fetch_sub(1);
+            return true;
+        }
+        return false;
+    }
+
+    void JobSystem::execute(Job& job) {
+        job.function();
+        if (job.group) {
+            job.group->onJobFinished();
+        }
+    }
+
+    bool JobSystem::tryRunOne() {
+        if (queuedJobs_.load(std::memory_order_relaxed) == 0) {
+            return false;
+        }
+
+        const int currentWorker = getCurrentWorkerIndex();
+        Job job;
+        if (currentWorker >= 0) {
+            const auto workerIndex = static_cast<std::size_t>(currentWorker);
+            auto& worker = *workers_[workerIndex];
+            const bool stolen = !pop(workerIndex, job);
+            if (stolen && !steal(workerIndex, job)) {
+                return false;
+            }
+            const auto start = std::chrono::steady_clock::now();
+            ++tJobDepth;
+            execute(job);
+            if (--tJobDepth == 0) {
+                worker.busyNanoseconds.fetch_add(elapsedNanoseconds(start), std::memory_order_relaxed);
+            }
+            worker.jobsExecuted.fetch_add(1, std::memory_order_relaxed);
+            worker.jobsStolen.fetch_add(stolen ? 1 : 0, std::memory_order_relaxed);
+            return true;
+        }
+
+        // Threads outside the system steal from every worker
+        if (!steal(workers_.size(), job)) {
+            return false;
+        }
+        execute(job);
+        return true;
+    }
+
+    void JobSystem::workerLoop(std::size_t workerIndex) {
+        tCurrentJobSystem = this;
+        tCurrentWorkerIndex = workerIndex;
+        auto& worker = *workers_[workerIndex];
+
+        while (!stopping_.load(std::memory_order_relaxed)) {
+            if (tryRunOne()) {
+                continue;
+            }
+
+            const auto idleStart = std::chrono::steady_clock::now();
+            bool found = false;
+            for (int spin = 0; spin < kIdleSpinCount && !found; ++spin) {
+                std::this_thread::yield();
+                found = queuedJobs_.load(std::memory_order_relaxed) > 0;
+            }
+            if (!found) {
+                std::unique_lock lock(sleepMutex_);
+                sleepingWorkers_.fetch_add(1);
+                sleepCondition_.wait(lock, [this] { return stopping_.load() || queuedJobs_.load() > 0; });
+                sleepingWorkers_.fetch_sub(1);
+            }
+            worker.idleNanoseconds.fetch_add(elapsedNanoseconds(idleStart), std::memory_order_relaxed);
+        }
+    }
+
+    std::vector<JobSystem::WorkerStatistics> JobSystem::getWorkerStatistics() const {
+        std::vector<WorkerStatistics> statistics;
+        statistics.reserve(workers_.size());
+        for (const auto& worker : workers_) {
+            statistics.push_back({worker->jobsExecuted.load(std::memory_order_relaxed),
+                                  worker->jobsStolen.load(std::memory_order_relaxed),
+                                  worker->busyNanoseconds.load(std::memory_order_relaxed),
+                                  worker->idleNanoseconds.load(std::memory_order_relaxed)});
+        }
+        return statistics;
+    }
+
+    void JobSystem::resetStatistics() {
+        for (auto& worker : workers_) {
+            worker->jobsExecuted.store(0, std::memory_order_relaxed);
+            worker->jobsStolen.store(0, std::memory_order_relaxed);
+            worker->busyNanoseconds.store(0, std::memory_order_relaxed);
+            worker->idleNanoseconds.store(0, std::memory_order_relaxed);
+        }
+    }
+
+} // namespace s3Dive
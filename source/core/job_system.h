@@ -0,0 +1,192 @@
+#ifndef THREEDIVE_JOB_SYSTEM_H
+#define THREEDIVE_JOB_SYSTEM_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace s3Dive {
+
+    class JobSystem;
+
+    // Counts the jobs spawned into it. wait() runs queued jobs instead of blocking, so it is safe to call from
+    // inside a job, from any system, and from threads that are not workers. Must outlive its jobs.
+    class TaskGroup {
+    public:
+        explicit TaskGroup(JobSystem& jobSystem);
+        TaskGroup();
+        ~TaskGroup() { wait(); }
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        template<typename F>
+        void run(F&& job);
+
+        // Returns once every job run in the group has finished, including jobs those jobs ran in it
+        void wait();
+        [[nodiscard]] bool isDone() const noexcept { return pending_.load(std::memory_order_acquire) == 0; }
+
+        // Spawns continuation as soon as the group's jobs have finished, immediately if they already have.
+        // The continuation belongs to next when given, so waiting on next also covers it. One per group.
+        template<typename F>
+        void then(F&& continuation, TaskGroup* next = nullptr);
+
+    private:
+        friend class JobSystem;
+
+        void onJobFinished();
+
+        JobSystem& jobSystem_;
+        std::atomic<uint32_t> pending_{0};
+        std::mutex continuationMutex_;
+        std::function<void()> continuation_;
+        TaskGroup* continuationGroup_ = nullptr;
+    };
+
+    // Work-stealing scheduler. Each worker owns a deque: it pushes and pops its own jobs at the back (newest
+    // first, which keeps recursive splits cache-warm) while idle workers steal from the front of the others'
+    // (oldest first, i.e. the biggest pieces of a split). Jobs spawned from threads that are not workers are
+    // dealt to the workers round-robin. Idle workers spin briefly, then sleep until a job is spawned.
+    // Jobs must not throw.
+    class JobSystem {
+    public:
+        struct WorkerStatistics {
+            uint64_t jobsExecuted = 0;
+            uint64_t jobsStolen = 0;   // Subset of jobsExecuted taken from another worker's deque
+            uint64_t busyNanoseconds = 0;
+            uint64_t idleNanoseconds = 0; // Spinning or sleeping
+
+            [[nodiscard]] double getUtilization() const noexcept {
+                const auto total = busyNanoseconds + idleNanoseconds;
+                return total ? static_cast<double>(busyNanoseconds) / static_cast<double>(total) : 0.0;
+            }
+        };
+
+        explicit JobSystem(std::size_t workerCount = defaultWorkerCount());
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // Engine-wide scheduler, started on first use
+        [[nodiscard]] static JobSystem& instance();
+        [[nodiscard]] static std::size_t defaultWorkerCount() noexcept;
+
+        // Fire and forget; use a TaskGroup to wait for it
+        void spawn(std::function<void()> job) { push({std::move(job), nullptr}); }
+
+        // Splits [0, count) into ranges and calls body(begin, end) for each, the calling thread included. With
+        // minGrain 0 the grain is picked so every worker gets a few ranges to balance uneven work; otherwise
+        // ranges have at least minGrain items. Returns when every range is done.
+        template<typename F>
+        void parallelFor(std::size_t count, F&& body, std::size_t minGrain = 0);
+
+        // Runs one queued job on the calling thread; false when there was none. Used by TaskGroup::wait.
+        bool tryRunOne();
+
+        [[nodiscard]] std::size_t getWorkerCount() const noexcept { return workers_.size(); }
+        // Index of the calling worker thread, or -1 for threads this system does not own
+        [[nodiscard]] int getCurrentWorkerIndex() const noexcept;
+
+        // Snapshot per worker; counters accumulate from construction or the last resetStatistics
+        [[nodiscard]] std::vector<WorkerStatistics> getWorkerStatistics() const;
+        void resetStatistics();
+
+    private:
+        friend class TaskGroup;
+
+        struct Job {
+            std::function<void()> function;
+            TaskGroup* group;
+        };
+
+        // Padded so the deques of neighbouring workers do not share cache lines
+        struct alignas(64) Worker {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+            std::atomic<uint64_t> jobsExecuted{0};
+            std::atomic<uint64_t> jobsStolen{0};
+            std::atomic<uint64_t> busyNanoseconds{0};
+            std::atomic<uint64_t> idleNanoseconds{0};
+        };
+
+        void push(Job job);
+        [[nodiscard]] bool pop(std::size_t workerIndex, Job& job);
+        [[nodiscard]] bool steal(std::size_t thiefIndex, Job& job);
+        void execute(Job& job);
+        void workerLoop(std::size_t workerIndex);
+
+        std::vector<std::unique_ptr<Worker>> workers_;
+        std::vector<std::thread> threads_;
+        std::atomic<uint64_t> queuedJobs_{0};
+        std::atomic<uint32_t> sleepingWorkers_{0};
+        std::atomic<std::size_t> nextExternalWorker_{0};
+        std::mutex sleepMutex_;
+        std::condition_variable sleepCondition_;
+        std::atomic<bool> stopping_{false};
+    };
+
+    template<typename F>
+    void TaskGroup::run(F&& job) {
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        jobSystem_.push({std::function<void()>(std::forward<F>(job)), this});
+    }
+
+    template<typename F>
+    void TaskGroup::then(F&& continuation, TaskGroup* next) {
+        if (next) {
+            // Counted before it can possibly run, so next cannot look done in between
+            next->pending_.fetch_add(1, std::memory_order_relaxed);
+        }
+        std::function<void()> function(std::forward<F>(continuation));
+        {
+            std::lock_guard lock(continuationMutex_);
+            if (pending_.load(std::memory_order_acquire) != 0) {
+                continuation_ = std::move(function);
+                continuationGroup_ = next;
+                return;
+            }
+        }
+        jobSystem_.push({std::move(function), next});
+    }
+
+    template<typename F>
+    void JobSystem::parallelFor(std::size_t count, F&& body, std::size_t minGrain) {
+        if (count == 0) {
+            return;
+        }
+
+        // A few ranges per thread absorbs uneven ranges; more would only add spawn overhead
+        constexpr std::size_t kRangesPerThread = 4;
+        const std::size_t threadCount = workers_.size() + 1;
+        std::size_t rangeCount = std::min(count, threadCount * kRangesPerThread);
+        if (minGrain > 0) {
+            rangeCount = std::min(rangeCount, std::max<std::size_t>(count / minGrain, 1));
+        }
+        if (rangeCount <= 1) {
+            body(std::size_t{0}, count);
+            return;
+        }
+
+        const std::size_t rangeSize = (count + rangeCount - 1) / rangeCount;
+        TaskGroup group(*this);
+        for (std::size_t begin = rangeSize; begin < count; begin += rangeSize) {
+            group.run([&body, begin, end = std::min(begin + rangeSize, count)] { body(begin, end); });
+        }
+        body(std::size_t{0}, std::min(rangeSize, count));
+        group.wait();
+    }
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_JOB_SYSTEM_H
@@ -0,0 +1,35 @@
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace s3Dive {
+
+    MappedFile::MappedFile(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+
+        struct stat fileInfo{};
+        if (::fstat(fd, &fileInfo) == 0 && fileInfo.st_size > 0) {
+            void* mapping = ::mmap(nullptr, static_cast<std::size_t>(fileInfo.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                data_ = static_cast<const std::byte*>(mapping);
+                size_ = static_cast<std::size_t>(fileInfo.st_size);
+            }
+        }
+
+        // The mapping keeps the file referenced on its own
+        ::close(fd);
+    }
+
+    MappedFile::~MappedFile() {
+        if (data_) {
+            ::munmap(const_cast<std::byte*>(data_), size_);
+        }
+    }
+
+} // namespace s3Dive
@@ -0,0 +1,31 @@
+#ifndef THREEDIVE_MAPPED_FILE_H
+#define THREEDIVE_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+namespace s3Dive {
+
+    // Read-only memory mapping of a whole file; the mapping lives as long as the object.
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+        MappedFile(MappedFile&&) = delete;
+        MappedFile& operator=(MappedFile&&) = delete;
+
+        [[nodiscard]] bool isOpen() const noexcept { return data_ != nullptr; }
+        [[nodiscard]] const std::byte* data() const noexcept { return data_; }
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    private:
+        const std::byte* data_ = nullptr;
+        std::size_t size_ = 0;
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_MAPPED_FILE_H
@@ -0,0 +1,21 @@
+#ifndef THREEDIVE_PARALLEL_FOR_H
+#define THREEDIVE_PARALLEL_FOR_H
+
+#include <cstddef>
+#include <utility>
+#include "job_system.h"
+
+namespace s3Dive {
+
+    // Splits [0, count) into contiguous ranges of at least minGrain items, or of a size picked to balance the
+    // workers when minGrain is 0, and calls body(begin, end) for each on the engine-wide JobSystem. The calling
+    // thread processes ranges too while it waits, so this is safe to call from jobs, thread-pool tasks and
+    // systems alike.
+    template<typename F>
+    void parallelFor(std::size_t count, std::size_t minGrain, F&& body) {
+        JobSystem::instance().parallelFor(count, std::forward<F>(body), minGrain);
+    }
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_PARALLEL_FOR_H
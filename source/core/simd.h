@@ -0,0 +1,160 @@
+#ifndef THREEDIVE_SIMD_H
+#define THREEDIVE_SIMD_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define THREEDIVE_SIMD_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define THREEDIVE_SIMD_SSE2 1
+#elif defined(__aarch64__) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define THREEDIVE_SIMD_NEON 1
+#endif
+
+// Thin wrappers over the widest float vector the target was compiled for: 8 lanes with AVX, 4 with SSE2 or
+// NEON, and a 4-lane scalar emulation elsewhere. Kernels written against FloatV/MaskV and kWidth work unchanged
+// on every target; inputs are expected in SoA arrays padded to a multiple of kWidth.
+namespace s3Dive::simd {
+
+#if defined(THREEDIVE_SIMD_AVX)
+
+    inline constexpr std::size_t kWidth = 8;
+
+    struct FloatV { __m256 v; };
+    struct MaskV { __m256 v; };
+
+    inline FloatV load(const float* p) noexcept { return {_mm256_loadu_ps(p)}; }
+    inline void store(float* p, FloatV a) noexcept { _mm256_storeu_ps(p, a.v); }
+    inline FloatV set1(float value) noexcept { return {_mm256_set1_ps(value)}; }
+    inline FloatV operator+(FloatV a, FloatV b) noexcept { return {_mm256_add_ps(a.v, b.v)}; }
+    inline FloatV operator-(FloatV a, FloatV b) noexcept { return {_mm256_sub_ps(a.v, b.v)}; }
+    inline FloatV operator*(FloatV a, FloatV b) noexcept { return {_mm256_mul_ps(a.v, b.v)}; }
+    inline FloatV min(FloatV a, FloatV b) noexcept { return {_mm256_min_ps(a.v, b.v)}; }
+    inline FloatV max(FloatV a, FloatV b) noexcept { return {_mm256_max_ps(a.v, b.v)}; }
+    inline FloatV abs(FloatV a) noexcept { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+    inline MaskV operator>=(FloatV a, FloatV b) noexcept { return {_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)}; }
+    inline MaskV operator<(FloatV a, FloatV b) noexcept { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+    inline MaskV operator&(MaskV a, MaskV b) noexcept { return {_mm256_and_ps(a.v, b.v)}; }
+    inline MaskV operator|(MaskV a, MaskV b) noexcept { return {_mm256_or_ps(a.v, b.v)}; }
+    inline MaskV allTrue() noexcept { return {_mm256_castsi256_ps(_mm256_set1_epi32(-1))}; }
+    // Bit i set when lane i is true
+    inline uint32_t bits(MaskV m) noexcept { return static_cast<uint32_t>(_mm256_movemask_ps(m.v)); }
+    // Lanes of a where m is true, of b elsewhere
+    inline FloatV select(MaskV m, FloatV a, FloatV b) noexcept { return {_mm256_blendv_ps(b.v, a.v, m.v)}; }
+
+#elif defined(THREEDIVE_SIMD_SSE2)
+
+    inline constexpr std::size_t kWidth = 4;
+
+    struct FloatV { __m128 v; };
+    struct MaskV { __m128 v; };
+
+    inline FloatV load(const float* p) noexcept { return {_mm_loadu_ps(p)}; }
+    inline void store(float* p, FloatV a) noexcept { _mm_storeu_ps(p, a.v); }
+    inline FloatV set1(float value) noexcept { return {_mm_set1_ps(value)}; }
+    inline FloatV operator+(FloatV a, FloatV b) noexcept { return {_mm_add_ps(a.v, b.v)}; }
+    inline FloatV operator-(FloatV a, FloatV b) noexcept { return {_mm_sub_ps(a.v, b.v)}; }
+    inline FloatV operator*(FloatV a, FloatV b) noexcept { return {_mm_mul_ps(a.v, b.v)}; }
+    inline FloatV min(FloatV a, FloatV b) noexcept { return {_mm_min_ps(a.v, b.v)}; }
+    inline FloatV max(FloatV a, FloatV b) noexcept { return {_mm_max_ps(a.v, b.v)}; }
+    inline FloatV abs(FloatV a) noexcept { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+    inline MaskV operator>=(FloatV a, FloatV b) noexcept { return {_mm_cmpge_ps(a.v, b.v)}; }
+    inline MaskV operator<(FloatV a, FloatV b) noexcept { return {_mm_cmplt_ps(a.v, b.v)}; }
+    inline MaskV operator&(MaskV a, MaskV b) noexcept { return {_mm_and_ps(a.v, b.v)}; }
+    inline MaskV operator|(MaskV a, MaskV b) noexcept { return {_mm_or_ps(a.v, b.v)}; }
+    inline MaskV allTrue() noexcept { return {_mm_castsi128_ps(_mm_set1_epi32(-1))}; }
+    inline uint32_t bits(MaskV m) noexcept { return static_cast<uint32_t>(_mm_movemask_ps(m.v)); }
+    inline FloatV select(MaskV m, FloatV a, FloatV b) noexcept {
+        return {_mm_or_ps(_mm_and_ps(m.v, a.v), _mm_andnot_ps(m.v, b.v))};
+    }
+
+#elif defined(THREEDIVE_SIMD_NEON)
+
+    inline constexpr std::size_t kWidth = 4;
+
+    struct FloatV { float32x4_t v; };
+    struct MaskV { uint32x4_t v; };
+
+    inline FloatV load(const float* p) noexcept { return {vld1q_f32(p)}; }
+    inline void store(float* p, FloatV a) noexcept { vst1q_f32(p, a.v); }
+    inline FloatV set1(float value) noexcept { return {vdupq_n_f32(value)}; }
+    inline FloatV operator+(FloatV a, FloatV b) noexcept { return {vaddq_f32(a.v, b.v)}; }
+    inline FloatV operator-(FloatV a, FloatV b) noexcept { return {vsubq_f32(a.v, b.v)}; }
+    inline FloatV operator*(FloatV a, FloatV b) noexcept { return {vmulq_f32(a.v, b.v)}; }
+    inline FloatV min(FloatV a, FloatV b) noexcept { return {vminq_f32(a.v, b.v)}; }
+    inline FloatV max(FloatV a, FloatV b) noexcept { return {vmaxq_f32(a.v, b.v)}; }
+    inline FloatV abs(FloatV a) noexcept { return {vabsq_f32(a.v)}; }
+    inline MaskV operator>=(FloatV a, FloatV b) noexcept { return {vcgeq_f32(a.v, b.v)}; }
+    inline MaskV operator<(FloatV a, FloatV b) noexcept { return {vcltq_f32(a.v, b.v)}; }
+    inline MaskV operator&(MaskV a, MaskV b) noexcept { return {vandq_u32(a.v, b.v)}; }
+    inline MaskV operator|(MaskV a, MaskV b) noexcept { return {vorrq_u32(a.v, b.v)}; }
+    inline MaskV allTrue() noexcept { return {vdupq_n_u32(~0u)}; }
+    inline uint32_t bits(MaskV m) noexcept {
+        static const uint32_t kLaneBits[4] = {1, 2, 4, 8};
+        return vaddvq_u32(vandq_u32(m.v, vld1q_u32(kLaneBits)));
+    }
+    inline FloatV select(MaskV m, FloatV a, FloatV b) noexcept { return {vbslq_f32(m.v, a.v, b.v)}; }
+
+#else
+
+    inline constexpr std::size_t kWidth = 4;
+
+    struct FloatV { float v[4]; };
+    struct MaskV { bool v[4]; };
+
+    template<typename Op>
+    inline FloatV map(FloatV a, FloatV b, Op op) noexcept {
+        return {{op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3])}};
+    }
+    template<typename Op>
+    inline MaskV compare(FloatV a, FloatV b, Op op) noexcept {
+        return {{op(a.v[0], b.v[0]), op(a.v[1], b.v[1]), op(a.v[2], b.v[2]), op(a.v[3], b.v[3])}};
+    }
+
+    inline FloatV load(const float* p) noexcept { return {{p[0], p[1], p[2], p[3]}}; }
+    inline void store(float* p, FloatV a) noexcept { for (int i = 0; i < 4; ++i) p[i] = a.v[i]; }
+    inline FloatV set1(float value) noexcept { return {{value, value, value, value}}; }
+    inline FloatV operator+(FloatV a, FloatV b) noexcept { return map(a, b, [](float x, float y) { return x + y; }); }
+    inline FloatV operator-(FloatV a, FloatV b) noexcept { return map(a, b, [](float x, float y) { return x - y; }); }
+    inline FloatV operator*(FloatV a, FloatV b) noexcept { return map(a, b, [](float x, float y) { return x * y; }); }
+    inline FloatV min(FloatV a, FloatV b) noexcept { return map(a, b, [](float x, float y) { return y < x ? y : x; }); }
+    inline FloatV max(FloatV a, FloatV b) noexcept { return map(a, b, [](float x, float y) { return x < y ? y : x; }); }
+    inline FloatV abs(FloatV a) noexcept { return map(a, a, [](float x, float) { return std::fabs(x); }); }
+    inline MaskV operator>=(FloatV a, FloatV b) noexcept { return compare(a, b, [](float x, float y) { return x >= y; }); }
+    inline MaskV operator<(FloatV a, FloatV b) noexcept { return compare(a, b, [](float x, float y) { return x < y; }); }
+    inline MaskV operator&(MaskV a, MaskV b) noexcept {
+        return {{a.v[0] && b.v[0], a.v[1] && b.v[1], a.v[2] && b.v[2], a.v[3] && b.v[3]}};
+    }
+    inline MaskV operator|(MaskV a, MaskV b) noexcept {
+        return {{a.v[0] || b.v[0], a.v[1] || b.v[1], a.v[2] || b.v[2], a.v[3] || b.v[3]}};
+    }
+    inline MaskV allTrue() noexcept { return {{true, true, true, true}}; }
+    inline uint32_t bits(MaskV m) noexcept {
+        return uint32_t{m.v[0]} | uint32_t{m.v[1]} << 1 | uint32_t{m.v[2]} << 2 | uint32_t{m.v[3]} << 3;
+    }
+    inline FloatV select(MaskV m, FloatV a, FloatV b) noexcept {
+        return {{m.v[0] ? a.v[0] : b.v[0], m.v[1] ? a.v[1] : b.v[1], m.v[2] ? a.v[2] : b.v[2], m.v[3] ? a.v[3] : b.v[3]}};
+    }
+
+#endif
+
+    inline FloatV operator-(FloatV a) noexcept { return set1(0.0f) - a; }
+
+    // 0, 1, 2, ... kWidth - 1
+    inline FloatV laneIndex() noexcept {
+        static const float kLanes[8] = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f};
+        return load(kLanes);
+    }
+
+    [[nodiscard]] constexpr std::size_t paddedCount(std::size_t count) noexcept {
+        return (count + kWidth - 1) / kWidth * kWidth;
+    }
+
+} // namespace s3Dive::simd
+
+#endif //THREEDIVE_SIMD_H
@@ -0,0 +1,164 @@
+#ifndef THREEDIVE_TEXT_PARSING_H
+#define THREEDIVE_TEXT_PARSING_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+// Allocation-free, locale-independent parsing helpers for large ASCII mesh files.
+// Every function takes a [first, last) range and never reads past last.
+namespace s3Dive::text {
+
+    [[nodiscard]] inline const char* skipSpaces(const char* first, const char* last) noexcept {
+        while (first != last && (*first == ' ' || *first == '\t' || *first == '\r')) {
+            ++first;
+        }
+        return first;
+    }
+
+    // Returns the first character of the next line, or last
+    [[nodiscard]] inline const char* nextLine(const char* first, const char* last) noexcept {
+        const void* newline = std::memchr(first, '\n', static_cast<std::size_t>(last - first));
+        return newline ? static_cast<const char*>(newline) + 1 : last;
+    }
+
+    [[nodiscard]] inline bool startsWith(const char* first, const char* last, std::string_view prefix) noexcept {
+        return static_cast<std::size_t>(last - first) >= prefix.size() &&
+               std::memcmp(first, prefix.data(), prefix.size()) == 0;
+    }
+
+    // True when the keyword at first is followed by a space or tab, e.g. "v " but not "vt"
+    [[nodiscard]] inline bool isKeyword(const char* first, const char* last, std::string_view keyword) noexcept {
+        return startsWith(first, last, keyword) &&
+               first + keyword.size() != last &&
+               (first[keyword.size()] == ' ' || first[keyword.size()] == '\t');
+    }
+
+    // Parses [+-]digits[.digits][(e|E)[+-]digits] after optional spaces. Returns the position after the
+    // number, or nullptr if there is none. Accurate to float precision, which is all mesh data needs.
+    [[nodiscard]] inline const char* parseFloat(const char* first, const char* last, float& value) noexcept {
+        static constexpr std::array<double, 23> kPowersOfTen = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+        first = skipSpaces(first, last);
+        const char* cursor = first;
+
+        bool negative = false;
+        if (cursor != last && (*cursor == '-' || *cursor == '+')) {
+            negative = *cursor == '-';
+            ++cursor;
+        }
+
+        uint64_t mantissa = 0;
+        int exponent = 0;
+        int significantDigits = 0;
+        bool hasDigits = false;
+
+        for (; cursor != last && *cursor >= '0' && *cursor <= '9'; ++cursor) {
+            hasDigits = true;
+            if (significantDigits < 19) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(*cursor - '0');
+                significantDigits += mantissa != 0;
+            } else {
+                ++exponent;
+            }
+        }
+
+        if (cursor != last && *cursor == '.') {
+            ++cursor;
+            for (; cursor != last && *cursor >= '0' && *cursor <= '9'; ++cursor) {
+                hasDigits = true;
+                if (significantDigits < 19) {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*cursor - '0');
+                    significantDigits += mantissa != 0;
+                    --exponent;
+                }
+            }
+        }
+
+        if (!hasDigits) {
+            return nullptr;
+        }
+
+        if (cursor != last && (*cursor == 'e' || *cursor == 'E')) {
+            const char* exponentStart = cursor + 1;
+            bool negativeExponent = false;
+            if (exponentStart != last && (*exponentStart == '-' || *exponentStart == '+')) {
+                negativeExponent = *exponentStart == '-';
+                ++exponentStart;
+            }
+            int explicitExponent = 0;
+            const char* exponentCursor = exponentStart;
+            for (; exponentCursor != last && *exponentCursor >= '0' && *exponentCursor <= '9'; ++exponentCursor) {
+                if (explicitExponent < 10000) {
+                    explicitExponent = explicitExponent * 10 + (*exponentCursor - '0');
+                }
+            }
+            if (exponentCursor != exponentStart) {
+                exponent += negativeExponent ? -explicitExponent : explicitExponent;
+                cursor = exponentCursor;
+            }
+        }
+
+        double result = static_cast<double>(mantissa);
+        if (exponent != 0 && mantissa != 0) {
+            const int magnitude = exponent < 0 ? -exponent : exponent;
+            const double scale = magnitude < static_cast<int>(kPowersOfTen.size())
+                                 ? kPowersOfTen[static_cast<std::size_t>(magnitude)]
+                                 : std::pow(10.0, magnitude);
+            result = exponent < 0 ? result / scale : result * scale;
+        }
+
+        value = static_cast<float>(negative ? -result : result);
+        return cursor;
+    }
+
+    [[nodiscard]] inline const char* parseInt(const char* first, const char* last, int64_t& value) noexcept {
+        first = skipSpaces(first, last);
+        const char* cursor = first;
+
+        bool negative = false;
+        if (cursor != last && (*cursor == '-' || *cursor == '+')) {
+            negative = *cursor == '-';
+            ++cursor;
+        }
+
+        const char* digits = cursor;
+        int64_t result = 0;
+        for (; cursor != last && *cursor >= '0' && *cursor <= '9'; ++cursor) {
+            result = result * 10 + (*cursor - '0');
+        }
+        if (cursor == digits) {
+            return nullptr;
+        }
+
+        value = negative ? -result : result;
+        return cursor;
+    }
+
+    // Splits [first, last) into at most chunkCount pieces that start and end on line boundaries.
+    // The result holds chunk boundaries: chunk i is [result[i], result[i + 1]).
+    [[nodiscard]] inline std::vector<const char*> splitLines(const char* first, const char* last, std::size_t chunkCount) {
+        std::vector<const char*> boundaries{first};
+        const auto totalSize = static_cast<std::size_t>(last - first);
+        const std::size_t chunkSize = chunkCount > 0 ? totalSize / chunkCount + 1 : totalSize;
+
+        const char* cursor = first;
+        while (cursor != last) {
+            const char* target = static_cast<std::size_t>(last - cursor) > chunkSize ? cursor + chunkSize : last;
+            cursor = target == last ? last : nextLine(target, last);
+            boundaries.push_back(cursor);
+        }
+        if (boundaries.size() == 1) {
+            boundaries.push_back(last);
+        }
+        return boundaries;
+    }
+
+} // namespace s3Dive::text
+
+#endif //THREEDIVE_TEXT_PARSING_H
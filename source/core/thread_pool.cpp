@@ -0,0 +1,49 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace s3Dive {
+
+    ThreadPool::ThreadPool(std::size_t threadCount) {
+        threadCount = std::max<std::size_t>(threadCount, 1);
+        workers_.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            workers_.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+            std::queue<std::function<void()>>().swap(tasks_);
+        }
+        condition_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    std::size_t ThreadPool::defaultThreadCount() noexcept {
+        // Leave one core to the render thread
+        const auto hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    void ThreadPool::workerLoop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(mutex_);
+                condition_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+                if (stopping_) {
+                    return;
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+        }
+    }
+
+} // namespace s3Dive
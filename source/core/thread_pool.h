@@ -0,0 +1,57 @@
+#ifndef THREEDIVE_THREAD_POOL_H
+#define THREEDIVE_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace s3Dive {
+
+    // Fixed-size pool of worker threads consuming a FIFO task queue.
+    // Tasks still queued when the pool is destroyed are discarded; their futures report broken_promise.
+    class ThreadPool {
+    public:
+        explicit ThreadPool(std::size_t threadCount = defaultThreadCount());
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+
+        template<typename F, typename Ret = std::invoke_result_t<std::decay_t<F>>>
+        std::future<Ret> submit(F&& task) {
+            auto packagedTask = std::make_shared<std::packaged_task<Ret()>>(std::forward<F>(task));
+            std::future<Ret> future = packagedTask->get_future();
+            {
+                std::lock_guard lock(mutex_);
+                tasks_.emplace([packagedTask] { (*packagedTask)(); });
+            }
+            condition_.notify_one();
+            return future;
+        }
+
+        [[nodiscard]] std::size_t getThreadCount() const noexcept { return workers_.size(); }
+
+        [[nodiscard]] static std::size_t defaultThreadCount() noexcept;
+
+    private:
+        void workerLoop();
+
+        std::vector<std::thread> workers_;
+        std::queue<std::function<void()>> tasks_;
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        bool stopping_ = false;
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_THREAD_POOL_H
@@ -1,20 +1,49 @@
 #include "uuid.h"
+#include <atomic>
 #include <random>
 #include <sstream>
 #include <iomanip>
+#include "hash.h"
 
 namespace s3Dive {
 
+    namespace {
+
+        // Each thread owns a range of 2^40 counter values; the thread index takes the remaining bits
+        constexpr int kCounterBits = 40;
+
+        // Drawn once per process so UUIDs differ from run to run and from those saved by earlier sessions
+        uint64_t sessionKey() {
+            static const uint64_t key = [] {
+                std::random_device rd;
+                return (static_cast<uint64_t>(rd()) << 32) ^ rd();
+            }();
+            return key;
+        }
+
+        std::atomic<uint64_t> nextThreadIndex{0};
+
+        struct UUIDStream {
+            uint64_t base = nextThreadIndex.fetch_add(1, std::memory_order_relaxed) << kCounterBits;
+            uint64_t counter = 0;
+        };
+
+    } // namespace
+
     UUID::UUID() : UUID_(generateUUID()) {}
 
     UUID::UUID(uint64_t value) noexcept : UUID_(value) {}
 
     uint64_t UUID::generateUUID() {
-        static std::random_device rd;
-        static std::mt19937_64 gen(rd());
-        static std::uniform_int_distribution<uint64_t> dis;
-
-        return dis(gen);
+        // Thread index and counter make every input unique within the process, and mixing is a bijection, so
+        // the results are unique too while still looking random; no locks or shared state after the first call
+        thread_local UUIDStream stream;
+        const uint64_t key = sessionKey();
+        uint64_t value;
+        do {
+            value = hash::mix64((stream.base | stream.counter++) ^ key);
+        } while (value == 0); // Zero is left free to stand for "no UUID"
+        return value;
     }
 
     std::string UUID::toString() const {
@@ -9,6 +9,7 @@ namespace s3Dive {
 
     class UUID {
     public:
+        // Unique within the process and random across runs; lock-free and safe to call from any thread
         UUID();
         explicit UUID(uint64_t value) noexcept;
 
@@ -1,6 +1,7 @@
 #include <spdlog/spdlog.h>
 
 #include "../logging/debug_info.h"
+#include "../platform/openGLRender/gl_state_cache.h"
 #include "window.h"
 
 
@@ -94,7 +95,7 @@ namespace s3Dive {
         glfwSetFramebufferSizeCallback(window_, [](GLFWwindow *window, int width, int height) {
             auto *win = static_cast<Window *>(glfwGetWindowUserPointer(window));
             win->eventQueue_.enqueueEvent(WindowResizeEvent{width, height});
-            glViewport(0, 0, width, height);
+            GLStateCache::instance().setViewport(0, 0, width, height);
         });
 
         glfwSetKeyCallback(window_, [](GLFWwindow *window, int key, [[maybe_unused]] int scancode, int action, [[maybe_unused]] int mods) {
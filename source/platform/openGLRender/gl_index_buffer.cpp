@@ -5,30 +5,58 @@
 #include <glad/glad.h>
 
 #include "gl_index_buffer.h"
+#include "gl_state_cache.h"
 
 namespace s3Dive {
-    GLIndexBuffer::GLIndexBuffer(const std::vector<unsigned int> &data) : count_(static_cast<GLuint>(data.size())) {
+    GLIndexBuffer::GLIndexBuffer(const std::vector<unsigned int> &data)
+            : GLIndexBuffer(data.data(), static_cast<GLuint>(data.size())) {}
+
+    GLIndexBuffer::GLIndexBuffer(const unsigned int *data, GLuint count) : count_(count), type_(GL_UNSIGNED_INT) {
+        createBuffer(data, static_cast<GLsizeiptr>(count * sizeof(unsigned int)));
+    }
+
+    GLIndexBuffer::GLIndexBuffer(const uint16_t *data, GLuint count) : count_(count), type_(GL_UNSIGNED_SHORT) {
+        createBuffer(data, static_cast<GLsizeiptr>(count * sizeof(uint16_t)));
+    }
+
+    GLIndexBuffer::GLIndexBuffer(GLenum type, GLuint capacity) : count_(capacity), type_(type) {
+        createBuffer(nullptr, static_cast<GLsizeiptr>(capacity * getIndexSize()));
+    }
+
+    void GLIndexBuffer::createBuffer(const void *data, GLsizeiptr size) {
         glGenBuffers(1, &rendererID_);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererID_);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                     static_cast<GLuint>(data.size() * sizeof(unsigned int)),
-                     data.data(),
-                     GL_STATIC_DRAW);
+        GLStateCache::instance().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererID_);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
     }
 
     GLIndexBuffer::~GLIndexBuffer() {
+        GLStateCache::instance().onBufferDeleted(rendererID_);
         glDeleteBuffers(1, &rendererID_);
     }
 
     void GLIndexBuffer::bind() const {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererID_);
+        GLStateCache::instance().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererID_);
     }
 
     void GLIndexBuffer::unbind() const {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+        GLStateCache::instance().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
+    void GLIndexBuffer::setSubData(GLuint firstIndex, const void *data, GLuint count) {
+        GLStateCache::instance().bindBuffer(GL_ELEMENT_ARRAY_BUFFER, rendererID_);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLintptr>(firstIndex * getIndexSize()),
+                        static_cast<GLsizeiptr>(count * getIndexSize()), data);
     }
 
     GLuint GLIndexBuffer::getCount() const {
         return count_;
     }
+
+    GLenum GLIndexBuffer::getType() const {
+        return type_;
+    }
+
+    GLuint GLIndexBuffer::getIndexSize() const {
+        return type_ == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(unsigned int);
+    }
 } // s3Dive
\ No newline at end of file
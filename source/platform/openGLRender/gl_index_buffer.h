@@ -5,6 +5,8 @@
 #ifndef THREEDIVE_GL_INDEX_BUFFER_H
 #define THREEDIVE_GL_INDEX_BUFFER_H
 
+#include <glad/glad.h>
+#include <cstdint>
 #include <vector>
 
 namespace s3Dive {
@@ -12,16 +14,30 @@ namespace s3Dive {
     class GLIndexBuffer {
     public:
         explicit GLIndexBuffer(const std::vector<unsigned int> &data);
+        GLIndexBuffer(const unsigned int *data, GLuint count);
+        GLIndexBuffer(const uint16_t *data, GLuint count);
+        // Uninitialized storage for capacity indices of type, filled with setSubData
+        GLIndexBuffer(GLenum type, GLuint capacity);
         ~GLIndexBuffer();
 
         void bind() const;
         void unbind() const;
 
+        // Overwrites count indices starting at firstIndex; binds GL_ELEMENT_ARRAY_BUFFER, which is vertex array state
+        void setSubData(GLuint firstIndex, const void *data, GLuint count);
+
         [[nodiscard]] GLuint getCount() const;
+        // GL_UNSIGNED_INT or GL_UNSIGNED_SHORT, as passed to glDrawElements
+        [[nodiscard]] GLenum getType() const;
+
+        [[nodiscard]] GLuint getIndexSize() const;
 
     private:
+        void createBuffer(const void *data, GLsizeiptr size);
+
         GLuint rendererID_{};
         GLuint count_;
+        GLenum type_;
 
     };
 
@@ -0,0 +1,30 @@
+#include "gl_indirect_buffer.h"
+#include "gl_state_cache.h"
+
+namespace s3Dive {
+
+    GLIndirectBuffer::GLIndirectBuffer() {
+        glGenBuffers(1, &rendererID_);
+    }
+
+    GLIndirectBuffer::~GLIndirectBuffer() {
+        GLStateCache::instance().onBufferDeleted(rendererID_);
+        glDeleteBuffers(1, &rendererID_);
+    }
+
+    void GLIndirectBuffer::bind() const {
+        GLStateCache::instance().bindBuffer(GL_DRAW_INDIRECT_BUFFER, rendererID_);
+    }
+
+    void GLIndirectBuffer::unbind() const {
+        GLStateCache::instance().bindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    }
+
+    void GLIndirectBuffer::setData(const std::vector<DrawElementsIndirectCommand> &commands) {
+        GLStateCache::instance().bindBuffer(GL_DRAW_INDIRECT_BUFFER, rendererID_);
+        glBufferData(GL_DRAW_INDIRECT_BUFFER,
+                     static_cast<GLsizeiptr>(commands.size() * sizeof(DrawElementsIndirectCommand)),
+                     commands.data(), GL_STREAM_DRAW);
+    }
+
+} // namespace s3Dive
@@ -0,0 +1,39 @@
+#ifndef THREEDIVE_GL_INDIRECT_BUFFER_H
+#define THREEDIVE_GL_INDIRECT_BUFFER_H
+
+#include <glad/glad.h>
+#include <vector>
+
+namespace s3Dive {
+
+    // Layout fixed by glMultiDrawElementsIndirect
+    struct DrawElementsIndirectCommand {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+
+    // GL_DRAW_INDIRECT_BUFFER holding per-frame draw commands
+    class GLIndirectBuffer {
+    public:
+        GLIndirectBuffer();
+        ~GLIndirectBuffer();
+
+        GLIndirectBuffer(const GLIndirectBuffer&) = delete;
+        GLIndirectBuffer& operator=(const GLIndirectBuffer&) = delete;
+
+        void bind() const;
+        void unbind() const;
+
+        // Replaces the whole store; the old one is orphaned so draws still reading it do not stall
+        void setData(const std::vector<DrawElementsIndirectCommand> &commands);
+
+    private:
+        GLuint rendererID_{};
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_GL_INDIRECT_BUFFER_H
@@ -0,0 +1,166 @@
+#include "gl_program_binary_cache.h"
+
+#include <spdlog/spdlog.h>
+#include <fmt/format.h>
+#include <array>
+#include <fstream>
+#include <system_error>
+
+#include "../../core/hash.h"
+
+namespace s3Dive {
+
+    namespace {
+
+        constexpr std::array<char, 4> kMagic{'3', 'D', 'P', 'B'};
+
+        struct EntryHeader {
+            std::array<char, 4> magic = kMagic;
+            uint32_t version = GLProgramBinaryCache::kFormatVersion;
+            uint64_t key = 0;
+            uint32_t binaryFormat = 0;
+            uint32_t binarySize = 0;
+            int64_t buildMicros = 0;
+        };
+        static_assert(sizeof(EntryHeader) == 32, "EntryHeader is written to disk as-is");
+
+        std::string_view getString(GLenum name) {
+            const auto* value = reinterpret_cast<const char*>(glGetString(name));
+            return value ? std::string_view(value) : std::string_view();
+        }
+
+    } // namespace
+
+    GLProgramBinaryCache& GLProgramBinaryCache::instance() {
+        static GLProgramBinaryCache cache;
+        return cache;
+    }
+
+    bool GLProgramBinaryCache::isSupported() const {
+        if (!GLAD_GL_VERSION_4_1 && !GLAD_GL_ARB_get_program_binary) {
+            return false;
+        }
+        GLint formatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        return formatCount > 0;
+    }
+
+    uint64_t GLProgramBinaryCache::computeKey(const std::vector<std::pair<GLenum, std::string>>& stages) const {
+        uint64_t key = hash::kFnvOffsetBasis;
+        for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+            key = hash::fnv1a64(getString(name), key);
+            key = hash::fnv1a64("\n", key);
+        }
+        for (const auto& [type, source] : stages) {
+            key = hash::fnv1a64(&type, sizeof(type), key);
+            const uint64_t length = source.size();
+            key = hash::fnv1a64(&length, sizeof(length), key);
+            key = hash::fnv1a64(source, key);
+        }
+        return key;
+    }
+
+    std::filesystem::path GLProgramBinaryCache::getEntryPath(uint64_t key) const {
+        return directory_ / fmt::format("{:016x}.bin", key);
+    }
+
+    bool GLProgramBinaryCache::load(GLuint programId, uint64_t key) {
+        const auto path = getEntryPath(key);
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            ++statistics_.misses;
+            return false;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        EntryHeader header;
+        std::vector<char> binary;
+        bool valid = static_cast<bool>(file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+                     && header.magic == kMagic && header.version == kFormatVersion && header.key == key;
+        if (valid) {
+            binary.resize(header.binarySize);
+            valid = static_cast<bool>(file.read(binary.data(), static_cast<std::streamsize>(binary.size())));
+        }
+        file.close();
+
+        GLint linked = GL_FALSE;
+        if (valid) {
+            glProgramBinary(programId, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+            glGetProgramiv(programId, GL_LINK_STATUS, &linked);
+        }
+
+        if (linked == GL_FALSE) {
+            // Stale or corrupt entry: drop it so the rebuilt program replaces it
+            ++statistics_.rejected;
+            std::error_code error;
+            std::filesystem::remove(path, error);
+            spdlog::warn("Discarding program binary {}: rejected by the driver", path.string());
+            return false;
+        }
+
+        ++statistics_.hits;
+        const auto loadTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start);
+        const auto saved = std::chrono::microseconds(header.buildMicros) - loadTime;
+        if (saved.count() > 0) {
+            statistics_.timeSaved += saved;
+        }
+        return true;
+    }
+
+    void GLProgramBinaryCache::store(GLuint programId, uint64_t key, std::chrono::microseconds buildTime) {
+        GLint length = 0;
+        glGetProgramiv(programId, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0) {
+            return;
+        }
+
+        EntryHeader header;
+        header.key = key;
+        header.buildMicros = buildTime.count();
+        std::vector<char> binary(static_cast<std::size_t>(length));
+        GLenum format = 0;
+        GLsizei written = 0;
+        glGetProgramBinary(programId, length, &written, &format, binary.data());
+        if (written <= 0) {
+            return;
+        }
+        header.binaryFormat = format;
+        header.binarySize = static_cast<uint32_t>(written);
+
+        std::error_code error;
+        std::filesystem::create_directories(directory_, error);
+        if (error) {
+            spdlog::warn("Cannot create shader cache directory {}: {}", directory_.string(), error.message());
+            return;
+        }
+
+        // Write beside the final name and rename, so a crash never leaves a truncated entry behind
+        const auto path = getEntryPath(key);
+        auto tmpPath = path;
+        tmpPath += ".tmp";
+        {
+            std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(binary.data(), written);
+            if (!file) {
+                spdlog::warn("Failed to write program binary {}", tmpPath.string());
+                file.close();
+                std::filesystem::remove(tmpPath, error);
+                return;
+            }
+        }
+        std::filesystem::rename(tmpPath, path, error);
+        if (error) {
+            spdlog::warn("Failed to store program binary {}: {}", path.string(), error.message());
+            std::filesystem::remove(tmpPath, error);
+        }
+    }
+
+    void GLProgramBinaryCache::logStatistics() const {
+        spdlog::info("Program binary cache: {} hits, {} misses, {} rejected, {:.1f} ms saved",
+                     statistics_.hits, statistics_.misses, statistics_.rejected,
+                     static_cast<double>(statistics_.timeSaved.count()) / 1000.0);
+    }
+
+} // namespace s3Dive
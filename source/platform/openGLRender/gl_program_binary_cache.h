@@ -0,0 +1,59 @@
+#ifndef THREEDIVE_GL_PROGRAM_BINARY_CACHE_H
+#define THREEDIVE_GL_PROGRAM_BINARY_CACHE_H
+
+#include <glad/glad.h>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace s3Dive {
+
+    // On-disk cache of linked programs (glGetProgramBinary / glProgramBinary). Entries are keyed by the
+    // preprocessed stage sources, which include any defines, and by the driver's vendor, renderer and
+    // version strings, so a driver update misses instead of handing the driver a binary it will reject.
+    class GLProgramBinaryCache {
+    public:
+        struct Statistics {
+            uint32_t hits = 0;
+            uint32_t misses = 0;
+            uint32_t rejected = 0; // Found on disk but refused by the driver
+            std::chrono::microseconds timeSaved{0};
+        };
+
+        static constexpr uint32_t kFormatVersion = 1;
+
+        static GLProgramBinaryCache& instance();
+
+        GLProgramBinaryCache(const GLProgramBinaryCache&) = delete;
+        GLProgramBinaryCache& operator=(const GLProgramBinaryCache&) = delete;
+
+        // Requires a current context; false when the driver exposes no binary formats
+        [[nodiscard]] bool isSupported() const;
+
+        [[nodiscard]] uint64_t computeKey(const std::vector<std::pair<GLenum, std::string>>& stages) const;
+
+        // Returns true when programId now holds a linked program restored from the cache
+        bool load(GLuint programId, uint64_t key);
+        // buildTime is how long compiling and linking from source took; hits report it as time saved
+        void store(GLuint programId, uint64_t key, std::chrono::microseconds buildTime);
+
+        void setDirectory(std::filesystem::path directory) { directory_ = std::move(directory); }
+
+        [[nodiscard]] const Statistics& getStatistics() const noexcept { return statistics_; }
+        void logStatistics() const;
+
+    private:
+        GLProgramBinaryCache() = default;
+
+        [[nodiscard]] std::filesystem::path getEntryPath(uint64_t key) const;
+
+        std::filesystem::path directory_{"shader_cache"};
+        Statistics statistics_;
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_GL_PROGRAM_BINARY_CACHE_H
@@ -5,15 +5,18 @@
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "gl_state_cache.h"
 #include "gl_vertex_array.h"
 #include "gl_renderer.h"
 
 
 namespace s3Dive {
     void GLRenderer::init() const {
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-        glEnable(GL_LINE_SMOOTH);
+        auto& state = GLStateCache::instance();
+        state.setEnabled(GL_DEPTH_TEST, true);
+        state.setEnabled(GL_BLEND, true);
+        state.setBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        state.setEnabled(GL_LINE_SMOOTH, true);
         glHint(GL_LINE_SMOOTH_HINT, GL_NICEST);
     }
 
@@ -30,7 +33,7 @@ namespace s3Dive {
     }
 
     void GLRenderer::setViewport(int x, int y, int width, int height) const {
-        glViewport(x, y, width, height);
+        GLStateCache::instance().setViewport(x, y, width, height);
     }
 
     void GLRenderer::setClearColor(const glm::vec4 &color) const {
@@ -42,8 +45,27 @@ namespace s3Dive {
     }
 
     void GLRenderer::drawIndexed(const GLVertexArray &vao, GLuint indexCount) const {
-        auto count = indexCount ? indexCount : vao.getIndexBuffer()->getCount();
-        glDrawElements(GL_TRIANGLES, static_cast<GLint>(count), GL_UNSIGNED_INT, nullptr);
+        const auto& indexBuffer = vao.getIndexBuffer();
+        auto count = indexCount ? indexCount : indexBuffer->getCount();
+        glDrawElements(GL_TRIANGLES, static_cast<GLint>(count), indexBuffer->getType(), nullptr);
+    }
+
+    void GLRenderer::drawIndexedInstanced(const GLVertexArray &vao, GLsizei instanceCount) const {
+        const auto& indexBuffer = vao.getIndexBuffer();
+        glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(indexBuffer->getCount()), indexBuffer->getType(),
+                                nullptr, instanceCount);
+    }
+
+    void GLRenderer::drawIndexedInstancedBaseVertex(GLenum indexType, GLuint indexCount, GLuint firstIndex,
+                                                    GLsizei instanceCount, GLint baseVertex) const {
+        const auto indexSize = indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(GLuint);
+        glDrawElementsInstancedBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(indexCount), indexType,
+                                          (const void *) (uintptr_t) (firstIndex * indexSize),
+                                          instanceCount, baseVertex);
+    }
+
+    void GLRenderer::multiDrawIndexedIndirect(GLenum indexType, GLintptr offset, GLsizei drawCount) const {
+        glMultiDrawElementsIndirect(GL_TRIANGLES, indexType, (const void *) (uintptr_t) offset, drawCount, 0);
     }
 
     void GLRenderer::drawLines(GLint indexCount) const {
@@ -34,6 +34,11 @@ namespace s3Dive {
         void setLineWidth(float width) const;
 
         void drawIndexed(const GLVertexArray &vao, GLuint indexCount = 0) const;
+        void drawIndexedInstanced(const GLVertexArray &vao, GLsizei instanceCount) const;
+        void drawIndexedInstancedBaseVertex(GLenum indexType, GLuint indexCount, GLuint firstIndex,
+                                            GLsizei instanceCount, GLint baseVertex) const;
+        // Reads drawCount DrawElementsIndirectCommands from the bound GL_DRAW_INDIRECT_BUFFER, from offset bytes
+        void multiDrawIndexedIndirect(GLenum indexType, GLintptr offset, GLsizei drawCount) const;
         void drawLines(GLint indexCount) const;
 
     };
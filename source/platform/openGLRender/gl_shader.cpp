@@ -10,11 +10,14 @@
 
 namespace s3Dive {
 
-    GLShader::GLShader(GLenum type, std::string_view filepath) {
+    GLShader::GLShader(GLenum type, std::string_view filepath)
+            : GLShader(type, Source{loadShaderFile(filepath)}) {}
+
+    GLShader::GLShader(GLenum type, Source source) {
         shaderId_ = glCreateShader(type);
-        const std::string& source = loadShaderFile(filepath);
-        const char *src = source.c_str();
-        glShaderSource(shaderId_, 1, &src, nullptr);
+        const char *src = source.text.data();
+        const auto length = static_cast<GLint>(source.text.size());
+        glShaderSource(shaderId_, 1, &src, &length);
         glCompileShader(shaderId_);
         checkShaderError();
     }
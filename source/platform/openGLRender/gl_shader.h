@@ -14,7 +14,13 @@ namespace s3Dive {
 
     class GLShader {
     public:
+        // GLSL text that is already in memory, as opposed to a file path
+        struct Source {
+            std::string_view text;
+        };
+
         GLShader(GLenum type, std::string_view filepath);
+        GLShader(GLenum type, Source source);
         ~GLShader();
 
         [[nodiscard]] GLuint getShaderId() const;
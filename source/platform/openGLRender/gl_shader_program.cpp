@@ -2,8 +2,13 @@
 // Created by ABDERRAHIM ZEBIRI on 2024-06-24.
 //
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
 
 #include "gl_shader_program.h"
+#include "gl_program_binary_cache.h"
+#include "gl_state_cache.h"
 
 namespace s3Dive {
 
@@ -12,118 +17,206 @@ namespace s3Dive {
     }
 
     GLShaderProgram::~GLShaderProgram() {
+        GLStateCache::instance().onProgramDeleted(programId_);
         glDeleteProgram(programId_);
     }
 
-    void GLShaderProgram::initFromFiles(std::string_view vsPath, std::string_view fsPath) const {
-        auto vertexShader = GLShader(GL_VERTEX_SHADER, vsPath.data());
-        auto fragmentShader = GLShader(GL_FRAGMENT_SHADER, fsPath.data());
-
-        attachShader(vertexShader);
-        attachShader(fragmentShader);
+    void GLShaderProgram::initFromFiles(std::string_view vsPath, std::string_view fsPath) {
+        buildProgram({{GL_VERTEX_SHADER, vsPath}, {GL_FRAGMENT_SHADER, fsPath}});
+    }
 
-        link();
+    void
+    GLShaderProgram::initFromFiles(std::string_view vsPath, std::string_view gsPath, std::string_view fsPath) {
+        buildProgram({{GL_VERTEX_SHADER, vsPath}, {GL_GEOMETRY_SHADER, gsPath}, {GL_FRAGMENT_SHADER, fsPath}});
+    }
 
+    std::string GLShaderProgram::preprocess(std::string source) const {
+        if (defines_.empty()) {
+            return source;
+        }
+        std::string defines;
+        for (const auto& define : defines_) {
+            defines += "#define " + define + "\n";
+        }
+        // #version has to stay the first directive, so defines go on the line after it
+        std::size_t insertAt = 0;
+        if (auto version = source.find("#version"); version != std::string::npos) {
+            auto lineEnd = source.find('\n', version);
+            insertAt = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+            if (lineEnd == std::string::npos) {
+                defines.insert(0, "\n");
+            }
+        }
+        source.insert(insertAt, defines);
+        return source;
     }
 
-    void
-    GLShaderProgram::initFromFiles(std::string_view vsPath, std::string_view gsPath, std::string_view fsPath) const {
+    void GLShaderProgram::buildProgram(const std::vector<std::pair<GLenum, std::string_view>>& stagePaths) {
+        std::vector<std::pair<GLenum, std::string>> stages;
+        stages.reserve(stagePaths.size());
+        for (const auto& [type, path] : stagePaths) {
+            stages.emplace_back(type, preprocess(GLShader::loadShaderFile(path)));
+        }
+
+        auto& cache = GLProgramBinaryCache::instance();
+        const bool cacheSupported = cache.isSupported();
+        uint64_t key = 0;
+        if (cacheSupported) {
+            key = cache.computeKey(stages);
+            if (cache.load(programId_, key)) {
+                introspectUniforms();
+                return;
+            }
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        std::vector<std::unique_ptr<GLShader>> shaders;
+        shaders.reserve(stages.size());
+        for (const auto& [type, source] : stages) {
+            shaders.push_back(std::make_unique<GLShader>(type, GLShader::Source{source}));
+            attachShader(*shaders.back());
+        }
+        if (cacheSupported) {
+            glProgramParameteri(programId_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
 
-        auto vertexShader = GLShader(GL_VERTEX_SHADER, GLShader::loadShaderFile(vsPath.data()));
-        auto geometryShader = GLShader(GL_GEOMETRY_SHADER, GLShader::loadShaderFile(gsPath.data()));
-        auto fragmentShader = GLShader(GL_FRAGMENT_SHADER, GLShader::loadShaderFile(fsPath.data()));
+        const bool linked = link();
+        for (const auto& shader : shaders) {
+            glDetachShader(programId_, shader->getShaderId());
+        }
 
-        attachShader(vertexShader);
-        attachShader(geometryShader);
-        attachShader(fragmentShader);
+        if (!linked) {
+            return;
+        }
+        if (cacheSupported) {
+            cache.store(programId_, key, std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start));
+        }
+        introspectUniforms();
+    }
+
+    void GLShaderProgram::introspectUniforms() {
+        uniforms_.clear();
+        GLint count = 0;
+        GLint maxLength = 0;
+        glGetProgramiv(programId_, GL_ACTIVE_UNIFORMS, &count);
+        glGetProgramiv(programId_, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+        if (count <= 0 || maxLength <= 0) {
+            return;
+        }
 
-        link();
+        std::vector<char> buffer(maxLength);
+        uniforms_.reserve(count);
+        for (GLint i = 0; i < count; ++i) {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(programId_, static_cast<GLuint>(i), maxLength, &length, &size, &type, buffer.data());
+            // Members of uniform blocks have no location and are set through their buffers
+            const GLint location = glGetUniformLocation(programId_, buffer.data());
+            if (location == -1) {
+                continue;
+            }
+            std::string name(buffer.data(), length);
+            if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) {
+                name.resize(name.size() - 3);
+            }
+            const uint64_t hash = hash::fnv1a64(name);
+            uniforms_.push_back({hash, location, type, size, std::move(name)});
+        }
+        std::sort(uniforms_.begin(), uniforms_.end(),
+                  [](const ActiveUniform& a, const ActiveUniform& b) { return a.hash < b.hash; });
     }
 
     void GLShaderProgram::use() const {
-        glUseProgram(programId_);
+        GLStateCache::instance().useProgram(programId_);
     }
 
     void GLShaderProgram::unuse() const {
-        glUseProgram(0);
+        GLStateCache::instance().useProgram(0);
     }
 
-    void GLShaderProgram::link() const {
+    bool GLShaderProgram::link() const {
         glLinkProgram(programId_);
-        checkLinkingErr();
+        return checkLinkingErr();
     }
 
     void GLShaderProgram::attachShader(const GLShader &shader) const {
         glAttachShader(programId_, shader.getShaderId());
     }
 
+    bool GLShaderProgram::bindUniformBlock(std::string_view blockName, GLuint binding) const {
+        const GLuint index = glGetUniformBlockIndex(programId_, std::string(blockName).c_str());
+        if (index == GL_INVALID_INDEX) {
+            return false;
+        }
+        glUniformBlockBinding(programId_, index, binding);
+        return true;
+    }
+
     GLint GLShaderProgram::getAttribLocation(std::string_view name, bool verbose) {
-        if (auto it = attribLocationCache_.find(name.data()); it != attribLocationCache_.end()) {
+        std::string key(name);
+        if (auto it = attribLocationCache_.find(key); it != attribLocationCache_.end()) {
             return it->second;
         }
-        GLint location = glGetAttribLocation(programId_, std::string(name).c_str());
+        GLint location = glGetAttribLocation(programId_, key.c_str());
         if (location == -1 && verbose) {
             spdlog::error("Attribute {} not found in shader program", name);
         }
-        attribLocationCache_[std::string(name)] = location;
+        attribLocationCache_.emplace(std::move(key), location);
         return location;
     }
 
-    GLint GLShaderProgram::getUniformLocation(std::string_view name) {
-        if (auto it = uniformLocationCache_.find(name.data()); it != uniformLocationCache_.end()) {
-            return it->second;
+    UniformHandle GLShaderProgram::getUniformHandle(const UniformName& name, bool verbose) const {
+        auto it = std::lower_bound(uniforms_.begin(), uniforms_.end(), name.hash,
+                                   [](const ActiveUniform& uniform, uint64_t hash) { return uniform.hash < hash; });
+        for (; it != uniforms_.end() && it->hash == name.hash; ++it) {
+            if (it->name == name.name) {
+                return UniformHandle{static_cast<uint32_t>(it - uniforms_.begin())};
+            }
         }
-        GLint location = glGetUniformLocation(programId_, std::string(name).c_str());
-        if (location == -1) {
-            spdlog::error("Uniform {} not found in shader program", name);
+        if (verbose) {
+            spdlog::error("Uniform {} not found in shader program", name.name);
         }
-        uniformLocationCache_[std::string(name)] = location;
-        return location;
+        return {};
     }
 
     template<>
-    void GLShaderProgram::updateShaderUniform<int>(std::string_view name, int val) {
-        GLint location = getUniformLocation(name);
-        glUniform1i(location, val);
+    void GLShaderProgram::updateShaderUniform<int>(UniformHandle handle, int val) const {
+        glUniform1i(getUniformLocation(handle), val);
     }
 
     template<>
-    void GLShaderProgram::updateShaderUniform<bool>(std::string_view name, bool val) {
-        GLint location = getUniformLocation(name);
-        glUniform1i(location, val);
+    void GLShaderProgram::updateShaderUniform<bool>(UniformHandle handle, bool val) const {
+        glUniform1i(getUniformLocation(handle), val);
     }
 
     template<>
-    void GLShaderProgram::updateShaderUniform<float>(std::string_view name, float val) {
-        GLint location = getUniformLocation(name);
-        glUniform1f(location, val);
+    void GLShaderProgram::updateShaderUniform<float>(UniformHandle handle, float val) const {
+        glUniform1f(getUniformLocation(handle), val);
     }
 
     template<>
-    void GLShaderProgram::updateShaderUniform<float>(std::string_view name, float val1, float val2) {
-        GLint location = getUniformLocation(name);
-        glUniform2f(location, val1, val2);
+    void GLShaderProgram::updateShaderUniform<float>(UniformHandle handle, float val1, float val2) const {
+        glUniform2f(getUniformLocation(handle), val1, val2);
     }
 
     template<>
-    void GLShaderProgram::updateShaderUniform<float>(std::string_view name, float val1, float val2, float val3) {
-        GLint location = getUniformLocation(name);
-        glUniform3f(location, val1, val2, val3);
+    void GLShaderProgram::updateShaderUniform<float>(UniformHandle handle, float val1, float val2, float val3) const {
+        glUniform3f(getUniformLocation(handle), val1, val2, val3);
     }
 
     template<>
-    void GLShaderProgram::updateShaderUniform<glm::vec3>(std::string_view name, glm::vec3 val) {
-        GLint location = getUniformLocation(name);
-        glUniform3f(location, val.x, val.y, val.z);
+    void GLShaderProgram::updateShaderUniform<glm::vec3>(UniformHandle handle, glm::vec3 val) const {
+        glUniform3f(getUniformLocation(handle), val.x, val.y, val.z);
     }
 
     template<>
-    void GLShaderProgram::updateShaderUniform<float *>(std::string_view name, float *val) {
-        GLint location = getUniformLocation(name);
-        glUniformMatrix4fv(location, 1, GL_FALSE, val);
+    void GLShaderProgram::updateShaderUniform<float *>(UniformHandle handle, float *val) const {
+        glUniformMatrix4fv(getUniformLocation(handle), 1, GL_FALSE, val);
     }
 
-    void GLShaderProgram::checkLinkingErr() const {
+    bool GLShaderProgram::checkLinkingErr() const {
         GLint result;
         glGetProgramiv(programId_, GL_LINK_STATUS, &result);
 
@@ -134,8 +227,9 @@ namespace s3Dive {
             std::vector<char> message(length);
             glGetProgramInfoLog(programId_, length, &length, message.data());
             spdlog::error("Failed to link shader program: {}", message.data());
-            glDeleteProgram(programId_);
+            return false;
         }
+        return true;
     }
 
 } // s3Dive
\ No newline at end of file
@@ -6,43 +6,110 @@
 #define THREEDIVE_GL_SHADER_PROGRAM_H
 
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include <glm/gtc/type_ptr.hpp>
 
 #include "gl_shader.h"
+#include "../../core/hash.h"
 
 namespace s3Dive {
 
     class GLShader;
 
+    // A uniform name and its hash. Declared constexpr, the hash is computed at compile time:
+    //   static constexpr UniformName kExposure{"exposure"};
+    struct UniformName {
+        template<std::size_t N>
+        constexpr UniformName(const char (&literal)[N]) noexcept : UniformName(std::string_view{literal, N - 1}) {}
+        constexpr explicit UniformName(std::string_view name) noexcept : name(name), hash(hash::fnv1a64(name)) {}
+
+        std::string_view name;
+        uint64_t hash;
+    };
+
+    // Index into one program's uniform table, resolved once with GLShaderProgram::getUniformHandle.
+    // An invalid handle makes the update a no-op, like location -1 does in GL.
+    struct UniformHandle {
+        static constexpr uint32_t kInvalidIndex = ~0u;
+
+        [[nodiscard]] constexpr bool isValid() const noexcept { return index != kInvalidIndex; }
+
+        uint32_t index = kInvalidIndex;
+    };
+
     class GLShaderProgram {
 
     public:
         GLShaderProgram();
         ~GLShaderProgram();
 
-        void initFromFiles(std::string_view vsPath, std::string_view fsPath) const;
-        void initFromFiles(std::string_view vsPath, std::string_view gsPath, std::string_view fsPath) const;
+        // Each define is injected as "#define <define>" right after the #version line; set before initFromFiles
+        void setDefines(std::vector<std::string> defines) { defines_ = std::move(defines); }
+
+        // Restores the linked program from GLProgramBinaryCache when possible, otherwise compiles from source
+        void initFromFiles(std::string_view vsPath, std::string_view fsPath);
+        void initFromFiles(std::string_view vsPath, std::string_view gsPath, std::string_view fsPath);
 
         void use() const;
         void unuse() const;
 
+        [[nodiscard]] GLuint getProgramId() const { return programId_; }
+
+        // Assigns a uniform block to a binding point; returns false when the program has no such block
+        bool bindUniformBlock(std::string_view blockName, GLuint binding) const;
+
         [[nodiscard]] GLint getAttribLocation(std::string_view name, bool verbose = true);
-        [[nodiscard]] GLint getUniformLocation(std::string_view name);
 
-        template<typename T> void updateShaderUniform(std::string_view name, T val);
-        template<typename T> void updateShaderUniform(std::string_view name, T val1, T val2);
-        template<typename T>void updateShaderUniform(std::string_view name, T val1, T val2, T val3);
+        // Binary search over the uniforms found after linking; resolve once and keep the handle for per-draw updates
+        [[nodiscard]] UniformHandle getUniformHandle(const UniformName& name, bool verbose = true) const;
+        [[nodiscard]] GLint getUniformLocation(UniformHandle handle) const {
+            return handle.isValid() ? uniforms_[handle.index].location : -1;
+        }
+
+        template<typename T> void updateShaderUniform(UniformHandle handle, T val) const;
+        template<typename T> void updateShaderUniform(UniformHandle handle, T val1, T val2) const;
+        template<typename T> void updateShaderUniform(UniformHandle handle, T val1, T val2, T val3) const;
+
+        // Convenience for code outside the draw loop; missing uniforms are skipped without logging
+        template<typename T>
+        void updateShaderUniform(const UniformName& name, T val) const {
+            updateShaderUniform(getUniformHandle(name, false), val);
+        }
+        template<typename T>
+        void updateShaderUniform(const UniformName& name, T val1, T val2) const {
+            updateShaderUniform(getUniformHandle(name, false), val1, val2);
+        }
+        template<typename T>
+        void updateShaderUniform(const UniformName& name, T val1, T val2, T val3) const {
+            updateShaderUniform(getUniformHandle(name, false), val1, val2, val3);
+        }
 
     private:
-        void checkLinkingErr() const;
-        void link() const;
+        struct ActiveUniform {
+            uint64_t hash;
+            GLint location;
+            GLenum type;
+            GLint size;
+            std::string name; // Array uniforms are stored without their "[0]" suffix
+        };
+
+        [[nodiscard]] std::string preprocess(std::string source) const;
+        void buildProgram(const std::vector<std::pair<GLenum, std::string_view>>& stagePaths);
+        // Reads the linked program's default-block uniforms into uniforms_, sorted by name hash
+        void introspectUniforms();
+        [[nodiscard]] bool checkLinkingErr() const;
+        [[nodiscard]] bool link() const;
         void attachShader(const GLShader &shader) const;
 
         GLuint programId_;
-        std::unordered_map<std::string, GLint> uniformLocationCache_;
+        std::vector<std::string> defines_;
+        std::vector<ActiveUniform> uniforms_;
         std::unordered_map<std::string, GLint> attribLocationCache_;
     };
 
@@ -0,0 +1,219 @@
+#include "gl_state_cache.h"
+
+namespace s3Dive {
+
+    GLStateCache& GLStateCache::instance() {
+        static GLStateCache cache;
+        return cache;
+    }
+
+    int GLStateCache::bufferTargetIndex(GLenum target) noexcept {
+        switch (target) {
+            case GL_ARRAY_BUFFER: return ArrayBuffer;
+            case GL_ELEMENT_ARRAY_BUFFER: return ElementArrayBuffer;
+            case GL_UNIFORM_BUFFER: return UniformBuffer;
+            case GL_DRAW_INDIRECT_BUFFER: return DrawIndirectBuffer;
+            case GL_PIXEL_UNPACK_BUFFER: return PixelUnpackBuffer;
+            default: return -1;
+        }
+    }
+
+    int GLStateCache::capabilityIndex(GLenum capability) noexcept {
+        switch (capability) {
+            case GL_BLEND: return Blend;
+            case GL_DEPTH_TEST: return DepthTest;
+            case GL_CULL_FACE: return CullFace;
+            case GL_LINE_SMOOTH: return LineSmooth;
+            case GL_SCISSOR_TEST: return ScissorTest;
+            default: return -1;
+        }
+    }
+
+    bool GLStateCache::update(GLuint& shadow, GLuint value) noexcept {
+        if (shadow == value) {
+            ++statistics_.elided;
+            return false;
+        }
+        shadow = value;
+        ++statistics_.issued;
+        return true;
+    }
+
+    void GLStateCache::useProgram(GLuint program) {
+        if (update(program_, program)) {
+            glUseProgram(program);
+        }
+    }
+
+    void GLStateCache::bindVertexArray(GLuint vertexArray) {
+        if (update(vertexArray_, vertexArray)) {
+            glBindVertexArray(vertexArray);
+            buffers_[ElementArrayBuffer] = kUnknown;
+        }
+    }
+
+    void GLStateCache::bindBuffer(GLenum target, GLuint buffer) {
+        const int index = bufferTargetIndex(target);
+        if (index < 0) {
+            ++statistics_.issued;
+            glBindBuffer(target, buffer);
+            return;
+        }
+        if (update(buffers_[index], buffer)) {
+            glBindBuffer(target, buffer);
+        }
+    }
+
+    void GLStateCache::bindBufferBase(GLenum target, GLuint index, GLuint buffer) {
+        if (target != GL_UNIFORM_BUFFER || index >= kMaxUniformBufferBindings) {
+            ++statistics_.issued;
+            glBindBufferBase(target, index, buffer);
+            if (const int generic = bufferTargetIndex(target); generic >= 0) {
+                buffers_[generic] = buffer;
+            }
+            return;
+        }
+        if (update(uniformBuffers_[index], buffer)) {
+            glBindBufferBase(target, index, buffer);
+            // Binding an indexed target also replaces the generic binding of that target
+            buffers_[UniformBuffer] = buffer;
+        }
+    }
+
+    void GLStateCache::activeTexture(GLuint unit) {
+        if (update(activeUnit_, unit)) {
+            glActiveTexture(GL_TEXTURE0 + unit);
+        }
+    }
+
+    void GLStateCache::bindTexture(GLuint unit, GLuint texture) {
+        if (unit >= kMaxTextureUnits) {
+            activeTexture(unit);
+            ++statistics_.issued;
+            glBindTexture(GL_TEXTURE_2D, texture);
+            return;
+        }
+        if (textures_[unit] == texture) {
+            ++statistics_.elided;
+            return;
+        }
+        activeTexture(unit);
+        update(textures_[unit], texture);
+        glBindTexture(GL_TEXTURE_2D, texture);
+    }
+
+    void GLStateCache::bindTexture(GLuint texture) {
+        if (activeUnit_ == kUnknown) {
+            activeTexture(0);
+        }
+        bindTexture(activeUnit_, texture);
+    }
+
+    void GLStateCache::setEnabled(GLenum capability, bool enabled) {
+        const int index = capabilityIndex(capability);
+        const Toggle value = enabled ? Toggle::On : Toggle::Off;
+        if (index >= 0 && capabilities_[index] == value) {
+            ++statistics_.elided;
+            return;
+        }
+        if (index >= 0) {
+            capabilities_[index] = value;
+        }
+        ++statistics_.issued;
+        if (enabled) {
+            glEnable(capability);
+        } else {
+            glDisable(capability);
+        }
+    }
+
+    void GLStateCache::setBlendFunc(GLenum source, GLenum destination) {
+        if (blendSource_ == source && blendDestination_ == destination) {
+            ++statistics_.elided;
+            return;
+        }
+        blendSource_ = source;
+        blendDestination_ = destination;
+        ++statistics_.issued;
+        glBlendFunc(source, destination);
+    }
+
+    void GLStateCache::setDepthFunc(GLenum function) {
+        if (update(depthFunc_, function)) {
+            glDepthFunc(function);
+        }
+    }
+
+    void GLStateCache::setDepthMask(bool write) {
+        const Toggle value = write ? Toggle::On : Toggle::Off;
+        if (depthMask_ == value) {
+            ++statistics_.elided;
+            return;
+        }
+        depthMask_ = value;
+        ++statistics_.issued;
+        glDepthMask(write ? GL_TRUE : GL_FALSE);
+    }
+
+    void GLStateCache::setViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+        const std::array<GLint, 4> viewport{x, y, width, height};
+        if (viewportKnown_ && viewport_ == viewport) {
+            ++statistics_.elided;
+            return;
+        }
+        viewport_ = viewport;
+        viewportKnown_ = true;
+        ++statistics_.issued;
+        glViewport(x, y, width, height);
+    }
+
+    void GLStateCache::onProgramDeleted(GLuint program) {
+        if (program_ == program) {
+            program_ = kUnknown;
+        }
+    }
+
+    void GLStateCache::onVertexArrayDeleted(GLuint vertexArray) {
+        if (vertexArray_ == vertexArray) {
+            vertexArray_ = 0;
+            buffers_[ElementArrayBuffer] = kUnknown;
+        }
+    }
+
+    void GLStateCache::onBufferDeleted(GLuint buffer) {
+        for (auto& bound : buffers_) {
+            if (bound == buffer) {
+                bound = 0;
+            }
+        }
+        for (auto& bound : uniformBuffers_) {
+            if (bound == buffer) {
+                bound = 0;
+            }
+        }
+    }
+
+    void GLStateCache::onTextureDeleted(GLuint texture) {
+        for (auto& bound : textures_) {
+            if (bound == texture) {
+                bound = 0;
+            }
+        }
+    }
+
+    void GLStateCache::invalidate() {
+        program_ = kUnknown;
+        vertexArray_ = kUnknown;
+        buffers_.fill(kUnknown);
+        uniformBuffers_.fill(kUnknown);
+        activeUnit_ = kUnknown;
+        textures_.fill(kUnknown);
+        capabilities_.fill(Toggle::Unknown);
+        blendSource_ = kUnknown;
+        blendDestination_ = kUnknown;
+        depthFunc_ = kUnknown;
+        depthMask_ = Toggle::Unknown;
+        viewportKnown_ = false;
+    }
+
+} // namespace s3Dive
@@ -0,0 +1,108 @@
+#ifndef THREEDIVE_GL_STATE_CACHE_H
+#define THREEDIVE_GL_STATE_CACHE_H
+
+#include <array>
+#include <cstdint>
+#include <glad/glad.h>
+
+namespace s3Dive {
+
+    // Shadow copy of the GL state the engine touches: program, vertex array, buffer bindings, 2D textures
+    // per unit, a few capabilities, blend/depth state and the viewport. Every setter compares against the
+    // shadow value and only calls GL when it differs. All binds must go through here, otherwise the shadow
+    // goes stale; call invalidate() after code that changes state behind its back. Must be used from the GL thread.
+    class GLStateCache {
+    public:
+        struct Statistics {
+            uint32_t issued = 0; // GL calls made
+            uint32_t elided = 0; // GL calls skipped because the state already matched
+        };
+
+        static constexpr uint32_t kMaxTextureUnits = 16;
+        static constexpr uint32_t kMaxUniformBufferBindings = 16;
+
+        GLStateCache() { invalidate(); }
+        ~GLStateCache() = default;
+
+        GLStateCache(const GLStateCache&) = delete;
+        GLStateCache& operator=(const GLStateCache&) = delete;
+
+        [[nodiscard]] static GLStateCache& instance();
+
+        void useProgram(GLuint program);
+        void bindVertexArray(GLuint vertexArray);
+        // GL_ELEMENT_ARRAY_BUFFER is part of the bound vertex array, so its shadow is dropped on every VAO change
+        void bindBuffer(GLenum target, GLuint buffer);
+        void bindBufferBase(GLenum target, GLuint index, GLuint buffer);
+        void activeTexture(GLuint unit);
+        void bindTexture(GLuint unit, GLuint texture);
+        // Binds on whichever unit is active, for uploads that do not care about the unit
+        void bindTexture(GLuint texture);
+
+        void setEnabled(GLenum capability, bool enabled);
+        void setBlendFunc(GLenum source, GLenum destination);
+        void setDepthFunc(GLenum function);
+        void setDepthMask(bool write);
+        void setViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+        // Deleting a bound object resets its binding to 0 in GL, and a later object may reuse the name
+        void onProgramDeleted(GLuint program);
+        void onVertexArrayDeleted(GLuint vertexArray);
+        void onBufferDeleted(GLuint buffer);
+        void onTextureDeleted(GLuint texture);
+
+        // Forgets every shadow value, so the next setter of each kind always reaches GL
+        void invalidate();
+
+        void resetStatistics() noexcept { statistics_ = {}; }
+        [[nodiscard]] const Statistics& getStatistics() const noexcept { return statistics_; }
+
+    private:
+        static constexpr GLuint kUnknown = ~0u;
+
+        enum BufferTarget : uint8_t {
+            ArrayBuffer,
+            ElementArrayBuffer,
+            UniformBuffer,
+            DrawIndirectBuffer,
+            PixelUnpackBuffer,
+            BufferTargetCount
+        };
+
+        enum Capability : uint8_t {
+            Blend,
+            DepthTest,
+            CullFace,
+            LineSmooth,
+            ScissorTest,
+            CapabilityCount
+        };
+
+        // Tri-state so a capability nobody has set yet is never assumed off
+        enum class Toggle : uint8_t { Unknown, Off, On };
+
+        [[nodiscard]] static int bufferTargetIndex(GLenum target) noexcept;
+        [[nodiscard]] static int capabilityIndex(GLenum capability) noexcept;
+
+        // Records the outcome and returns true when the call has to be issued
+        bool update(GLuint& shadow, GLuint value) noexcept;
+
+        GLuint program_ = kUnknown;
+        GLuint vertexArray_ = kUnknown;
+        std::array<GLuint, BufferTargetCount> buffers_{};
+        std::array<GLuint, kMaxUniformBufferBindings> uniformBuffers_{};
+        GLuint activeUnit_ = kUnknown;
+        std::array<GLuint, kMaxTextureUnits> textures_{};
+        std::array<Toggle, CapabilityCount> capabilities_{};
+        GLenum blendSource_ = kUnknown;
+        GLenum blendDestination_ = kUnknown;
+        GLenum depthFunc_ = kUnknown;
+        Toggle depthMask_ = Toggle::Unknown;
+        std::array<GLint, 4> viewport_{};
+        bool viewportKnown_ = false;
+        Statistics statistics_;
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_GL_STATE_CACHE_H
@@ -0,0 +1,136 @@
+#ifndef THREEDIVE_GL_STD140_H
+#define THREEDIVE_GL_STD140_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <glm/glm.hpp>
+
+// std140 uniform block layout derived at compile time from a list of C++ struct members:
+//
+//   struct FrameUniforms { glm::mat4 view; glm::vec3 viewPosition; float exposure; };
+//   using FrameLayout = std140::Layout<&FrameUniforms::view, &FrameUniforms::viewPosition, &FrameUniforms::exposure>;
+//
+// The C++ struct keeps its natural layout; Layout::pack writes it into a std140 image whose offsets
+// (Layout::kOffsets) and size (Layout::kSize) are constants, so they can be checked with static_assert
+// against the GLSL block. Members must be listed in GLSL declaration order.
+namespace s3Dive::std140 {
+
+    constexpr std::size_t roundUp(std::size_t value, std::size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // Base alignment, size and writer of one member type (rules 1-5 of the std140 layout)
+    template<typename T>
+    struct TypeInfo;
+
+    template<typename T>
+    struct ScalarInfo {
+        static_assert(sizeof(T) == 4, "std140 scalars are 32-bit");
+        static constexpr std::size_t kAlignment = 4;
+        static constexpr std::size_t kSize = 4;
+        static void write(std::byte* out, const T& value) { std::memcpy(out, &value, sizeof(T)); }
+    };
+
+    template<> struct TypeInfo<float> : ScalarInfo<float> {};
+    template<> struct TypeInfo<int32_t> : ScalarInfo<int32_t> {};
+    template<> struct TypeInfo<uint32_t> : ScalarInfo<uint32_t> {};
+
+    // GLSL bool is 32 bits wide in a block
+    template<>
+    struct TypeInfo<bool> {
+        static constexpr std::size_t kAlignment = 4;
+        static constexpr std::size_t kSize = 4;
+        static void write(std::byte* out, const bool& value) {
+            const uint32_t word = value ? 1u : 0u;
+            std::memcpy(out, &word, sizeof(word));
+        }
+    };
+
+    // vec2 aligns to 8 bytes, vec3 and vec4 to 16
+    template<glm::length_t L, typename T, glm::qualifier Q>
+    struct TypeInfo<glm::vec<L, T, Q>> {
+        static_assert(sizeof(T) == 4, "std140 vector components are 32-bit");
+        static constexpr std::size_t kAlignment = L == 2 ? 8 : 16;
+        static constexpr std::size_t kSize = L * 4;
+        static void write(std::byte* out, const glm::vec<L, T, Q>& value) { std::memcpy(out, &value[0], kSize); }
+    };
+
+    // Column-major matrices are arrays of column vectors, each padded to 16 bytes
+    template<glm::length_t C, glm::length_t R, typename T, glm::qualifier Q>
+    struct TypeInfo<glm::mat<C, R, T, Q>> {
+        static_assert(sizeof(T) == 4, "std140 matrix components are 32-bit");
+        static constexpr std::size_t kAlignment = 16;
+        static constexpr std::size_t kSize = C * 16;
+        static void write(std::byte* out, const glm::mat<C, R, T, Q>& value) {
+            for (glm::length_t column = 0; column < C; ++column) {
+                std::memcpy(out + column * 16, &value[column][0], R * sizeof(T));
+            }
+        }
+    };
+
+    // Array elements are padded to a multiple of 16 bytes, whatever their type
+    template<typename T, std::size_t N>
+    struct TypeInfo<std::array<T, N>> {
+        static constexpr std::size_t kStride = roundUp(roundUp(TypeInfo<T>::kSize, TypeInfo<T>::kAlignment), 16);
+        static constexpr std::size_t kAlignment = roundUp(TypeInfo<T>::kAlignment, 16);
+        static constexpr std::size_t kSize = N * kStride;
+        static void write(std::byte* out, const std::array<T, N>& value) {
+            for (std::size_t i = 0; i < N; ++i) {
+                TypeInfo<T>::write(out + i * kStride, value[i]);
+            }
+        }
+    };
+
+    template<typename>
+    struct MemberTraits;
+
+    template<typename C, typename M>
+    struct MemberTraits<M C::*> {
+        using Class = C;
+        using Type = M;
+    };
+
+    template<auto Member>
+    using MemberInfo = TypeInfo<typename MemberTraits<decltype(Member)>::Type>;
+
+    template<auto First, auto... Rest>
+    class Layout {
+    public:
+        using Struct = typename MemberTraits<decltype(First)>::Class;
+        static constexpr std::size_t kMemberCount = 1 + sizeof...(Rest);
+
+    private:
+        static constexpr std::array<std::size_t, kMemberCount> kAlignments{MemberInfo<First>::kAlignment,
+                                                                           MemberInfo<Rest>::kAlignment...};
+        static constexpr std::array<std::size_t, kMemberCount> kSizes{MemberInfo<First>::kSize,
+                                                                      MemberInfo<Rest>::kSize...};
+
+        static constexpr std::array<std::size_t, kMemberCount> computeOffsets() {
+            std::array<std::size_t, kMemberCount> offsets{};
+            std::size_t offset = 0;
+            for (std::size_t i = 0; i < kMemberCount; ++i) {
+                offset = roundUp(offset, kAlignments[i]);
+                offsets[i] = offset;
+                offset += kSizes[i];
+            }
+            return offsets;
+        }
+
+    public:
+        static constexpr std::array<std::size_t, kMemberCount> kOffsets = computeOffsets();
+        // Rounded up to a vec4 so consecutive blocks in one buffer stay aligned
+        static constexpr std::size_t kSize = roundUp(kOffsets[kMemberCount - 1] + kSizes[kMemberCount - 1], 16);
+
+        static void pack(const Struct& value, std::byte* out) {
+            std::memset(out, 0, kSize);
+            std::size_t index = 0;
+            MemberInfo<First>::write(out + kOffsets[index++], value.*First);
+            (MemberInfo<Rest>::write(out + kOffsets[index++], value.*Rest), ...);
+        }
+    };
+
+} // namespace s3Dive::std140
+
+#endif //THREEDIVE_GL_STD140_H
@@ -7,6 +7,7 @@
 #include <stb_image.h>
 
 #include "gl_texture.h"
+#include "gl_state_cache.h"
 
 namespace s3Dive {
 
@@ -20,8 +21,22 @@ namespace s3Dive {
             spdlog::error("Failed to load texture: {}", path);
         }
 
+        createTexture(localBuffer_);
+
+        if (isBufferLoaded) {
+            stbi_image_free(localBuffer_);
+            localBuffer_ = nullptr;
+        }
+    }
+
+    GLTexture::GLTexture(int width, int height, const unsigned char *rgbaPixels)
+            : width_(width), height_(height), BPP_(4) {
+        createTexture(rgbaPixels);
+    }
+
+    void GLTexture::createTexture(const void *rgbaPixels) {
         glGenTextures(1, &rendererID_);
-        glBindTexture(GL_TEXTURE_2D, rendererID_);
+        GLStateCache::instance().bindTexture(rendererID_);
 
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -36,25 +51,49 @@ namespace s3Dive {
                      0,
                      GL_RGBA,
                      GL_UNSIGNED_BYTE,
-                     localBuffer_);
+                     rgbaPixels);
+    }
 
-        unbind();
+    void GLTexture::setData(int width, int height, const void *rgbaPixels) {
+        if (storageOwner_) {
+            storageOwner_.reset();
+            width_ = 0;
+            height_ = 0;
+            createTexture(nullptr);
+        }
+        GLStateCache::instance().bindTexture(rendererID_);
 
-        if (isBufferLoaded) {
-            stbi_image_free(localBuffer_);
+        if (width != width_ || height != height_) {
+            width_ = width;
+            height_ = height;
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width_, height_, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
         }
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width_, height_, GL_RGBA, GL_UNSIGNED_BYTE, rgbaPixels);
+    }
+
+    void GLTexture::shareStorage(std::shared_ptr<const GLTexture> owner) {
+        if (!storageOwner_) {
+            GLStateCache::instance().onTextureDeleted(rendererID_);
+            glDeleteTextures(1, &rendererID_);
+        }
+        // Point at the texture that really owns the storage, so sharing never chains
+        storageOwner_ = owner->storageOwner_ ? owner->storageOwner_ : std::move(owner);
+        rendererID_ = storageOwner_->rendererID_;
     }
 
     GLTexture::~GLTexture() {
+        if (storageOwner_) {
+            return;
+        }
+        GLStateCache::instance().onTextureDeleted(rendererID_);
         glDeleteTextures(1, &rendererID_);
     }
 
     void GLTexture::bind(unsigned int slot) const {
-        glActiveTexture(GL_TEXTURE0 + slot);
-        glBindTexture(GL_TEXTURE_2D, rendererID_);
+        GLStateCache::instance().bindTexture(slot, rendererID_);
     }
 
     void GLTexture::unbind() const {
-        glBindTexture(GL_TEXTURE_2D, 0);
+        GLStateCache::instance().bindTexture(0);
     }
 } // s3Dive
\ No newline at end of file
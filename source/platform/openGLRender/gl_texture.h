@@ -5,6 +5,8 @@
 #ifndef THREEDIVE_GL_TEXTURE_H
 #define THREEDIVE_GL_TEXTURE_H
 
+#include <memory>
+#include <string_view>
 #include <glad/glad.h>
 
 namespace s3Dive {
@@ -12,20 +14,33 @@ namespace s3Dive {
     class GLTexture {
     public:
         explicit GLTexture(std::string_view path);
+        GLTexture(int width, int height, const unsigned char *rgbaPixels);
         ~GLTexture();
 
+        // Replaces the RGBA8 contents, reallocating storage when the size changes. With a buffer bound to
+        // GL_PIXEL_UNPACK_BUFFER, rgbaPixels is an offset into that buffer.
+        void setData(int width, int height, const void *rgbaPixels);
+
+        // Frees this texture's own storage and samples owner's from then on, keeping owner alive as long as this
+        // texture lives; for a second copy of an image already on the GPU. A later setData gives it its own again.
+        void shareStorage(std::shared_ptr<const GLTexture> owner);
+
         void bind(unsigned int slot = 0) const;
         void unbind() const;
 
-        [[nodiscard]] inline int getWidth() const { return width_; }
-        [[nodiscard]] inline int getHeight() const { return height_; }
+        [[nodiscard]] inline int getWidth() const { return storageOwner_ ? storageOwner_->width_ : width_; }
+        [[nodiscard]] inline int getHeight() const { return storageOwner_ ? storageOwner_->height_ : height_; }
+        [[nodiscard]] inline GLuint getRendererID() const { return rendererID_; }
 
     private:
+        void createTexture(const void *rgbaPixels);
+
         GLuint rendererID_{};
         unsigned char *localBuffer_ = nullptr;
         int width_{};
         int height_{};
         int BPP_{};
+        std::shared_ptr<const GLTexture> storageOwner_; // Set while rendererID_ belongs to another texture
 
     };
 
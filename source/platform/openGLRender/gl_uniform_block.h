@@ -0,0 +1,42 @@
+#ifndef THREEDIVE_GL_UNIFORM_BLOCK_H
+#define THREEDIVE_GL_UNIFORM_BLOCK_H
+
+#include <array>
+#include <cstddef>
+#include "gl_std140.h"
+#include "gl_uniform_buffer.h"
+
+namespace s3Dive {
+
+    // A uniform buffer holding one std140 block described by Layout (see gl_std140.h)
+    template<typename Layout>
+    class GLUniformBlock {
+    public:
+        using Struct = typename Layout::Struct;
+
+        // Also binds the buffer to binding
+        explicit GLUniformBlock(uint32_t binding)
+                : binding_(binding), buffer_(static_cast<uint32_t>(Layout::kSize), binding) {}
+
+        GLUniformBlock(uint32_t binding, const Struct& value) : GLUniformBlock(binding) {
+            update(value);
+        }
+
+        void update(const Struct& value) {
+            Layout::pack(value, staging_.data());
+            buffer_.setData(staging_.data(), static_cast<uint32_t>(Layout::kSize));
+        }
+
+        void bind() const { buffer_.bind(binding_); }
+
+        [[nodiscard]] uint32_t getBinding() const noexcept { return binding_; }
+
+    private:
+        uint32_t binding_;
+        GLUniFormBuffer buffer_;
+        std::array<std::byte, Layout::kSize> staging_{};
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_GL_UNIFORM_BLOCK_H
@@ -1,28 +1,30 @@
 //
 // Created by ABDERRAHIM ZEBIRI on 2024-06-28.
 //
-#include <vector>
-#include "glad/glad.h"
-
 #include "gl_uniform_buffer.h"
+#include "gl_state_cache.h"
 
 namespace s3Dive {
 
     GLUniFormBuffer::GLUniFormBuffer(uint32_t size, uint32_t binding) {
         glGenBuffers(1, &rendererID_);
-        glBindBuffer(GL_UNIFORM_BUFFER, rendererID_);
+        GLStateCache::instance().bindBuffer(GL_UNIFORM_BUFFER, rendererID_);
         glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
-        glBindBufferBase(GL_UNIFORM_BUFFER, binding, rendererID_);
+        GLStateCache::instance().bindBufferBase(GL_UNIFORM_BUFFER, binding, rendererID_);
     }
 
     GLUniFormBuffer::~GLUniFormBuffer() {
+        GLStateCache::instance().onBufferDeleted(rendererID_);
         glDeleteBuffers(1, &rendererID_);
     }
 
-    template<typename T>
-    void GLUniFormBuffer::SetData(const std::vector<T> &data, uint32_t offset) {
-        glBindBuffer(GL_UNIFORM_BUFFER, rendererID_);
-        glBufferSubData(GL_UNIFORM_BUFFER, offset, data.size() * sizeof(T), data.data());
+    void GLUniFormBuffer::bind(uint32_t binding) const {
+        GLStateCache::instance().bindBufferBase(GL_UNIFORM_BUFFER, binding, rendererID_);
+    }
+
+    void GLUniFormBuffer::setData(const void *data, uint32_t size, uint32_t offset) {
+        GLStateCache::instance().bindBuffer(GL_UNIFORM_BUFFER, rendererID_);
+        glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
     }
 
-} // s3Dive
\ No newline at end of file
+} // s3Dive
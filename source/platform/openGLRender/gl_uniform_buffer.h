@@ -5,6 +5,9 @@
 #ifndef THREEDIVE_GL_UNIFORM_BUFFER_H
 #define THREEDIVE_GL_UNIFORM_BUFFER_H
 
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
 
 namespace s3Dive {
 
@@ -14,8 +17,18 @@ namespace s3Dive {
 
         ~GLUniFormBuffer();
 
+        GLUniFormBuffer(const GLUniFormBuffer&) = delete;
+        GLUniFormBuffer& operator=(const GLUniFormBuffer&) = delete;
+
+        // Attaches the buffer to a uniform block binding point, replacing whatever was bound there
+        void bind(uint32_t binding) const;
+
+        void setData(const void *data, uint32_t size, uint32_t offset = 0);
+
         template<typename T>
-        void SetData(const std::vector<T> &data, uint32_t offset = 0);
+        void setData(const std::vector<T> &data, uint32_t offset = 0) {
+            setData(data.data(), static_cast<uint32_t>(data.size() * sizeof(T)), offset);
+        }
 
     private:
         GLuint rendererID_{};
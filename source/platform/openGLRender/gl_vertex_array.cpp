@@ -4,6 +4,7 @@
 
 #include "gl_vertex_array.h"
 #include "gl_vertex_buffer_layout.h"
+#include "gl_state_cache.h"
 
 
 namespace s3Dive {
@@ -12,6 +13,7 @@ namespace s3Dive {
     }
 
     GLVertexArray::~GLVertexArray() {
+        GLStateCache::instance().onVertexArrayDeleted(rendererID_);
         glDeleteVertexArrays(1, &rendererID_);
     }
 
@@ -29,21 +31,37 @@ namespace s3Dive {
             glEnableVertexAttribArray(i);
             glVertexAttribPointer(i, element.count, element.type, element.isNormalized, stride,
                                   (const void *) (uintptr_t) (offset));
-            offset += element.count * VertexBufferElement::getSizeOfType(element.type);
+            offset += element.getSize();
         }
         vertexBuffers_.push_back(vbo);
 
     }
 
     void GLVertexArray::bind() const {
-        glBindVertexArray(rendererID_);
+        GLStateCache::instance().bindVertexArray(rendererID_);
     }
 
     void GLVertexArray::unbind() const {
-        glBindVertexArray(0);
+        GLStateCache::instance().bindVertexArray(0);
     }
 
 
+    void GLVertexArray::setInstanceAttributes(const GLVertexBuffer &buffer, GLuint firstLocation, GLintptr offset) const {
+        buffer.bind();
+
+        const auto &elements = buffer.getLayout().getElements();
+        const auto stride = buffer.getLayout().getStride();
+        for (GLuint i = 0; i < elements.size(); ++i) {
+            const auto &element = elements[i];
+            const GLuint location = firstLocation + i;
+            glEnableVertexAttribArray(location);
+            glVertexAttribPointer(location, element.count, element.type, element.isNormalized, stride,
+                                  (const void *) (uintptr_t) (offset));
+            glVertexAttribDivisor(location, 1);
+            offset += element.getSize();
+        }
+    }
+
     void GLVertexArray::setIndexBuffer(const std::shared_ptr<GLIndexBuffer> &ibo) {
         bind();
         ibo->bind();
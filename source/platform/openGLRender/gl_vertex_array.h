@@ -25,8 +25,13 @@ namespace s3Dive {
         void addVertexBuffer(const std::shared_ptr<GLVertexBuffer> &vbo);
         void setIndexBuffer(const std::shared_ptr<GLIndexBuffer> &ibo);
 
+        // Points one attribute per element of buffer's layout, starting at firstLocation, at per-instance records
+        // beginning offset bytes into buffer. The array must already be bound.
+        void setInstanceAttributes(const GLVertexBuffer &buffer, GLuint firstLocation, GLintptr offset) const;
+
         [[nodiscard]] const std::vector<std::shared_ptr<GLVertexBuffer>> &getVertexBuffers() const { return vertexBuffers_; }
         [[nodiscard]] const std::shared_ptr<GLIndexBuffer> &getIndexBuffer() const { return indexBuffer_; }
+        [[nodiscard]] GLuint getRendererID() const { return rendererID_; }
 
     private:
         GLuint rendererID_{};
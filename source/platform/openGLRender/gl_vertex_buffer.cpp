@@ -3,32 +3,54 @@
 //
 
 #include "gl_vertex_buffer.h"
+#include "gl_state_cache.h"
 
 namespace s3Dive {
     GLVertexBuffer::GLVertexBuffer(const std::vector<float> &data) {
         glGenBuffers(1, &rendererID_);
-        glBindBuffer(GL_ARRAY_BUFFER, rendererID_);
+        GLStateCache::instance().bindBuffer(GL_ARRAY_BUFFER, rendererID_);
         glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(data.size() * sizeof(float)), data.data(),
                      GL_STATIC_DRAW);
     }
 
     GLVertexBuffer::GLVertexBuffer(const std::vector<glm::vec3> &data) {
         glGenBuffers(1, &rendererID_);
-        glBindBuffer(GL_ARRAY_BUFFER, rendererID_);
+        GLStateCache::instance().bindBuffer(GL_ARRAY_BUFFER, rendererID_);
         glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(data.size() * sizeof(glm::vec3)), data.data(),
                      GL_STATIC_DRAW);
     }
 
+    GLVertexBuffer::GLVertexBuffer(const void *data, GLsizeiptr size) {
+        glGenBuffers(1, &rendererID_);
+        GLStateCache::instance().bindBuffer(GL_ARRAY_BUFFER, rendererID_);
+        glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+    }
+
+    GLVertexBuffer::GLVertexBuffer() {
+        glGenBuffers(1, &rendererID_);
+    }
+
     GLVertexBuffer::~GLVertexBuffer() {
+        GLStateCache::instance().onBufferDeleted(rendererID_);
         glDeleteBuffers(1, &rendererID_);
     }
 
     void GLVertexBuffer::bind() const {
-        glBindBuffer(GL_ARRAY_BUFFER, rendererID_);
+        GLStateCache::instance().bindBuffer(GL_ARRAY_BUFFER, rendererID_);
     }
 
     void GLVertexBuffer::unbind() const {
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        GLStateCache::instance().bindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void GLVertexBuffer::setData(const void *data, GLsizeiptr size) {
+        GLStateCache::instance().bindBuffer(GL_ARRAY_BUFFER, rendererID_);
+        glBufferData(GL_ARRAY_BUFFER, size, data, GL_STREAM_DRAW);
+    }
+
+    void GLVertexBuffer::setSubData(GLintptr offset, const void *data, GLsizeiptr size) {
+        GLStateCache::instance().bindBuffer(GL_ARRAY_BUFFER, rendererID_);
+        glBufferSubData(GL_ARRAY_BUFFER, offset, size, data);
     }
 
     void GLVertexBuffer::setLayout(const GLVertexBufferLayout &layout) {
@@ -38,4 +60,8 @@ namespace s3Dive {
     GLVertexBufferLayout &GLVertexBuffer::getLayout() {
         return layout_;
     }
+
+    const GLVertexBufferLayout &GLVertexBuffer::getLayout() const {
+        return layout_;
+    }
 } // s3Dive
\ No newline at end of file
@@ -19,14 +19,23 @@ namespace s3Dive {
     public:
         explicit GLVertexBuffer(const std::vector<float> &data);
         explicit GLVertexBuffer(const std::vector<glm::vec3> &data);
+        GLVertexBuffer(const void *data, GLsizeiptr size);
+        // Empty buffer for per-frame data uploaded with setData
+        GLVertexBuffer();
 
         ~GLVertexBuffer();
 
         void bind() const;
         void unbind() const;
 
+        // Replaces the whole store; the old one is orphaned so draws still reading it do not stall
+        void setData(const void *data, GLsizeiptr size);
+        // Overwrites size bytes at offset within the existing store
+        void setSubData(GLintptr offset, const void *data, GLsizeiptr size);
+
         void setLayout(const GLVertexBufferLayout &layout);
         GLVertexBufferLayout &getLayout();
+        [[nodiscard]] const GLVertexBufferLayout &getLayout() const;
 
     private:
         unsigned int rendererID_{};
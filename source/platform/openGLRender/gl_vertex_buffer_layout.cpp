@@ -11,7 +11,11 @@ namespace s3Dive {
     void GLVertexBufferLayout::addVertexElement([[maybe_unused]] GLint count) {
         static_assert(std::is_same<T, float>::value ||
                       std::is_same<T, unsigned int>::value ||
-                      std::is_same<T, unsigned char>::value,
+                      std::is_same<T, unsigned char>::value ||
+                      std::is_same<T, short>::value ||
+                      std::is_same<T, unsigned short>::value ||
+                      std::is_same<T, HalfFloat>::value ||
+                      std::is_same<T, PackedSnorm2101010>::value,
                       "Unsupported type for GLVertexBufferLayout::addVertexElement");
     }
 
@@ -33,6 +37,31 @@ namespace s3Dive {
         stride_ += count * VertexBufferElement::getSizeOfType(GL_UNSIGNED_BYTE);
     }
 
+    template<>
+    void GLVertexBufferLayout::addVertexElement<short>(GLint count) {
+        elements_.push_back({GL_SHORT, count, GL_TRUE});
+        stride_ += count * VertexBufferElement::getSizeOfType(GL_SHORT);
+    }
+
+    template<>
+    void GLVertexBufferLayout::addVertexElement<unsigned short>(GLint count) {
+        elements_.push_back({GL_UNSIGNED_SHORT, count, GL_TRUE});
+        stride_ += count * VertexBufferElement::getSizeOfType(GL_UNSIGNED_SHORT);
+    }
+
+    template<>
+    void GLVertexBufferLayout::addVertexElement<HalfFloat>(GLint count) {
+        elements_.push_back({GL_HALF_FLOAT, count, GL_FALSE});
+        stride_ += count * VertexBufferElement::getSizeOfType(GL_HALF_FLOAT);
+    }
+
+    // Always four components in a single 32-bit word, whatever count is passed
+    template<>
+    void GLVertexBufferLayout::addVertexElement<PackedSnorm2101010>([[maybe_unused]] GLint count) {
+        elements_.push_back({GL_INT_2_10_10_10_REV, 4, GL_TRUE});
+        stride_ += elements_.back().getSize();
+    }
+
     GLsizei GLVertexBufferLayout::getStride() const {
         return (GLsizei) stride_;
     }
@@ -6,11 +6,22 @@
 #define THREEDIVE_GL_VERTEX_BUFFER_LAYOUT_H
 
 #include <glad/glad.h>
+#include <cstdint>
 #include <vector>
 #include <stdexcept>
 
 namespace s3Dive {
 
+    // Storage types for compact vertex attributes that have no C++ equivalent
+    struct HalfFloat {
+        uint16_t bits;
+    };
+
+    // Signed normalized x, y, z in 10 bits each and w in 2 bits (GL_INT_2_10_10_10_REV)
+    struct PackedSnorm2101010 {
+        uint32_t bits;
+    };
+
     struct VertexBufferElement {
         GLuint type;
         GLint count;
@@ -22,12 +33,24 @@ namespace s3Dive {
                 case GL_FLOAT:
                 case GL_UNSIGNED_INT:
                     return 4;
+                case GL_HALF_FLOAT:
+                case GL_SHORT:
+                case GL_UNSIGNED_SHORT:
+                    return 2;
                 case GL_UNSIGNED_BYTE:
                     return 1;
                 default:
                     throw std::invalid_argument("Unsupported type in VertexBufferElement");
             }
         }
+
+        // Returns the size in bytes of the whole attribute; packed types hold every component in one word
+        [[nodiscard]] unsigned int getSize() const {
+            if (type == GL_INT_2_10_10_10_REV) {
+                return 4;
+            }
+            return count * getSizeOfType(type);
+        }
     };
 
     class GLVertexBufferLayout {
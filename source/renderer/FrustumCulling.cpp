@@ -0,0 +1,75 @@
+#include "FrustumCulling.h"
+#include <algorithm>
+#include "../core/simd.h"
+
+namespace s3Dive {
+
+    void CullingBounds::push(const glm::vec3& center, const glm::vec3& extent) {
+        if (count_ == components_[0].size()) {
+            // Grow by whole vectors; the padding lanes are zero-sized boxes whose results are ignored
+            const std::size_t capacity = simd::paddedCount(std::max<std::size_t>(count_ * 2, simd::kWidth));
+            for (auto& component : components_) {
+                component.resize(capacity, 0.0f);
+            }
+        }
+        components_[CenterX][count_] = center.x;
+        components_[CenterY][count_] = center.y;
+        components_[CenterZ][count_] = center.z;
+        components_[ExtentX][count_] = extent.x;
+        components_[ExtentY][count_] = extent.y;
+        components_[ExtentZ][count_] = extent.z;
+        ++count_;
+    }
+
+    std::size_t cullFrustum(const Frustum& frustum, const CullingBounds& bounds, std::vector<uint8_t>& visible) {
+        const std::size_t count = bounds.size();
+        visible.resize(count);
+
+        struct PlaneV {
+            simd::FloatV nx, ny, nz, d;
+            simd::FloatV ax, ay, az; // |normal|, projects the half extent onto the normal
+        };
+        std::array<PlaneV, Frustum::PlaneCount> planes{};
+        for (std::size_t i = 0; i < planes.size(); ++i) {
+            const auto& plane = frustum.planes[i];
+            planes[i] = {simd::set1(plane.x), simd::set1(plane.y), simd::set1(plane.z), simd::set1(plane.w),
+                         simd::set1(std::abs(plane.x)), simd::set1(std::abs(plane.y)), simd::set1(std::abs(plane.z))};
+        }
+
+        const float* centerX = bounds.get(CullingBounds::CenterX);
+        const float* centerY = bounds.get(CullingBounds::CenterY);
+        const float* centerZ = bounds.get(CullingBounds::CenterZ);
+        const float* extentX = bounds.get(CullingBounds::ExtentX);
+        const float* extentY = bounds.get(CullingBounds::ExtentY);
+        const float* extentZ = bounds.get(CullingBounds::ExtentZ);
+        const simd::FloatV zero = simd::set1(0.0f);
+
+        std::size_t visibleCount = 0;
+        for (std::size_t base = 0; base < count; base += simd::kWidth) {
+            const auto cx = simd::load(centerX + base);
+            const auto cy = simd::load(centerY + base);
+            const auto cz = simd::load(centerZ + base);
+            const auto ex = simd::load(extentX + base);
+            const auto ey = simd::load(extentY + base);
+            const auto ez = simd::load(extentZ + base);
+
+            // A box is outside when its centre lies further behind some plane than its projected radius
+            auto inside = simd::allTrue();
+            for (const auto& plane : planes) {
+                const auto distance = plane.nx * cx + plane.ny * cy + plane.nz * cz + plane.d;
+                const auto radius = plane.ax * ex + plane.ay * ey + plane.az * ez;
+                inside = inside & (distance + radius >= zero);
+            }
+
+            const uint32_t laneBits = simd::bits(inside);
+            const std::size_t lanes = std::min(simd::kWidth, count - base);
+            for (std::size_t lane = 0; lane < lanes; ++lane) {
+                const uint8_t isVisible = (laneBits >> lane) & 1u;
+                visible[base + lane] = isVisible;
+                visibleCount += isVisible;
+            }
+        }
+        return visibleCount;
+    }
+
+} // namespace s3Dive
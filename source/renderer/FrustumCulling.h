@@ -0,0 +1,36 @@
+#ifndef THREEDIVE_FRUSTUMCULLING_H
+#define THREEDIVE_FRUSTUMCULLING_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../camera/frustum.h"
+
+namespace s3Dive {
+
+    // World-space boxes as centre and half extent, one array per component. Every array is padded to a
+    // multiple of simd::kWidth, so the culling loop reads whole vectors without a scalar tail.
+    class CullingBounds {
+    public:
+        enum Component { CenterX, CenterY, CenterZ, ExtentX, ExtentY, ExtentZ, ComponentCount };
+
+        void clear() noexcept { count_ = 0; }
+        void push(const glm::vec3& center, const glm::vec3& extent);
+
+        [[nodiscard]] std::size_t size() const noexcept { return count_; }
+        [[nodiscard]] const float* get(Component component) const noexcept { return components_[component].data(); }
+
+    private:
+        std::array<std::vector<float>, ComponentCount> components_;
+        std::size_t count_ = 0;
+    };
+
+    // Tests simd::kWidth boxes per plane and instruction; visible[i] becomes 1 when box i intersects the
+    // frustum and 0 otherwise. Returns the number of visible boxes.
+    std::size_t cullFrustum(const Frustum& frustum, const CullingBounds& bounds, std::vector<uint8_t>& visible);
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_FRUSTUMCULLING_H
@@ -0,0 +1,184 @@
+#include "GeometryArena.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace s3Dive {
+
+    namespace {
+
+        GLVertexBufferLayout makeLayout(VertexFormat format) {
+            GLVertexBufferLayout layout;
+            switch (format) {
+                case VertexFormat::Float:
+                    layout.addVertexElement<float>(3); // Position
+                    layout.addVertexElement<float>(3); // Normal
+                    layout.addVertexElement<float>(2); // TexCoords
+                    break;
+                case VertexFormat::QuantizedPacked:
+                case VertexFormat::QuantizedOctahedral:
+                    layout.addVertexElement<unsigned short>(4); // Position, unorm16 within the mesh AABB (w is padding)
+                    if (format == VertexFormat::QuantizedOctahedral) {
+                        layout.addVertexElement<short>(2); // Normal, octahedral snorm16
+                    } else {
+                        layout.addVertexElement<PackedSnorm2101010>(4); // Normal, snorm 10:10:10:2
+                    }
+                    layout.addVertexElement<HalfFloat>(2); // TexCoords
+                    break;
+            }
+            return layout;
+        }
+
+        GLuint getIndexSize(GLenum indexType) {
+            return indexType == GL_UNSIGNED_SHORT ? sizeof(uint16_t) : sizeof(GLuint);
+        }
+
+    } // namespace
+
+    GeometryAllocation::~GeometryAllocation() {
+        GeometryArena::instance().release(*this);
+    }
+
+    GeometryArena::RangeAllocator::RangeAllocator(GLuint capacity) {
+        freeRanges_.emplace(0, capacity);
+    }
+
+    std::optional<GLuint> GeometryArena::RangeAllocator::allocate(GLuint size) {
+        for (auto it = freeRanges_.begin(); it != freeRanges_.end(); ++it) {
+            if (it->second < size) {
+                continue;
+            }
+            const GLuint offset = it->first;
+            const GLuint remaining = it->second - size;
+            freeRanges_.erase(it);
+            if (remaining > 0) {
+                freeRanges_.emplace(offset + size, remaining);
+            }
+            return offset;
+        }
+        return std::nullopt;
+    }
+
+    void GeometryArena::RangeAllocator::release(GLuint offset, GLuint size) {
+        if (size == 0) {
+            return;
+        }
+        auto [it, inserted] = freeRanges_.emplace(offset, size);
+        if (!inserted) {
+            return;
+        }
+        // Merge with the following range, then with the preceding one
+        if (auto next = std::next(it); next != freeRanges_.end() && it->first + it->second == next->first) {
+            it->second += next->second;
+            freeRanges_.erase(next);
+        }
+        if (it != freeRanges_.begin()) {
+            if (auto previous = std::prev(it); previous->first + previous->second == it->first) {
+                previous->second += it->second;
+                freeRanges_.erase(it);
+            }
+        }
+    }
+
+    GeometryArena::Pool::Pool(VertexFormat format, GLenum indexType, GLuint vertexCapacity, GLuint indexCapacity)
+            : format(format),
+              indexType(indexType),
+              vertices(vertexCapacity),
+              indices(indexCapacity) {
+        // Creating the index buffer binds it to whichever vertex array is current, so make that ours
+        vertexArray.bind();
+        vertexBuffer = std::make_shared<GLVertexBuffer>(
+                nullptr, static_cast<GLsizeiptr>(vertexCapacity) * getVertexStride(format));
+        indexBuffer = std::make_shared<GLIndexBuffer>(indexType, indexCapacity);
+        vertexBuffer->setLayout(makeLayout(format));
+        vertexArray.addVertexBuffer(vertexBuffer);
+        vertexArray.setIndexBuffer(indexBuffer);
+        vertexArray.unbind();
+    }
+
+    GeometryArena& GeometryArena::instance() {
+        static GeometryArena arena;
+        return arena;
+    }
+
+    GLsizei GeometryArena::getVertexStride(VertexFormat format) {
+        return format == VertexFormat::Float ? 8 * sizeof(float) : 16;
+    }
+
+    std::shared_ptr<const GeometryAllocation> GeometryArena::allocate(VertexFormat format,
+                                                                      const void* vertices, GLuint vertexCount,
+                                                                      const void* indices, GLenum indexType,
+                                                                      GLuint indexCount) {
+        std::size_t poolIndex = 0;
+        std::optional<GLuint> vertexOffset;
+        std::optional<GLuint> indexOffset;
+        for (; poolIndex < pools_.size(); ++poolIndex) {
+            auto& pool = *pools_[poolIndex];
+            if (pool.format != format || pool.indexType != indexType) {
+                continue;
+            }
+            vertexOffset = pool.vertices.allocate(vertexCount);
+            if (!vertexOffset) {
+                continue;
+            }
+            indexOffset = pool.indices.allocate(indexCount);
+            if (indexOffset) {
+                break;
+            }
+            pool.vertices.release(*vertexOffset, vertexCount);
+        }
+
+        if (poolIndex == pools_.size()) {
+            pools_.push_back(std::make_unique<Pool>(format, indexType,
+                                                    std::max(vertexCount, kDefaultVertexCapacity),
+                                                    std::max(indexCount, kDefaultIndexCapacity)));
+            vertexOffset = pools_.back()->vertices.allocate(vertexCount);
+            indexOffset = pools_.back()->indices.allocate(indexCount);
+            ++statistics_.pools;
+            spdlog::info("Geometry arena: new pool {} for vertex format {}", poolIndex, static_cast<int>(format));
+        }
+
+        auto& pool = *pools_[poolIndex];
+        const GLsizei stride = getVertexStride(format);
+        pool.vertexBuffer->setSubData(static_cast<GLintptr>(*vertexOffset) * stride, vertices,
+                                      static_cast<GLsizeiptr>(vertexCount) * stride);
+        // The element array binding belongs to the vertex array, so update it through the pool's own
+        pool.vertexArray.bind();
+        pool.indexBuffer->setSubData(*indexOffset, indices, indexCount);
+        pool.vertexArray.unbind();
+
+        auto allocation = std::make_shared<GeometryAllocation>();
+        allocation->pool = static_cast<uint32_t>(poolIndex);
+        allocation->id = nextAllocationId_++;
+        allocation->format = format;
+        allocation->vertexArray = &pool.vertexArray;
+        allocation->indexType = indexType;
+        allocation->baseVertex = static_cast<GLint>(*vertexOffset);
+        allocation->firstIndex = *indexOffset;
+        allocation->vertexCount = vertexCount;
+        allocation->indexCount = indexCount;
+
+        ++statistics_.allocations;
+        statistics_.vertexBytes += static_cast<uint64_t>(vertexCount) * stride;
+        statistics_.indexBytes += static_cast<uint64_t>(indexCount) * getIndexSize(indexType);
+        return allocation;
+    }
+
+    void GeometryArena::release(const GeometryAllocation& allocation) {
+        if (allocation.vertexArray == nullptr || allocation.pool >= pools_.size()) {
+            return;
+        }
+        auto& pool = *pools_[allocation.pool];
+        pool.vertices.release(static_cast<GLuint>(allocation.baseVertex), allocation.vertexCount);
+        pool.indices.release(allocation.firstIndex, allocation.indexCount);
+
+        --statistics_.allocations;
+        statistics_.vertexBytes -= static_cast<uint64_t>(allocation.vertexCount) * getVertexStride(allocation.format);
+        statistics_.indexBytes -= static_cast<uint64_t>(allocation.indexCount) * getIndexSize(allocation.indexType);
+    }
+
+    void GeometryArena::shutdown() {
+        pools_.clear();
+        statistics_ = {};
+    }
+
+} // namespace s3Dive
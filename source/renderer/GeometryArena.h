@@ -0,0 +1,112 @@
+#ifndef THREEDIVE_GEOMETRYARENA_H
+#define THREEDIVE_GEOMETRYARENA_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+#include <glad/glad.h>
+#include "../platform/openGLRender/gl_index_buffer.h"
+#include "../platform/openGLRender/gl_vertex_array.h"
+#include "../platform/openGLRender/gl_vertex_buffer.h"
+
+namespace s3Dive {
+
+    // Vertex layouts the arena can hold; every mesh in one pool shares its layout and vertex array
+    enum class VertexFormat : uint8_t {
+        Float,               // Position, normal, texcoords as 8 floats
+        QuantizedPacked,     // QuantizedVertex with 10:10:10:2 normals
+        QuantizedOctahedral  // QuantizedVertex with octahedral snorm16 normals
+    };
+
+    // A mesh's ranges inside one arena pool; returns them to the arena when destroyed
+    struct GeometryAllocation {
+        GeometryAllocation() = default;
+        ~GeometryAllocation();
+
+        GeometryAllocation(const GeometryAllocation&) = delete;
+        GeometryAllocation& operator=(const GeometryAllocation&) = delete;
+
+        uint32_t pool = 0;
+        uint32_t id = 0; // Unique among the arena's allocations until it wraps; sorts draws of one mesh together
+        VertexFormat format = VertexFormat::Float;
+        const GLVertexArray* vertexArray = nullptr;
+        GLenum indexType = GL_UNSIGNED_INT;
+        GLint baseVertex = 0;
+        GLuint firstIndex = 0;
+        GLuint vertexCount = 0;
+        GLuint indexCount = 0;
+    };
+
+    // Suballocates static meshes from a few large vertex and index buffers, one set per vertex format and
+    // index type, so meshes can be drawn together with glMultiDrawElementsIndirect and baseVertex offsets.
+    // A pool that runs out of room is followed by a new one. Must be used from the GL thread.
+    class GeometryArena {
+    public:
+        struct Statistics {
+            uint32_t pools = 0;
+            uint32_t allocations = 0;
+            uint64_t vertexBytes = 0; // Currently allocated, not capacity
+            uint64_t indexBytes = 0;
+        };
+
+        static constexpr GLuint kDefaultVertexCapacity = 1u << 20;
+        static constexpr GLuint kDefaultIndexCapacity = 3u << 20;
+
+        GeometryArena() = default;
+        ~GeometryArena() = default;
+
+        GeometryArena(const GeometryArena&) = delete;
+        GeometryArena& operator=(const GeometryArena&) = delete;
+
+        [[nodiscard]] static GeometryArena& instance();
+
+        // indexType is GL_UNSIGNED_SHORT or GL_UNSIGNED_INT; indices are relative to the mesh's first vertex
+        [[nodiscard]] std::shared_ptr<const GeometryAllocation> allocate(VertexFormat format,
+                                                                         const void* vertices, GLuint vertexCount,
+                                                                         const void* indices, GLenum indexType,
+                                                                         GLuint indexCount);
+
+        [[nodiscard]] static GLsizei getVertexStride(VertexFormat format);
+        [[nodiscard]] const Statistics& getStatistics() const noexcept { return statistics_; }
+
+        // Deletes every pool; allocations released afterwards are ignored
+        void shutdown();
+
+    private:
+        friend struct GeometryAllocation;
+
+        // First-fit free list over [0, capacity) with coalescing on release
+        class RangeAllocator {
+        public:
+            explicit RangeAllocator(GLuint capacity);
+            [[nodiscard]] std::optional<GLuint> allocate(GLuint size);
+            void release(GLuint offset, GLuint size);
+
+        private:
+            std::map<GLuint, GLuint> freeRanges_; // offset -> size
+        };
+
+        struct Pool {
+            Pool(VertexFormat format, GLenum indexType, GLuint vertexCapacity, GLuint indexCapacity);
+
+            VertexFormat format;
+            GLenum indexType;
+            GLVertexArray vertexArray;
+            std::shared_ptr<GLVertexBuffer> vertexBuffer;
+            std::shared_ptr<GLIndexBuffer> indexBuffer;
+            RangeAllocator vertices;
+            RangeAllocator indices;
+        };
+
+        void release(const GeometryAllocation& allocation);
+
+        std::vector<std::unique_ptr<Pool>> pools_;
+        uint32_t nextAllocationId_ = 0;
+        Statistics statistics_;
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_GEOMETRYARENA_H
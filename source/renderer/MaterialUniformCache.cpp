@@ -0,0 +1,55 @@
+#include "MaterialUniformCache.h"
+#include "../core/hash.h"
+
+namespace s3Dive {
+
+    namespace {
+
+        uint64_t hashUniforms(const MaterialUniforms& uniforms) noexcept {
+            uint64_t seed = hash::fnv1a64(&uniforms.albedo, sizeof(uniforms.albedo));
+            seed = hash::fnv1a64(&uniforms.metallic, sizeof(uniforms.metallic), seed);
+            seed = hash::fnv1a64(&uniforms.roughness, sizeof(uniforms.roughness), seed);
+            return hash::fnv1a64(&uniforms.ao, sizeof(uniforms.ao), seed);
+        }
+
+        bool operator==(const MaterialUniforms& lhs, const MaterialUniforms& rhs) noexcept {
+            return lhs.albedo == rhs.albedo && lhs.metallic == rhs.metallic && lhs.roughness == rhs.roughness &&
+                   lhs.ao == rhs.ao;
+        }
+
+    } // namespace
+
+    MaterialUniformCache& MaterialUniformCache::instance() {
+        static MaterialUniformCache materialUniformCache;
+        return materialUniformCache;
+    }
+
+    std::shared_ptr<const MaterialUniformBlock> MaterialUniformCache::get(const MaterialUniforms& uniforms) {
+        auto& entry = blocks_[hashUniforms(uniforms)];
+        if (auto block = entry.block.lock()) {
+            if (entry.uniforms == uniforms) {
+                return block;
+            }
+            // Hash collision with a live block: correct, just not shared
+            return std::make_shared<const MaterialUniformBlock>(kMaterialUniformBinding, uniforms);
+        }
+
+        auto block = std::make_shared<const MaterialUniformBlock>(kMaterialUniformBinding, uniforms);
+        entry = {uniforms, block};
+        return block;
+    }
+
+    std::size_t MaterialUniformCache::evictExpired() {
+        std::size_t evicted = 0;
+        for (auto it = blocks_.begin(); it != blocks_.end();) {
+            if (it->second.block.expired()) {
+                it = blocks_.erase(it);
+                ++evicted;
+            } else {
+                ++it;
+            }
+        }
+        return evicted;
+    }
+
+} // namespace s3Dive
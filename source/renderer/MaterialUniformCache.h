@@ -0,0 +1,39 @@
+#ifndef THREEDIVE_MATERIALUNIFORMCACHE_H
+#define THREEDIVE_MATERIALUNIFORMCACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include "UniformBlocks.h"
+
+namespace s3Dive {
+
+    // Hands out one MaterialData block per distinct set of material values, so meshes whose materials are
+    // equal share a block and the Renderer can batch them. Like TextureCache it only holds weak references;
+    // a block is freed with the last material using it. Must be used from the GL thread.
+    class MaterialUniformCache {
+    public:
+        MaterialUniformCache() = default;
+
+        MaterialUniformCache(const MaterialUniformCache&) = delete;
+        MaterialUniformCache& operator=(const MaterialUniformCache&) = delete;
+
+        [[nodiscard]] static MaterialUniformCache& instance();
+
+        [[nodiscard]] std::shared_ptr<const MaterialUniformBlock> get(const MaterialUniforms& uniforms);
+
+        // Drops entries whose block is no longer referenced; returns how many were evicted
+        std::size_t evictExpired();
+
+    private:
+        struct Entry {
+            MaterialUniforms uniforms;
+            std::weak_ptr<const MaterialUniformBlock> block;
+        };
+
+        std::unordered_map<uint64_t, Entry> blocks_; // By hash of the values
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_MATERIALUNIFORMCACHE_H
@@ -0,0 +1,269 @@
+#include "OcclusionCuller.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include "../core/parallel_for.h"
+#include "../core/simd.h"
+
+namespace s3Dive {
+
+    namespace {
+
+        // Vertices closer to the eye plane than this are treated as crossing the near plane
+        constexpr float kMinClipW = 1e-5f;
+        // Pixel centres exactly on an edge shared by two triangles can round to outside of both; pushing every
+        // edge out by this fraction of a pixel closes those cracks
+        constexpr float kEdgeBias = 1e-3f;
+        // Boxes are pulled this far toward the eye, so an occluder whose surface lies on its own box (a flat
+        // panel) is not hidden by the rounding of its rasterized depth
+        constexpr float kDepthBias = 1e-5f;
+        // Tile rows per parallelFor range; keeps thread count sensible at low resolutions
+        constexpr std::size_t kMinTileRowsPerBand = 2;
+
+    } // namespace
+
+    OcclusionCuller::OcclusionCuller(const OcclusionSettings& settings)
+            : settings_(settings),
+              stride_(static_cast<uint32_t>(simd::paddedCount(settings.width))),
+              tilesX_((settings.width + kTileSize - 1) / kTileSize),
+              tilesY_((settings.height + kTileSize - 1) / kTileSize),
+              depth_(std::size_t{stride_} * settings.height, 1.0f),
+              tileMaxDepth_(std::size_t{tilesX_} * tilesY_, 1.0f) {}
+
+    void OcclusionCuller::beginFrame(const glm::mat4& viewProjection) {
+        viewProjection_ = viewProjection;
+        std::fill(depth_.begin(), depth_.end(), 1.0f);
+        std::fill(tileMaxDepth_.begin(), tileMaxDepth_.end(), 1.0f);
+        triangles_.clear();
+        statistics_ = {};
+    }
+
+    void OcclusionCuller::addOccluder(const OccluderMesh& mesh, const glm::mat4& transform) {
+        const glm::mat4 modelViewProjection = viewProjection_ * transform;
+        clipPositions_.resize(mesh.positions.size());
+        for (std::size_t i = 0; i < mesh.positions.size(); ++i) {
+            clipPositions_[i] = modelViewProjection * glm::vec4(mesh.positions[i], 1.0f);
+        }
+        for (std::size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            setupTriangle(clipPositions_[mesh.indices[i]], clipPositions_[mesh.indices[i + 1]],
+                          clipPositions_[mesh.indices[i + 2]]);
+        }
+        ++statistics_.occluders;
+    }
+
+    void OcclusionCuller::setupTriangle(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2) {
+        // Dropping an occluder triangle only makes culling less effective, never wrong, so anything that
+        // would need clipping is skipped
+        if (v0.w < kMinClipW || v1.w < kMinClipW || v2.w < kMinClipW) {
+            return;
+        }
+
+        const auto width = static_cast<float>(settings_.width);
+        const auto height = static_cast<float>(settings_.height);
+        float x[3];
+        float y[3];
+        float z[3];
+        const glm::vec4* vertices[3] = {&v0, &v1, &v2};
+        for (int i = 0; i < 3; ++i) {
+            const auto& v = *vertices[i];
+            x[i] = (v.x / v.w * 0.5f + 0.5f) * width;
+            y[i] = (v.y / v.w * 0.5f + 0.5f) * height;
+            z[i] = v.z / v.w * 0.5f + 0.5f;
+            if (z[i] < 0.0f) {
+                return;
+            }
+        }
+
+        float area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+        if (std::abs(area) < 1e-6f) {
+            return;
+        }
+        // Both faces occlude; make the winding counter-clockwise so inside means all edges non-negative
+        if (area < 0.0f) {
+            std::swap(x[1], x[2]);
+            std::swap(y[1], y[2]);
+            std::swap(z[1], z[2]);
+            area = -area;
+        }
+
+        Triangle triangle{};
+        triangle.minX = std::max(0, static_cast<int>(std::floor(std::min({x[0], x[1], x[2]}))));
+        triangle.minY = std::max(0, static_cast<int>(std::floor(std::min({y[0], y[1], y[2]}))));
+        triangle.maxX = std::min(static_cast<int>(settings_.width) - 1,
+                                 static_cast<int>(std::ceil(std::max({x[0], x[1], x[2]}))));
+        triangle.maxY = std::min(static_cast<int>(settings_.height) - 1,
+                                 static_cast<int>(std::ceil(std::max({y[0], y[1], y[2]}))));
+        if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY ||
+            std::min({z[0], z[1], z[2]}) > 1.0f) {
+            return;
+        }
+
+        // Edge k is opposite vertex k; edge(a, b, p) = (b.x - a.x)(p.y - a.y) - (b.y - a.y)(p.x - a.x)
+        for (int k = 0; k < 3; ++k) {
+            const int a = (k + 1) % 3;
+            const int b = (k + 2) % 3;
+            triangle.edgeA[k] = y[a] - y[b];
+            triangle.edgeB[k] = x[b] - x[a];
+            triangle.edgeC[k] = -(triangle.edgeA[k] * x[a] + triangle.edgeB[k] * y[a]);
+        }
+        // Depth is affine in screen space after the perspective divide: the edge functions over the area
+        // are the barycentric weights
+        const float inverseArea = 1.0f / area;
+        triangle.depthA = (triangle.edgeA[0] * z[0] + triangle.edgeA[1] * z[1] + triangle.edgeA[2] * z[2]) * inverseArea;
+        triangle.depthB = (triangle.edgeB[0] * z[0] + triangle.edgeB[1] * z[1] + triangle.edgeB[2] * z[2]) * inverseArea;
+        triangle.depthC = (triangle.edgeC[0] * z[0] + triangle.edgeC[1] * z[1] + triangle.edgeC[2] * z[2]) * inverseArea;
+        for (int k = 0; k < 3; ++k) {
+            triangle.edgeC[k] += (std::abs(triangle.edgeA[k]) + std::abs(triangle.edgeB[k])) * kEdgeBias;
+        }
+        triangles_.push_back(triangle);
+    }
+
+    void OcclusionCuller::rasterize() {
+        statistics_.trianglesRasterized = static_cast<uint32_t>(triangles_.size());
+        if (triangles_.empty()) {
+            return;
+        }
+        // Bands own disjoint rows of tiles, so workers never touch the same pixels
+        parallelFor(tilesY_, kMinTileRowsPerBand, [this](std::size_t begin, std::size_t end) {
+            rasterizeBand(static_cast<uint32_t>(begin), static_cast<uint32_t>(end));
+        });
+    }
+
+    void OcclusionCuller::rasterizeBand(uint32_t firstTileRow, uint32_t lastTileRow) {
+        const int bandMinY = static_cast<int>(firstTileRow * kTileSize);
+        const int bandMaxY = static_cast<int>(std::min(settings_.height, lastTileRow * kTileSize)) - 1;
+        const auto lanes = simd::laneIndex();
+        const auto zero = simd::set1(0.0f);
+        const int width = static_cast<int>(simd::kWidth);
+
+        for (const auto& triangle : triangles_) {
+            const int minY = std::max(triangle.minY, bandMinY);
+            const int maxY = std::min(triangle.maxY, bandMaxY);
+            if (minY > maxY) {
+                continue;
+            }
+            const int minX = triangle.minX / width * width;
+
+            const auto edgeA0 = simd::set1(triangle.edgeA[0]);
+            const auto edgeA1 = simd::set1(triangle.edgeA[1]);
+            const auto edgeA2 = simd::set1(triangle.edgeA[2]);
+            const auto depthA = simd::set1(triangle.depthA);
+
+            for (int y = minY; y <= maxY; ++y) {
+                const float pixelY = static_cast<float>(y) + 0.5f;
+                const auto rowEdge0 = simd::set1(triangle.edgeB[0] * pixelY + triangle.edgeC[0]);
+                const auto rowEdge1 = simd::set1(triangle.edgeB[1] * pixelY + triangle.edgeC[1]);
+                const auto rowEdge2 = simd::set1(triangle.edgeB[2] * pixelY + triangle.edgeC[2]);
+                const auto rowDepth = simd::set1(triangle.depthB * pixelY + triangle.depthC);
+                float* row = depth_.data() + static_cast<std::size_t>(y) * stride_;
+
+                for (int x = minX; x <= triangle.maxX; x += width) {
+                    const auto pixelX = simd::set1(static_cast<float>(x) + 0.5f) + lanes;
+                    const auto covered = (edgeA0 * pixelX + rowEdge0 >= zero) &
+                                         (edgeA1 * pixelX + rowEdge1 >= zero) &
+                                         (edgeA2 * pixelX + rowEdge2 >= zero);
+                    if (simd::bits(covered) == 0) {
+                        continue;
+                    }
+                    const auto depth = depthA * pixelX + rowDepth;
+                    const auto current = simd::load(row + x);
+                    simd::store(row + x, simd::select(covered, simd::min(current, depth), current));
+                }
+            }
+        }
+
+        // Reduce this band's tiles to their farthest depth
+        for (uint32_t tileY = firstTileRow; tileY < lastTileRow; ++tileY) {
+            const uint32_t rowEnd = std::min(settings_.height, (tileY + 1) * kTileSize);
+            for (uint32_t tileX = 0; tileX < tilesX_; ++tileX) {
+                const uint32_t columnEnd = std::min(settings_.width, (tileX + 1) * kTileSize);
+                float farthest = 0.0f;
+                for (uint32_t y = tileY * kTileSize; y < rowEnd; ++y) {
+                    const float* row = depth_.data() + static_cast<std::size_t>(y) * stride_;
+                    for (uint32_t x = tileX * kTileSize; x < columnEnd; ++x) {
+                        farthest = std::max(farthest, row[x]);
+                    }
+                }
+                tileMaxDepth_[tileY * tilesX_ + tileX] = farthest;
+            }
+        }
+    }
+
+    bool OcclusionCuller::projectBox(const glm::vec3& center, const glm::vec3& extent, ScreenRect& rect) const {
+        rect = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                std::numeric_limits<float>::max()};
+        for (int corner = 0; corner < 8; ++corner) {
+            const glm::vec3 position = center + glm::vec3((corner & 1) ? extent.x : -extent.x,
+                                                          (corner & 2) ? extent.y : -extent.y,
+                                                          (corner & 4) ? extent.z : -extent.z);
+            const glm::vec4 clip = viewProjection_ * glm::vec4(position, 1.0f);
+            if (clip.w < kMinClipW) {
+                return false;
+            }
+            const float x = (clip.x / clip.w * 0.5f + 0.5f) * static_cast<float>(settings_.width);
+            const float y = (clip.y / clip.w * 0.5f + 0.5f) * static_cast<float>(settings_.height);
+            rect.minX = std::min(rect.minX, x);
+            rect.minY = std::min(rect.minY, y);
+            rect.maxX = std::max(rect.maxX, x);
+            rect.maxY = std::max(rect.maxY, y);
+            rect.minDepth = std::min(rect.minDepth, clip.z / clip.w * 0.5f + 0.5f);
+        }
+        rect.minDepth -= kDepthBias;
+        return true;
+    }
+
+    bool OcclusionCuller::isVisible(const glm::vec3& center, const glm::vec3& extent) {
+        ++statistics_.tested;
+        ScreenRect rect{};
+        if (!projectBox(center, extent, rect)) {
+            return true;
+        }
+
+        const int minX = std::max(0, static_cast<int>(std::floor(rect.minX)));
+        const int minY = std::max(0, static_cast<int>(std::floor(rect.minY)));
+        const int maxX = std::min(static_cast<int>(settings_.width) - 1, static_cast<int>(std::floor(rect.maxX)));
+        const int maxY = std::min(static_cast<int>(settings_.height) - 1, static_cast<int>(std::floor(rect.maxY)));
+        if (minX > maxX || minY > maxY) {
+            // Off screen; frustum culling has the final say
+            return true;
+        }
+
+        const int tileSize = static_cast<int>(kTileSize);
+        for (int tileY = minY / tileSize; tileY <= maxY / tileSize; ++tileY) {
+            for (int tileX = minX / tileSize; tileX <= maxX / tileSize; ++tileX) {
+                if (tileMaxDepth_[tileY * tilesX_ + tileX] < rect.minDepth) {
+                    continue; // Every pixel of the tile is nearer than the box
+                }
+                const int y0 = std::max(minY, tileY * tileSize);
+                const int y1 = std::min(maxY, tileY * tileSize + tileSize - 1);
+                const int x0 = std::max(minX, tileX * tileSize);
+                const int x1 = std::min(maxX, tileX * tileSize + tileSize - 1);
+                for (int y = y0; y <= y1; ++y) {
+                    const float* row = depth_.data() + static_cast<std::size_t>(y) * stride_;
+                    for (int x = x0; x <= x1; ++x) {
+                        if (row[x] >= rect.minDepth) {
+                            return true;
+                        }
+                    }
+                }
+            }
+        }
+        ++statistics_.occluded;
+        return false;
+    }
+
+    float OcclusionCuller::getScreenArea(const glm::vec3& center, const glm::vec3& extent) const {
+        ScreenRect rect{};
+        if (!projectBox(center, extent, rect)) {
+            return 1.0f;
+        }
+        const auto width = static_cast<float>(settings_.width);
+        const auto height = static_cast<float>(settings_.height);
+        const float coveredWidth = std::clamp(rect.maxX, 0.0f, width) - std::clamp(rect.minX, 0.0f, width);
+        const float coveredHeight = std::clamp(rect.maxY, 0.0f, height) - std::clamp(rect.minY, 0.0f, height);
+        return coveredWidth * coveredHeight / (width * height);
+    }
+
+} // namespace s3Dive
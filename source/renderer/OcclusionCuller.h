@@ -0,0 +1,93 @@
+#ifndef THREEDIVE_OCCLUSIONCULLER_H
+#define THREEDIVE_OCCLUSIONCULLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace s3Dive {
+
+    // Object-space triangles rasterized as an occluder; kept on the CPU next to the GPU copy of the mesh
+    struct OccluderMesh {
+        std::vector<glm::vec3> positions;
+        std::vector<uint32_t> indices;
+    };
+
+    struct OcclusionSettings {
+        uint32_t width = 320;  // Depth buffer resolution; independent of the window
+        uint32_t height = 192;
+        uint32_t maxOccluders = 64;
+        float minOccluderScreenArea = 0.02f; // Fraction of the screen an occluder's bounds must cover
+    };
+
+    // Software occlusion culling. Large occluders are rasterized into a low-resolution depth buffer by a SIMD
+    // rasterizer that evaluates the edge functions of simd::kWidth pixels at once and writes depth through
+    // the resulting coverage mask. Bands of tile rows are rasterized in parallel, and each band reduces its
+    // tiles to a farthest-depth value (the hierarchical level). Boxes are then tested against the tiles and,
+    // only where a tile is not conclusive, against its pixels. Pure CPU code, so it runs headless.
+    class OcclusionCuller {
+    public:
+        struct Statistics {
+            uint32_t occluders = 0;
+            uint32_t trianglesRasterized = 0; // After near-plane and degenerate rejection
+            uint32_t tested = 0;
+            uint32_t occluded = 0;
+        };
+
+        static constexpr uint32_t kTileSize = 8; // Pixels per side of a hierarchical depth tile
+
+        explicit OcclusionCuller(const OcclusionSettings& settings = {});
+
+        // Clears the depth buffer and the queued occluders
+        void beginFrame(const glm::mat4& viewProjection);
+        void addOccluder(const OccluderMesh& mesh, const glm::mat4& transform);
+        // Rasterizes the queued occluders; boxes can be tested afterwards
+        void rasterize();
+
+        // False only when every pixel the world-space box covers holds a nearer occluder. Boxes crossing
+        // the near plane are always visible.
+        [[nodiscard]] bool isVisible(const glm::vec3& center, const glm::vec3& extent);
+        // Fraction of the screen covered by the box's projected rectangle, 1 when it crosses the near plane
+        [[nodiscard]] float getScreenArea(const glm::vec3& center, const glm::vec3& extent) const;
+
+        // Normalized depth in [0, 1] of the nearest occluder at a pixel; 1 where nothing was drawn
+        [[nodiscard]] float getDepth(uint32_t x, uint32_t y) const { return depth_[y * stride_ + x]; }
+        [[nodiscard]] uint32_t getWidth() const noexcept { return settings_.width; }
+        [[nodiscard]] uint32_t getHeight() const noexcept { return settings_.height; }
+        [[nodiscard]] const OcclusionSettings& getSettings() const noexcept { return settings_; }
+        [[nodiscard]] const Statistics& getStatistics() const noexcept { return statistics_; }
+
+    private:
+        struct ScreenRect {
+            float minX, minY, maxX, maxY;
+            float minDepth;
+        };
+
+        // Edge functions and depth as planes a * x + b * y + c over pixel centres
+        struct Triangle {
+            float edgeA[3], edgeB[3], edgeC[3];
+            float depthA, depthB, depthC;
+            int minX, minY, maxX, maxY; // Clamped pixel bounds
+        };
+
+        // False when a corner is at or behind the eye, in which case the rectangle is meaningless
+        [[nodiscard]] bool projectBox(const glm::vec3& center, const glm::vec3& extent, ScreenRect& rect) const;
+        void setupTriangle(const glm::vec4& v0, const glm::vec4& v1, const glm::vec4& v2);
+        void rasterizeBand(uint32_t firstTileRow, uint32_t lastTileRow);
+
+        OcclusionSettings settings_;
+        uint32_t stride_;      // Width padded to whole SIMD vectors
+        uint32_t tilesX_;
+        uint32_t tilesY_;
+        glm::mat4 viewProjection_{1.0f};
+        std::vector<float> depth_;
+        std::vector<float> tileMaxDepth_; // Farthest depth in each tile
+        std::vector<Triangle> triangles_;
+        std::vector<glm::vec4> clipPositions_; // Scratch for addOccluder
+        Statistics statistics_;
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_OCCLUSIONCULLER_H
@@ -40,11 +40,28 @@ namespace s3Dive {
         getRenderer().drawIndexed(vao, indexCount);
     }
 
+    void RenderCommand::drawIndexedInstanced(const GLVertexArray& vao, GLsizei instanceCount) noexcept {
+        getRenderer().drawIndexedInstanced(vao, instanceCount);
+    }
+
      void RenderCommand::drawLines(const GLVertexArray& vao, GLsizei indexCount) noexcept {
         vao.bind();
         getRenderer().drawLines(indexCount);
     }
 
+    void RenderCommand::drawIndexedInstancedBaseVertex(GLenum indexType, GLuint indexCount, GLuint firstIndex,
+                                                       GLsizei instanceCount, GLint baseVertex) noexcept {
+        getRenderer().drawIndexedInstancedBaseVertex(indexType, indexCount, firstIndex, instanceCount, baseVertex);
+    }
+
+    void RenderCommand::multiDrawIndexedIndirect(GLenum indexType, GLintptr offset, GLsizei drawCount) noexcept {
+        getRenderer().multiDrawIndexedIndirect(indexType, offset, drawCount);
+    }
+
+    bool RenderCommand::supportsMultiDrawIndirect() noexcept {
+        return GLAD_GL_ARB_multi_draw_indirect && GLAD_GL_ARB_base_instance;
+    }
+
     GLRenderer &RenderCommand::getRenderer() noexcept {
         static const auto rendererApi = MakeUnique<GLRenderer>();
         return *rendererApi;
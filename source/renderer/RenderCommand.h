@@ -29,8 +29,17 @@ namespace s3Dive {
         static void setLineWidth(float width) noexcept;
 
         static void drawIndexed(const GLVertexArray& vao,GLuint indexCount) noexcept;
+        // Unlike the other draws this does not bind vao, so the render queue can skip redundant binds
+        static void drawIndexedInstanced(const GLVertexArray& vao, GLsizei instanceCount) noexcept;
         static void drawLines(const GLVertexArray& vao, GLsizei indexCount) noexcept;
 
+        // Geometry arena draws: the arena's vertex array must be bound, and for the indirect form the command buffer too
+        static void drawIndexedInstancedBaseVertex(GLenum indexType, GLuint indexCount, GLuint firstIndex,
+                                                   GLsizei instanceCount, GLint baseVertex) noexcept;
+        static void multiDrawIndexedIndirect(GLenum indexType, GLintptr offset, GLsizei drawCount) noexcept;
+        // glMultiDrawElementsIndirect with a usable baseInstance (GL 4.3, or the ARB extensions on older contexts)
+        [[nodiscard]] static bool supportsMultiDrawIndirect() noexcept;
+
     private:
         [[nodiscard]] static GLRenderer& getRenderer() noexcept;
     };
@@ -0,0 +1,92 @@
+#include "RenderQueue.h"
+#include <array>
+#include <cstring>
+
+namespace s3Dive {
+
+    namespace {
+
+        constexpr uint64_t mask(unsigned bits) noexcept {
+            return (uint64_t{1} << bits) - 1;
+        }
+
+        // Non-negative IEEE floats compare like their bit patterns, so the top bits below the sign make
+        // an order-preserving depth without knowing the far plane
+        uint64_t quantizeDepth(float depth) noexcept {
+            if (!(depth > 0.0f)) {
+                return 0;
+            }
+            uint32_t bits;
+            std::memcpy(&bits, &depth, sizeof(bits));
+            return bits >> (31 - RenderQueue::kDepthBits);
+        }
+
+    } // namespace
+
+    uint64_t RenderQueue::makeKey(RenderPass pass, uint32_t shaderId, uint32_t materialId,
+                                  uint32_t geometryPool, uint32_t geometryId, float viewDepth) noexcept {
+        uint64_t depth = quantizeDepth(viewDepth);
+        uint64_t geometry = (static_cast<uint64_t>(geometryPool) & mask(kGeometryPoolBits))
+                                    << (kGeometryBits - kGeometryPoolBits) |
+                            (geometryId & mask(kGeometryBits - kGeometryPoolBits));
+        if (pass == RenderPass::Transparent) {
+            depth = mask(kDepthBits) - depth;
+            geometry = 0;
+        }
+
+        uint64_t key = static_cast<uint64_t>(pass) & mask(kPassBits);
+        key = (key << kShaderBits) | (shaderId & mask(kShaderBits));
+        key = (key << kMaterialBits) | (materialId & mask(kMaterialBits));
+        key = (key << kGeometryBits) | geometry;
+        key = (key << kDepthBits) | depth;
+        return key;
+    }
+
+    void RenderQueue::sort() {
+        const std::size_t count = items_.size();
+        if (count < 2) {
+            return;
+        }
+
+        entries_.resize(count);
+        scratch_.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            entries_[i] = {items_[i].key, static_cast<uint32_t>(i)};
+        }
+
+        // All eight digit histograms in one sweep over the keys
+        std::array<std::array<uint32_t, 256>, 8> histograms{};
+        for (const auto& entry : entries_) {
+            for (unsigned digit = 0; digit < 8; ++digit) {
+                ++histograms[digit][(entry.key >> (digit * 8)) & 0xFF];
+            }
+        }
+
+        for (unsigned digit = 0; digit < 8; ++digit) {
+            auto& histogram = histograms[digit];
+            const auto firstByte = (entries_[0].key >> (digit * 8)) & 0xFF;
+            if (histogram[firstByte] == count) {
+                continue;
+            }
+
+            uint32_t offset = 0;
+            for (auto& bucket : histogram) {
+                const uint32_t bucketCount = bucket;
+                bucket = offset;
+                offset += bucketCount;
+            }
+            for (const auto& entry : entries_) {
+                scratch_[histogram[(entry.key >> (digit * 8)) & 0xFF]++] = entry;
+            }
+            entries_.swap(scratch_);
+        }
+
+        sortedItems_.clear();
+        sortedItems_.reserve(count);
+        for (const auto& entry : entries_) {
+            sortedItems_.push_back(items_[entry.index]);
+        }
+        items_.swap(sortedItems_);
+    }
+
+} // namespace s3Dive
@@ -0,0 +1,76 @@
+#ifndef THREEDIVE_RENDERQUEUE_H
+#define THREEDIVE_RENDERQUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../platform/openGLRender/gl_shader_program.h"
+#include "../scene/components.h"
+
+namespace s3Dive {
+
+    enum class RenderPass : uint8_t {
+        Opaque = 0,      // Front to back
+        Transparent = 1, // Back to front
+        Overlay = 2
+    };
+
+    struct DrawItem {
+        uint64_t key = 0;
+        GLShaderProgram* shader = nullptr;
+        const MeshAsset* mesh = nullptr;
+        const MaterialComponent* material = nullptr;
+        glm::mat4 transform{1.0f};
+        glm::mat3 normalMatrix{1.0f};
+    };
+
+    // Draw items for one frame, ordered by a packed 64-bit key so that executing them in order changes
+    // the most expensive state least often. From the most significant bit down:
+    //
+    //   | pass: 2 | shader: 8 | material: 16 | geometry: 20 | depth: 18 |
+    //
+    // Geometry is the arena pool in the high bits and the mesh's allocation below, so within a material the
+    // draws of one mesh are adjacent and become a single instanced command; the pool's vertex array alone
+    // would interleave meshes by depth. Transparent items leave it zero to stay strictly back to front. The
+    // id fields are truncated; a collision only costs sort quality, never correctness, because execution
+    // compares the actual objects before skipping a bind or merging draws.
+    class RenderQueue {
+    public:
+        static constexpr unsigned kPassBits = 2;
+        static constexpr unsigned kShaderBits = 8;
+        static constexpr unsigned kMaterialBits = 16;
+        static constexpr unsigned kGeometryBits = 20;
+        static constexpr unsigned kGeometryPoolBits = 4; // Top of the geometry field
+        static constexpr unsigned kDepthBits = 18;
+        static_assert(kPassBits + kShaderBits + kMaterialBits + kGeometryBits + kDepthBits == 64);
+
+        // viewDepth is the distance along the view direction; transparent items get it inverted so they sort back to front
+        [[nodiscard]] static uint64_t makeKey(RenderPass pass, uint32_t shaderId, uint32_t materialId,
+                                              uint32_t geometryPool, uint32_t geometryId, float viewDepth) noexcept;
+
+        void push(const DrawItem& item) { items_.push_back(item); }
+        void clear() noexcept { items_.clear(); }
+
+        // Stable LSD radix sort on the keys, 8 bits per pass; passes where every key shares the digit are skipped
+        void sort();
+
+        [[nodiscard]] const std::vector<DrawItem>& getItems() const noexcept { return items_; }
+        [[nodiscard]] std::size_t size() const noexcept { return items_.size(); }
+        [[nodiscard]] bool empty() const noexcept { return items_.empty(); }
+
+    private:
+        struct SortEntry {
+            uint64_t key;
+            uint32_t index;
+        };
+
+        std::vector<DrawItem> items_;
+        std::vector<DrawItem> sortedItems_;
+        std::vector<SortEntry> entries_;
+        std::vector<SortEntry> scratch_;
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_RENDERQUEUE_H
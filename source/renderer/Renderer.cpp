@@ -3,29 +3,283 @@
 //
 
 #include "Renderer.h"
+#include "../core/hash.h"
+#include "../platform/openGLRender/gl_indirect_buffer.h"
+#include "../platform/openGLRender/gl_state_cache.h"
+#include <vector>
 
 namespace s3Dive {
 
+    namespace {
+
+        constexpr UniformName kOctahedralNormals{"octahedralNormals"};
+
+        // GL name of the diffuse texture, 0 for none; equal for textures sharing one image's storage
+        GLuint textureId(const MaterialComponent& material) {
+            return material.diffuseTexture ? material.diffuseTexture->getRendererID() : 0;
+        }
+
+        // Matches the per-instance attributes of simple-shader.vs.glsl
+        struct InstanceData {
+            glm::mat4 transform;
+            glm::mat3 normalMatrix;
+            glm::vec4 positionScale;
+            glm::vec4 positionOffset;
+        };
+
+        // Items [firstItem, ...) drawn with commands [firstCommand, firstCommand + commandCount)
+        struct Bucket {
+            std::size_t firstItem;
+            std::size_t firstCommand;
+            std::size_t commandCount;
+        };
+
+        struct SceneData {
+            glm::mat4 view{1.0f};
+            RenderQueue queue;
+            std::vector<InstanceData> instances;
+            std::vector<Bucket> buckets;
+            std::vector<DrawElementsIndirectCommand> commands;
+            // Created on first use, once a GL context exists
+            std::unique_ptr<GLVertexBuffer> instanceBuffer;
+            std::unique_ptr<GLIndirectBuffer> indirectBuffer;
+            std::unique_ptr<FrameUniformBlock> frameUniforms;
+            std::unique_ptr<MaterialUniformBlock> defaultMaterialUniforms; // For materials without their own block
+            Renderer::Statistics statistics;
+        };
+
+        SceneData& getSceneData() {
+            static SceneData data;
+            return data;
+        }
+
+    } // namespace
 
     void Renderer::init() {
         RenderCommand::init();
     }
 
-    void Renderer::beginScene() {
+    void Renderer::beginScene(const Camera& camera, const SceneLighting& lighting) {
+        auto& data = getSceneData();
+        data.view = camera.getViewMatrix();
+        data.queue.clear();
+        data.statistics = {};
+        GLStateCache::instance().resetStatistics();
+
+        FrameUniforms frame;
+        frame.view = data.view;
+        frame.projection = camera.getProjectionMatrix();
+        frame.viewProjection = frame.projection * frame.view;
+        frame.viewPosition = glm::vec3(glm::inverse(data.view)[3]);
+        frame.ambientStrength = lighting.ambientStrength;
+        frame.lightColor = lighting.lightColor;
 
+        // Written and bound once; every program reads it through the same binding point
+        if (!data.frameUniforms) {
+            data.frameUniforms = std::make_unique<FrameUniformBlock>(kFrameUniformBinding);
+        }
+        data.frameUniforms->update(frame);
+        data.frameUniforms->bind();
     }
 
-    void Renderer::endScene() {
+    void Renderer::bindUniformBlocks(const GLShaderProgram& shader) {
+        shader.bindUniformBlock(kFrameUniformBlockName, kFrameUniformBinding);
+        shader.bindUniformBlock(kMaterialUniformBlockName, kMaterialUniformBinding);
+    }
 
+    void Renderer::submit(RenderPass pass, GLShaderProgram& shader, const MeshAsset& mesh,
+                          const MaterialComponent& material, const glm::mat4& transform, const glm::mat3& normalMatrix) {
+        auto& data = getSceneData();
+        const float viewDepth = -(data.view * transform[3]).z;
+        // Texture in the high bits so materials sharing one stay adjacent, uniform block below to keep equal
+        // materials together; MaterialUniformCache gives those one block
+        const auto blockHash = static_cast<uint32_t>(hash::mix64(reinterpret_cast<uintptr_t>(material.uniforms.get())));
+        const uint32_t materialId = (textureId(material) << 6) | (blockHash & 0x3F);
+
+        DrawItem item;
+        item.key = RenderQueue::makeKey(pass, shader.getProgramId(), materialId, mesh.geometry->pool,
+                                        mesh.geometry->id, viewDepth);
+        item.shader = &shader;
+        item.mesh = &mesh;
+        item.material = &material;
+        item.transform = transform;
+        item.normalMatrix = normalMatrix;
+        data.queue.push(item);
+        ++data.statistics.submitted;
     }
 
-    void Renderer::submit(const GLVertexArray& vertexArray) {
-        RenderCommand::drawIndexed( vertexArray, vertexArray.getIndexBuffer()->getCount());
+    void Renderer::endScene() {
+        auto& data = getSceneData();
+        if (!data.queue.empty()) {
+            flushQueue();
+        }
+        const auto& stateStatistics = GLStateCache::instance().getStatistics();
+        data.statistics.stateCallsIssued = stateStatistics.issued;
+        data.statistics.stateCallsElided = stateStatistics.elided;
+    }
+
+    void Renderer::flushQueue() {
+        auto& data = getSceneData();
+        data.queue.sort();
+        const auto& items = data.queue.getItems();
+        auto& statistics = data.statistics;
+
+        // One instance upload per frame, in sorted order, so baseInstance of a command is its first item's index
+        data.instances.clear();
+        for (const auto& item : items) {
+            const auto& quantization = item.mesh->quantization;
+            data.instances.push_back({item.transform,
+                                      item.normalMatrix,
+                                      glm::vec4(quantization.positionScale, 0.0f),
+                                      glm::vec4(quantization.positionOffset, 0.0f)});
+        }
+        if (!data.instanceBuffer) {
+            data.instanceBuffer = std::make_unique<GLVertexBuffer>();
+            GLVertexBufferLayout layout;
+            for (int column = 0; column < 4; ++column) {
+                layout.addVertexElement<float>(4); // Transform
+            }
+            for (int column = 0; column < 3; ++column) {
+                layout.addVertexElement<float>(3); // Normal matrix
+            }
+            layout.addVertexElement<float>(4); // Position scale
+            layout.addVertexElement<float>(4); // Position offset
+            data.instanceBuffer->setLayout(layout);
+        }
+        data.instanceBuffer->setData(data.instances.data(),
+                                     static_cast<GLsizeiptr>(data.instances.size() * sizeof(InstanceData)));
 
+        // Buckets share shader, arena pool and material; consecutive items of one mesh become one command
+        data.buckets.clear();
+        data.commands.clear();
+        for (std::size_t bucketBegin = 0; bucketBegin < items.size();) {
+            Bucket bucket{bucketBegin, data.commands.size(), 0};
+            std::size_t itemIndex = bucketBegin;
+            while (itemIndex < items.size() && canBatch(items[bucketBegin], items[itemIndex])) {
+                const auto& geometry = *items[itemIndex].mesh->geometry;
+                std::size_t runEnd = itemIndex + 1;
+                while (runEnd < items.size() && items[runEnd].mesh == items[itemIndex].mesh &&
+                       canBatch(items[bucketBegin], items[runEnd])) {
+                    ++runEnd;
+                }
+                data.commands.push_back({geometry.indexCount, static_cast<GLuint>(runEnd - itemIndex),
+                                         geometry.firstIndex, geometry.baseVertex,
+                                         static_cast<GLuint>(itemIndex)});
+                itemIndex = runEnd;
+            }
+            bucket.commandCount = data.commands.size() - bucket.firstCommand;
+            data.buckets.push_back(bucket);
+            bucketBegin = itemIndex;
+        }
+        statistics.drawCommands = static_cast<uint32_t>(data.commands.size());
+
+        const bool multiDraw = RenderCommand::supportsMultiDrawIndirect();
+        if (multiDraw) {
+            if (!data.indirectBuffer) {
+                data.indirectBuffer = std::make_unique<GLIndirectBuffer>();
+            }
+            data.indirectBuffer->setData(data.commands);
+        }
+
+        if (!data.defaultMaterialUniforms) {
+            data.defaultMaterialUniforms = std::make_unique<MaterialUniformBlock>(kMaterialUniformBinding,
+                                                                                  MaterialUniforms{});
+        }
+
+        GLShaderProgram* boundShader = nullptr;
+        UniformHandle octahedralNormals;
+        const GLVertexArray* boundVertexArray = nullptr;
+        GLuint boundTexture = 0;
+        const MaterialUniformBlock* boundMaterialUniforms = nullptr;
+
+        for (const auto& bucket : data.buckets) {
+            const auto& item = items[bucket.firstItem];
+            const auto& geometry = *item.mesh->geometry;
+            const auto& material = *item.material;
+
+            const bool shaderChanged = item.shader != boundShader;
+            if (shaderChanged) {
+                boundShader = item.shader;
+                boundShader->use();
+                octahedralNormals = boundShader->getUniformHandle(kOctahedralNormals, false);
+                ++statistics.shaderBinds;
+            }
+
+            const auto* materialUniforms = material.uniforms ? material.uniforms.get()
+                                                             : data.defaultMaterialUniforms.get();
+            if (materialUniforms != boundMaterialUniforms) {
+                boundMaterialUniforms = materialUniforms;
+                boundMaterialUniforms->bind();
+                ++statistics.materialBinds;
+            }
+
+            // By GL name: textures sharing one image's storage bind as one
+            if (material.diffuseTexture && material.diffuseTexture->getRendererID() != boundTexture) {
+                boundTexture = material.diffuseTexture->getRendererID();
+                material.diffuseTexture->bind(0);
+                ++statistics.textureBinds;
+            }
+
+            const bool vertexArrayChanged = geometry.vertexArray != boundVertexArray;
+            if (vertexArrayChanged) {
+                boundVertexArray = geometry.vertexArray;
+                boundVertexArray->bind();
+                ++statistics.vertexArrayBinds;
+                if (multiDraw) {
+                    boundVertexArray->setInstanceAttributes(*data.instanceBuffer, kInstanceAttributeLocation, 0);
+                }
+            }
+            if (shaderChanged || vertexArrayChanged) {
+                boundShader->updateShaderUniform(octahedralNormals,
+                                                 geometry.format == VertexFormat::QuantizedOctahedral);
+            }
+
+            if (multiDraw) {
+                RenderCommand::multiDrawIndexedIndirect(
+                        geometry.indexType,
+                        static_cast<GLintptr>(bucket.firstCommand * sizeof(DrawElementsIndirectCommand)),
+                        static_cast<GLsizei>(bucket.commandCount));
+                ++statistics.drawCalls;
+                continue;
+            }
+
+            // Without base instances each command points the instance attributes at its own slice
+            for (std::size_t i = 0; i < bucket.commandCount; ++i) {
+                const auto& command = data.commands[bucket.firstCommand + i];
+                boundVertexArray->setInstanceAttributes(
+                        *data.instanceBuffer, kInstanceAttributeLocation,
+                        static_cast<GLintptr>(command.baseInstance * sizeof(InstanceData)));
+                RenderCommand::drawIndexedInstancedBaseVertex(geometry.indexType, command.count, command.firstIndex,
+                                                              static_cast<GLsizei>(command.instanceCount),
+                                                              command.baseVertex);
+                ++statistics.drawCalls;
+            }
+        }
+
+        // Program and indirect buffer stay bound so next frame's binds are elided, but a bound vertex array
+        // would pick up the element buffer of the next index buffer created
+        boundVertexArray->unbind();
+        data.queue.clear();
+    }
+
+    const Renderer::Statistics& Renderer::getStatistics() {
+        return getSceneData().statistics;
     }
 
     void Renderer::shutdown() {
+        auto& data = getSceneData();
+        data.queue.clear();
+        data.instanceBuffer.reset();
+        data.indirectBuffer.reset();
+        data.frameUniforms.reset();
+        data.defaultMaterialUniforms.reset();
+    }
 
+    bool Renderer::canBatch(const DrawItem& lhs, const DrawItem& rhs) {
+        return lhs.shader == rhs.shader &&
+               lhs.mesh->geometry->vertexArray == rhs.mesh->geometry->vertexArray &&
+               textureId(*lhs.material) == textureId(*rhs.material) &&
+               lhs.material->uniforms == rhs.material->uniforms;
     }
 
-} // s3Dive
\ No newline at end of file
+} // s3Dive
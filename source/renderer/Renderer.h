@@ -5,25 +5,68 @@
 #ifndef THREEDIVE_RENDERER_H
 #define THREEDIVE_RENDERER_H
 
+#include <cstdint>
 #include <memory>
 
+#include "../camera/camera.h"
 #include "../platform/openGLRender/gl_vertex_array.h"
 #include "RenderCommand.h"
+#include "RenderQueue.h"
+#include "UniformBlocks.h"
 
 namespace s3Dive {
 
+    struct SceneLighting {
+        glm::vec3 lightColor{1.0f};
+        float ambientStrength = 0.7f; // Strong ambient for more uniform lighting
+    };
+
+    // Frame-level entry point for mesh drawing: systems submit between beginScene and endScene, and
+    // endScene sorts the queue, then issues one glMultiDrawElementsIndirect per run of items sharing shader,
+    // geometry arena pool and material, while skipping binds and uniform updates that would not change
+    // anything. Contexts without multi-draw indirect fall back to one instanced draw per mesh in the run.
     class Renderer {
 
     public:
+        struct Statistics {
+            uint32_t submitted = 0;
+            uint32_t drawCalls = 0;
+            uint32_t drawCommands = 0; // Indirect commands, one per run of instances of a mesh
+            uint32_t shaderBinds = 0;
+            uint32_t textureBinds = 0;
+            uint32_t materialBinds = 0;
+            uint32_t vertexArrayBinds = 0;
+            // GLStateCache counters from beginScene to endScene, covering every system that drew in between
+            uint32_t stateCallsIssued = 0;
+            uint32_t stateCallsElided = 0;
+        };
+
+        // Attribute locations 3-11 of simple-shader.vs.glsl hold the per-instance model and normal matrices and
+        // dequantization
+        static constexpr GLuint kInstanceAttributeLocation = 3;
+
         static void init();
 
-        static void beginScene();
+        // Uploads and binds the FrameData uniform block
+        static void beginScene(const Camera& camera, const SceneLighting& lighting = {});
         static void endScene();
 
-        static void submit(const GLVertexArray &vertexArray);
+        static void submit(RenderPass pass, GLShaderProgram& shader, const MeshAsset& mesh,
+                           const MaterialComponent& material, const glm::mat4& transform, const glm::mat3& normalMatrix);
+
+        // Points the program's FrameData and MaterialData blocks at the shared binding points; call after linking
+        static void bindUniformBlocks(const GLShaderProgram& shader);
+
+        // Counters of the last endScene
+        [[nodiscard]] static const Statistics& getStatistics();
 
+        // Releases GL objects; call while the context is still current
         static void shutdown();
 
+    private:
+        // Sorts and draws the submitted items; the queue must not be empty
+        static void flushQueue();
+        [[nodiscard]] static bool canBatch(const DrawItem& lhs, const DrawItem& rhs);
     };
 
 } // s3Dive
@@ -0,0 +1,98 @@
+#include "TextureCache.h"
+#include <filesystem>
+#include <unordered_set>
+#include <spdlog/spdlog.h>
+
+namespace s3Dive {
+
+    TextureCache& TextureCache::instance() {
+        static TextureCache textureCache;
+        return textureCache;
+    }
+
+    std::shared_ptr<GLTexture> TextureCache::load(const std::string& path) {
+        const auto resolvedPath = resolvePath(path);
+
+        if (auto it = texturesByPath_.find(resolvedPath); it != texturesByPath_.end()) {
+            if (auto texture = it->second.lock()) {
+                ++statistics_.hits;
+                return texture;
+            }
+        }
+
+        // The content hash is only known once the streamer has read the file; see update()
+        ++statistics_.misses;
+        static constexpr unsigned char kPlaceholderPixel[4] = {255, 255, 255, 255};
+        auto texture = std::make_shared<GLTexture>(1, 1, kPlaceholderPixel);
+        streamer_.request(texture, resolvedPath);
+        texturesByPath_[resolvedPath] = texture;
+        return texture;
+    }
+
+    void TextureCache::update() {
+        streamer_.update();
+
+        // Same image under a different name: the streamer already pointed this path's texture at the first copy's
+        // storage, and later loads of the path get the first texture itself
+        for (const auto& streamed : streamer_.getStreamedLastFrame()) {
+            auto& byContent = texturesByContent_[streamed.contentHash];
+            auto existing = byContent.lock();
+            auto texture = streamed.texture.lock();
+            if (existing && texture && existing != texture) {
+                ++statistics_.aliases;
+                texturesByPath_[streamed.path] = existing;
+            } else if (!existing) {
+                byContent = streamed.texture;
+            }
+        }
+    }
+
+    void TextureCache::shutdown() {
+        streamer_.shutdown();
+    }
+
+    std::size_t TextureCache::evictExpired() {
+        streamer_.evictExpired();
+        std::size_t evicted = 0;
+        for (auto it = texturesByPath_.begin(); it != texturesByPath_.end();) {
+            if (it->second.expired()) {
+                it = texturesByPath_.erase(it);
+                ++evicted;
+            } else {
+                ++it;
+            }
+        }
+        for (auto it = texturesByContent_.begin(); it != texturesByContent_.end();) {
+            it = it->second.expired() ? texturesByContent_.erase(it) : std::next(it);
+        }
+        statistics_.evictions += evicted;
+        return evicted;
+    }
+
+    std::size_t TextureCache::getResidentCount() const {
+        // Several paths may alias one texture, count distinct textures
+        std::unordered_set<const GLTexture*> residentTextures;
+        for (const auto& [path, texture] : texturesByPath_) {
+            if (auto residentTexture = texture.lock()) {
+                residentTextures.insert(residentTexture.get());
+            }
+        }
+        return residentTextures.size();
+    }
+
+    void TextureCache::logStatistics() const {
+        spdlog::info("Texture cache: {} hits, {} misses, {} aliases, {} evictions, {} resident, {} streaming",
+                     statistics_.hits, statistics_.misses, statistics_.aliases, statistics_.evictions,
+                     getResidentCount(), streamer_.getPendingCount());
+    }
+
+    std::string TextureCache::resolvePath(const std::string& path) {
+        std::error_code error;
+        auto resolved = std::filesystem::weakly_canonical(path, error);
+        if (error) {
+            return std::filesystem::path(path).lexically_normal().string();
+        }
+        return resolved.string();
+    }
+
+} // namespace s3Dive
@@ -0,0 +1,62 @@
+#ifndef THREEDIVE_TEXTURECACHE_H
+#define THREEDIVE_TEXTURECACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include "../platform/openGLRender/gl_texture.h"
+#include "TextureStreamer.h"
+
+namespace s3Dive {
+
+    // Hands out shared GLTexture handles keyed by resolved path and file content hash, so a texture
+    // referenced by many materials (or copied under several names) is decoded and uploaded once.
+    // The cache only holds weak references: a texture is freed as soon as the last material drops it.
+    // Reading, hashing and decoding happen on the streamer's worker threads. A name whose content turns out
+    // to be streamed already is neither decoded nor uploaded again: its texture shares the first copy's GPU
+    // storage, and later loads of the name return the first texture.
+    // Must be used from the GL thread.
+    class TextureCache {
+    public:
+        struct Statistics {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t aliases = 0; // Paths redirected to a texture with the same content
+            uint64_t evictions = 0;
+        };
+
+        TextureCache() = default;
+        ~TextureCache() = default;
+
+        TextureCache(const TextureCache&) = delete;
+        TextureCache& operator=(const TextureCache&) = delete;
+
+        [[nodiscard]] static TextureCache& instance();
+
+        // Returns immediately; on a miss the texture is a 1x1 placeholder until the streamer delivers its pixels
+        [[nodiscard]] std::shared_ptr<GLTexture> load(const std::string& path);
+
+        // Streams decoded textures to the GPU within the per-frame budget; call once per frame on the GL thread
+        void update();
+        void shutdown();
+
+        // Drops entries whose texture is no longer referenced anywhere; returns how many were evicted
+        std::size_t evictExpired();
+
+        [[nodiscard]] std::size_t getResidentCount() const;
+        [[nodiscard]] const Statistics& getStatistics() const noexcept { return statistics_; }
+        void logStatistics() const;
+
+    private:
+        [[nodiscard]] static std::string resolvePath(const std::string& path);
+
+        std::unordered_map<std::string, std::weak_ptr<GLTexture>> texturesByPath_;
+        std::unordered_map<uint64_t, std::weak_ptr<GLTexture>> texturesByContent_;
+        Statistics statistics_;
+        TextureStreamer streamer_;
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_TEXTURECACHE_H
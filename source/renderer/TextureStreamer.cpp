@@ -0,0 +1,207 @@
+#include "TextureStreamer.h"
+#include <climits>
+#include <cstring>
+#include <iterator>
+#include <spdlog/spdlog.h>
+#include <stb_image.h>
+#include "../core/hash.h"
+#include "../core/mapped_file.h"
+#include "../platform/openGLRender/gl_state_cache.h"
+
+namespace s3Dive {
+
+    TextureStreamer::TextureStreamer(const TextureStreamerSettings& settings)
+            : settings_(settings), decodePool_(std::make_unique<ThreadPool>(settings.decodeThreads)) {}
+
+    TextureStreamer::~TextureStreamer() {
+        // Pixel buffers are left to shutdown(); the GL context may already be gone here
+        decodePool_.reset();
+    }
+
+    void TextureStreamer::request(const std::shared_ptr<GLTexture>& texture, const std::string& path) {
+        if (!decodePool_) {
+            spdlog::error("Texture streamer is shut down, cannot load: {}", path);
+            return;
+        }
+
+        {
+            std::lock_guard lock(decodedMutex_);
+            ++inFlightDecodes_;
+        }
+        std::weak_ptr<GLTexture> weakTexture = texture;
+        decodePool_->submit([this, weakTexture, path] { decode(weakTexture, path); });
+    }
+
+    void TextureStreamer::decode(const std::weak_ptr<GLTexture>& texture, const std::string& path) {
+        DecodedImage image;
+        image.texture = texture;
+        image.path = path;
+
+        // Skip the decode entirely if every material using the texture is already gone
+        if (!texture.expired()) {
+            int channels = 0;
+            stbi_set_flip_vertically_on_load_thread(1);
+            // Hashed and decoded from one mapping, so the file is read once and never on the GL thread
+            MappedFile file(path);
+            if (file.isOpen() && file.size() <= static_cast<std::size_t>(INT_MAX)) {
+                image.contentHash = hash::fnv1a64(file.data(), file.size());
+                image.storageOwner = claimContent(*image.contentHash, texture);
+                // A texture sharing the claimant's storage gets its pixels from the claimant's own decode
+                if (!image.storageOwner.expired()) {
+                    image.sharesStorage = true;
+                } else {
+                    image.pixels = {stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(file.data()),
+                                                          static_cast<int>(file.size()), &image.width,
+                                                          &image.height, &channels, 4),
+                                    stbi_image_free};
+                }
+            } else {
+                image.pixels = {stbi_load(path.c_str(), &image.width, &image.height, &channels, 4), stbi_image_free};
+            }
+        }
+
+        std::lock_guard lock(decodedMutex_);
+        --inFlightDecodes_;
+        decodedImages_.push_back(std::move(image));
+    }
+
+    std::weak_ptr<GLTexture> TextureStreamer::claimContent(uint64_t contentHash, const std::weak_ptr<GLTexture>& texture) {
+        // Weak pointers are only compared and tested here: locking one could drop a texture's last
+        // reference, and with it the GL object, on a worker
+        std::lock_guard lock(decodedMutex_);
+        auto& claim = contentClaims_[contentHash];
+        const bool isClaimant = !claim.owner_before(texture) && !texture.owner_before(claim);
+        if (claim.expired()) {
+            claim = texture;
+            return {};
+        }
+        return isClaimant ? std::weak_ptr<GLTexture>{} : claim;
+    }
+
+    void TextureStreamer::update() {
+        std::size_t budget = settings_.uploadBudgetBytes;
+        uploadedBytesLastFrame_ = 0;
+        streamedLastFrame_.clear();
+
+        while (true) {
+            DecodedImage image;
+            {
+                std::lock_guard lock(decodedMutex_);
+                if (decodedImages_.empty()) {
+                    break;
+                }
+
+                const auto& next = decodedImages_.front();
+                const auto byteSize = static_cast<std::size_t>(next.width) * static_cast<std::size_t>(next.height) * 4;
+                // Always make progress, even when a single image is larger than the whole budget
+                if (next.pixels && byteSize > budget && uploadedBytesLastFrame_ > 0) {
+                    break;
+                }
+
+                image = std::move(decodedImages_.front());
+                decodedImages_.pop_front();
+            }
+
+            if (image.sharesStorage) {
+                shareStorage(image);
+                continue;
+            }
+            if (!image.pixels) {
+                if (!image.texture.expired()) {
+                    spdlog::error("Failed to load texture: {}", image.path);
+                }
+                continue;
+            }
+
+            const auto byteSize = static_cast<std::size_t>(image.width) * static_cast<std::size_t>(image.height) * 4;
+            if (!image.texture.expired()) {
+                upload(image, byteSize);
+                uploadedBytesLastFrame_ += byteSize;
+                budget = byteSize < budget ? budget - byteSize : 0;
+                if (image.contentHash) {
+                    streamedLastFrame_.push_back({image.texture, std::move(image.path), *image.contentHash});
+                }
+            }
+        }
+    }
+
+    void TextureStreamer::shareStorage(DecodedImage& image) {
+        auto texture = image.texture.lock();
+        if (!texture) {
+            return;
+        }
+        auto owner = image.storageOwner.lock();
+        if (!owner) {
+            // The claimant went away after the worker saw it; decode this one after all
+            request(texture, image.path);
+            return;
+        }
+        // Samples the claimant's texture object, so it shows its pixels whenever they arrive
+        texture->shareStorage(std::move(owner));
+        streamedLastFrame_.push_back({image.texture, std::move(image.path), *image.contentHash, true});
+    }
+
+    void TextureStreamer::upload(const DecodedImage& image, std::size_t byteSize) {
+        auto texture = image.texture.lock();
+        if (!texture) {
+            return;
+        }
+
+        if (pixelBuffers_[0] == 0) {
+            glGenBuffers(static_cast<GLsizei>(pixelBuffers_.size()), pixelBuffers_.data());
+        }
+
+        const GLuint pixelBuffer = pixelBuffers_[nextPixelBuffer_];
+        nextPixelBuffer_ = (nextPixelBuffer_ + 1) % pixelBuffers_.size();
+
+        auto& state = GLStateCache::instance();
+        state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+        // Orphan the previous storage so we never wait on a transfer still reading from this buffer
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(byteSize), nullptr, GL_STREAM_DRAW);
+
+        void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(byteSize),
+                                        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (mapped) {
+            std::memcpy(mapped, image.pixels.get(), byteSize);
+            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            texture->setData(image.width, image.height, nullptr);
+        } else {
+            spdlog::warn("Failed to map pixel buffer, uploading {} directly", image.path);
+            state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            texture->setData(image.width, image.height, image.pixels.get());
+        }
+
+        state.bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+
+    void TextureStreamer::shutdown() {
+        decodePool_.reset();
+        {
+            std::lock_guard lock(decodedMutex_);
+            decodedImages_.clear();
+            inFlightDecodes_ = 0;
+            contentClaims_.clear();
+        }
+
+        if (pixelBuffers_[0] != 0) {
+            for (GLuint pixelBuffer : pixelBuffers_) {
+                GLStateCache::instance().onBufferDeleted(pixelBuffer);
+            }
+            glDeleteBuffers(static_cast<GLsizei>(pixelBuffers_.size()), pixelBuffers_.data());
+            pixelBuffers_.fill(0);
+        }
+    }
+
+    void TextureStreamer::evictExpired() {
+        std::lock_guard lock(decodedMutex_);
+        for (auto it = contentClaims_.begin(); it != contentClaims_.end();) {
+            it = it->second.expired() ? contentClaims_.erase(it) : std::next(it);
+        }
+    }
+
+    std::size_t TextureStreamer::getPendingCount() const {
+        std::lock_guard lock(decodedMutex_);
+        return inFlightDecodes_ + decodedImages_.size();
+    }
+
+} // namespace s3Dive
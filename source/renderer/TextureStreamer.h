@@ -0,0 +1,98 @@
+#ifndef THREEDIVE_TEXTURESTREAMER_H
+#define THREEDIVE_TEXTURESTREAMER_H
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <glad/glad.h>
+#include "../core/thread_pool.h"
+#include "../platform/openGLRender/gl_texture.h"
+
+namespace s3Dive {
+
+    struct TextureStreamerSettings {
+        std::size_t uploadBudgetBytes = 8u * 1024u * 1024u;
+        // Kept off the JobSystem like model imports: a decode picked up by a frame's TaskGroup::wait would stall it
+        std::size_t decodeThreads = 2;
+    };
+
+    // Decodes image files on worker threads and streams the pixels into existing GLTextures through a
+    // ring of pixel buffer objects, spending at most uploadBudgetBytes per update(). A streamed texture
+    // keeps whatever it held before (usually a 1x1 placeholder) until its data arrives. The workers also
+    // hash each file's content: the first texture requested with some content claims it, and any other
+    // texture requested with the same bytes skips the decode and shares the claimant's GPU storage instead
+    // of uploading a copy.
+    class TextureStreamer {
+    public:
+        struct StreamedTexture {
+            std::weak_ptr<GLTexture> texture;
+            std::string path;
+            uint64_t contentHash = 0; // FNV-1a of the file's bytes
+            bool sharesStorage = false; // Shown through the texture first streamed with this content
+        };
+
+        explicit TextureStreamer(const TextureStreamerSettings& settings = TextureStreamerSettings{});
+        ~TextureStreamer();
+
+        TextureStreamer(const TextureStreamer&) = delete;
+        TextureStreamer& operator=(const TextureStreamer&) = delete;
+
+        void request(const std::shared_ptr<GLTexture>& texture, const std::string& path);
+
+        // Uploads decoded images within the frame budget; must run on the GL thread
+        void update();
+
+        // Stops the decoders and frees the pixel buffers; call while the GL context is still current
+        void shutdown();
+
+        [[nodiscard]] std::size_t getPendingCount() const;
+        [[nodiscard]] std::size_t getUploadedBytesLastFrame() const noexcept { return uploadedBytesLastFrame_; }
+        // Drops content claims of textures that no longer exist
+        void evictExpired();
+
+        // Textures whose data the last update() uploaded or shared
+        [[nodiscard]] const std::vector<StreamedTexture>& getStreamedLastFrame() const noexcept { return streamedLastFrame_; }
+
+    private:
+        struct DecodedImage {
+            std::weak_ptr<GLTexture> texture;
+            std::string path;
+            int width = 0;
+            int height = 0;
+            std::optional<uint64_t> contentHash; // Unset when the file could not be mapped
+            std::weak_ptr<GLTexture> storageOwner; // The claimant, when the content was claimed already
+            bool sharesStorage = false;            // Then there are no pixels; update() shares the claimant's
+            std::unique_ptr<unsigned char, void (*)(void*)> pixels{nullptr, nullptr};
+        };
+
+        static constexpr std::size_t kPixelBufferCount = 3;
+
+        void decode(const std::weak_ptr<GLTexture>& texture, const std::string& path);
+        // Claims contentHash for texture when nothing live holds it; otherwise returns the claimant
+        std::weak_ptr<GLTexture> claimContent(uint64_t contentHash, const std::weak_ptr<GLTexture>& texture);
+        void upload(const DecodedImage& image, std::size_t byteSize);
+        void shareStorage(DecodedImage& image);
+
+        TextureStreamerSettings settings_;
+        std::array<GLuint, kPixelBufferCount> pixelBuffers_{};
+        std::size_t nextPixelBuffer_ = 0;
+        std::size_t uploadedBytesLastFrame_ = 0;
+        std::vector<StreamedTexture> streamedLastFrame_;
+
+        mutable std::mutex decodedMutex_;
+        std::deque<DecodedImage> decodedImages_;
+        std::size_t inFlightDecodes_ = 0;
+        std::unordered_map<uint64_t, std::weak_ptr<GLTexture>> contentClaims_; // First texture per content hash
+
+        std::unique_ptr<ThreadPool> decodePool_;
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_TEXTURESTREAMER_H
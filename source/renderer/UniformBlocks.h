@@ -0,0 +1,60 @@
+#ifndef THREEDIVE_UNIFORMBLOCKS_H
+#define THREEDIVE_UNIFORMBLOCKS_H
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "../platform/openGLRender/gl_uniform_block.h"
+
+namespace s3Dive {
+
+    // Binding points shared by every program; GLSL 330 cannot declare them, so Renderer::bindUniformBlocks
+    // assigns them by block name after linking
+    inline constexpr uint32_t kFrameUniformBinding = 0;
+    inline constexpr uint32_t kMaterialUniformBinding = 1;
+
+    inline constexpr const char* kFrameUniformBlockName = "FrameData";
+    inline constexpr const char* kMaterialUniformBlockName = "MaterialData";
+
+    // layout (std140) uniform FrameData: written once per frame by Renderer::beginScene
+    struct FrameUniforms {
+        glm::mat4 view{1.0f};
+        glm::mat4 projection{1.0f};
+        glm::mat4 viewProjection{1.0f};
+        glm::vec3 viewPosition{0.0f};
+        float ambientStrength = 0.7f;
+        glm::vec3 lightColor{1.0f};
+    };
+
+    using FrameUniformLayout = std140::Layout<&FrameUniforms::view,
+                                              &FrameUniforms::projection,
+                                              &FrameUniforms::viewProjection,
+                                              &FrameUniforms::viewPosition,
+                                              &FrameUniforms::ambientStrength,
+                                              &FrameUniforms::lightColor>;
+    using FrameUniformBlock = GLUniformBlock<FrameUniformLayout>;
+
+    static_assert(FrameUniformLayout::kOffsets[3] == 192 && FrameUniformLayout::kOffsets[4] == 204 &&
+                  FrameUniformLayout::kOffsets[5] == 208 && FrameUniformLayout::kSize == 224,
+                  "FrameUniforms no longer matches FrameData in the shaders");
+
+    // layout (std140) uniform MaterialData: one buffer per material, written when the material is created
+    struct MaterialUniforms {
+        glm::vec3 albedo{0.435f, 0.435f, 0.435f};
+        float metallic = 0.1f;
+        float roughness = 0.5f;
+        float ao = 1.0f;
+    };
+
+    using MaterialUniformLayout = std140::Layout<&MaterialUniforms::albedo,
+                                                 &MaterialUniforms::metallic,
+                                                 &MaterialUniforms::roughness,
+                                                 &MaterialUniforms::ao>;
+    using MaterialUniformBlock = GLUniformBlock<MaterialUniformLayout>;
+
+    static_assert(MaterialUniformLayout::kOffsets[1] == 12 && MaterialUniformLayout::kOffsets[3] == 20 &&
+                  MaterialUniformLayout::kSize == 32,
+                  "MaterialUniforms no longer matches MaterialData in the shaders");
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_UNIFORMBLOCKS_H
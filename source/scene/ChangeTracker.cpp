@@ -0,0 +1,42 @@
+#include "ChangeTracker.h"
+#include <algorithm>
+
+namespace s3Dive {
+
+    void ChangeSet::clear() noexcept {
+        if (entities_.empty()) {
+            return;
+        }
+        // Clearing the index costs its capacity, which a single large batch (an import) would leave behind for
+        // good. An index much larger than this batch needed is dropped instead, so a set costs what changed.
+        if (indices_.capacity() > std::max<std::size_t>(8 * entities_.size(), kRetainedIndexCapacity)) {
+            indices_ = {};
+        } else {
+            indices_.clear();
+        }
+        entities_.clear();
+    }
+
+    void ChangeSet::record(entt::entity entity) {
+        if (!indices_.contains(entity)) {
+            indices_.insertOrAssign(entity, static_cast<uint32_t>(entities_.size()));
+            entities_.push_back(entity);
+        }
+    }
+
+    ChangeTracker::~ChangeTracker() {
+        for (auto& [type, channel] : channels_) {
+            channel->disconnect();
+        }
+    }
+
+    void ChangeTracker::unsubscribe(ChangeSet& changes) {
+        for (auto& [type, channel] : channels_) {
+            auto& subscribers = channel->subscribers;
+            subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+                                             [&changes](const auto& subscriber) { return subscriber.get() == &changes; }),
+                              subscribers.end());
+        }
+    }
+
+} // namespace s3Dive
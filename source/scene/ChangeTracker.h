@@ -0,0 +1,101 @@
+#ifndef THREEDIVE_CHANGETRACKER_H
+#define THREEDIVE_CHANGETRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+#include <entt/entity/registry.hpp>
+#include "../core/flat_hash_map.h"
+
+namespace s3Dive {
+
+    // Entities whose watched component was constructed, updated or destroyed since the set was last cleared. Each
+    // entity is listed once, in the order it first changed; it may since have lost the component or been destroyed,
+    // so consumers check before use.
+    class ChangeSet {
+    public:
+        [[nodiscard]] const std::vector<entt::entity>& getEntities() const noexcept { return entities_; }
+        [[nodiscard]] bool empty() const noexcept { return entities_.empty(); }
+        [[nodiscard]] bool contains(entt::entity entity) const noexcept { return indices_.contains(entity); }
+
+        // Consumers clear their own set once they have caught up
+        void clear() noexcept;
+
+    private:
+        friend class ChangeTracker;
+
+        // Index capacity always kept across clears; wiping this much is cheaper than growing it back
+        static constexpr std::size_t kRetainedIndexCapacity = 4096;
+
+        void record(entt::entity entity);
+
+        std::vector<entt::entity> entities_;
+        FlatHashMap<entt::entity, uint32_t> indices_; // Position in entities_
+    };
+
+    // Turns the registry's construct, update and destroy signals into per-subscriber change sets, so systems can
+    // work on what changed since their last update instead of on everything. A system subscribes to a component
+    // type: WorldTransformComponent for transform changes, MeshComponent for mesh geometry, MaterialComponent for
+    // materials. Only emplace, patch, replace and removal emit signals; code that edits a component through a
+    // reference must follow up with registry.patch<T>(entity) for the change to be seen. Signals fire on the thread
+    // that changes the registry, which the SystemScheduler already limits to one writer per component type.
+    class ChangeTracker {
+    public:
+        explicit ChangeTracker(entt::registry& registry) : registry_(registry) {}
+        ~ChangeTracker();
+
+        ChangeTracker(const ChangeTracker&) = delete;
+        ChangeTracker& operator=(const ChangeTracker&) = delete;
+
+        // A set of its own for the caller, which starts out holding every entity that has the component now so
+        // late subscribers miss nothing. The set lives until unsubscribe or the tracker goes away.
+        template<typename Component>
+        ChangeSet& subscribe();
+        void unsubscribe(ChangeSet& changes);
+
+    private:
+        // Fans one component type's signals out to its subscribers
+        struct Channel {
+            std::vector<std::unique_ptr<ChangeSet>> subscribers;
+            std::function<void()> disconnect;
+
+            void onChanged([[maybe_unused]] entt::registry& registry, entt::entity entity) {
+                for (auto& subscriber : subscribers) {
+                    subscriber->record(entity);
+                }
+            }
+        };
+
+        entt::registry& registry_;
+        std::unordered_map<std::type_index, std::unique_ptr<Channel>> channels_;
+    };
+
+    template<typename Component>
+    ChangeSet& ChangeTracker::subscribe() {
+        auto& channel = channels_[typeid(Component)];
+        if (!channel) {
+            channel = std::make_unique<Channel>();
+            registry_.on_construct<Component>().template connect<&Channel::onChanged>(*channel);
+            registry_.on_update<Component>().template connect<&Channel::onChanged>(*channel);
+            registry_.on_destroy<Component>().template connect<&Channel::onChanged>(*channel);
+            channel->disconnect = [&registry = registry_, instance = channel.get()] {
+                registry.on_construct<Component>().disconnect(instance);
+                registry.on_update<Component>().disconnect(instance);
+                registry.on_destroy<Component>().disconnect(instance);
+            };
+        }
+
+        auto& changes = *channel->subscribers.emplace_back(std::make_unique<ChangeSet>());
+        for (auto entity : registry_.view<Component>()) {
+            changes.record(entity);
+        }
+        return changes;
+    }
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_CHANGETRACKER_H
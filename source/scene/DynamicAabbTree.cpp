@@ -0,0 +1,295 @@
+#include "DynamicAabbTree.h"
+#include <cassert>
+#include <cmath>
+
+namespace s3Dive {
+
+    namespace {
+
+        // A fat box this much larger than margin requires on any side is shrunk by reinserting, so a leaf that
+        // once moved far does not stay oversized forever
+        constexpr float kMaxMarginFactor = 4.0f;
+
+    } // namespace
+
+    DynamicAabbTree::DynamicAabbTree(float margin) : margin_(margin) {}
+
+    int32_t DynamicAabbTree::allocateNode() {
+        if (freeList_ == kNullNode) {
+            nodes_.push_back({});
+            links_.push_back({kNullNode, 0});
+            return static_cast<int32_t>(nodes_.size() - 1);
+        }
+        const int32_t node = freeList_;
+        freeList_ = links_[node].parent;
+        links_[node] = {kNullNode, 0};
+        return node;
+    }
+
+    void DynamicAabbTree::freeNode(int32_t node) {
+        links_[node] = {freeList_, -1};
+        freeList_ = node;
+    }
+
+    int32_t DynamicAabbTree::insert(const glm::vec3& min, const glm::vec3& max, uint32_t userData) {
+        const int32_t leaf = allocateNode();
+        const glm::vec3 margin(margin_);
+        nodes_[leaf] = {min - margin, kNullNode, max + margin, static_cast<int32_t>(userData)};
+        insertLeaf(leaf);
+        ++leafCount_;
+        return leaf;
+    }
+
+    void DynamicAabbTree::remove(int32_t leaf) {
+        assert(isLeaf(leaf) && links_[leaf].height == 0);
+        removeLeaf(leaf);
+        freeNode(leaf);
+        --leafCount_;
+    }
+
+    bool DynamicAabbTree::update(int32_t leaf, const glm::vec3& min, const glm::vec3& max) {
+        Node& node = nodes_[leaf];
+        const glm::vec3 margin(margin_);
+        const glm::vec3 fatMin = min - margin;
+        const glm::vec3 fatMax = max + margin;
+
+        const bool contained = node.min.x <= min.x && node.min.y <= min.y && node.min.z <= min.z &&
+                               node.max.x >= max.x && node.max.y >= max.y && node.max.z >= max.z;
+        const glm::vec3 largeMin = min - margin * kMaxMarginFactor;
+        const glm::vec3 largeMax = max + margin * kMaxMarginFactor;
+        const bool oversized = node.min.x < largeMin.x || node.min.y < largeMin.y || node.min.z < largeMin.z ||
+                               node.max.x > largeMax.x || node.max.y > largeMax.y || node.max.z > largeMax.z;
+        if (contained && !oversized) {
+            return false;
+        }
+
+        removeLeaf(leaf);
+        nodes_[leaf].min = fatMin;
+        nodes_[leaf].max = fatMax;
+        insertLeaf(leaf);
+        return true;
+    }
+
+    void DynamicAabbTree::clear() {
+        nodes_.clear();
+        links_.clear();
+        root_ = kNullNode;
+        freeList_ = kNullNode;
+        leafCount_ = 0;
+    }
+
+    void DynamicAabbTree::insertLeaf(int32_t leaf) {
+        if (root_ == kNullNode) {
+            root_ = leaf;
+            links_[leaf].parent = kNullNode;
+            return;
+        }
+
+        // Descend towards the sibling whose pairing adds the least surface area, counting the growth of every
+        // ancestor on the way (Box2D's branch and bound, without the bound)
+        const glm::vec3 leafMin = nodes_[leaf].min;
+        const glm::vec3 leafMax = nodes_[leaf].max;
+        int32_t index = root_;
+        while (!isLeaf(index)) {
+            const Node& node = nodes_[index];
+            const float area = surfaceArea(node.min, node.max);
+            const float combinedArea = surfaceArea(glm::min(node.min, leafMin), glm::max(node.max, leafMax));
+
+            // Pairing with this node creates a parent of combinedArea; descending instead grows this node
+            const float cost = 2.0f * combinedArea;
+            const float inheritanceCost = 2.0f * (combinedArea - area);
+
+            auto descendCost = [&](int32_t child) {
+                const Node& childNode = nodes_[child];
+                const float enlarged = surfaceArea(glm::min(childNode.min, leafMin), glm::max(childNode.max, leafMax));
+                return isLeaf(child) ? enlarged + inheritanceCost
+                                     : enlarged - surfaceArea(childNode.min, childNode.max) + inheritanceCost;
+            };
+            const float cost1 = descendCost(node.child1);
+            const float cost2 = descendCost(node.child2);
+
+            if (cost < cost1 && cost < cost2) {
+                break;
+            }
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        const int32_t sibling = index;
+        const int32_t oldParent = links_[sibling].parent;
+        const int32_t newParent = allocateNode();
+        nodes_[newParent] = {glm::min(leafMin, nodes_[sibling].min), sibling,
+                             glm::max(leafMax, nodes_[sibling].max), leaf};
+        links_[newParent] = {oldParent, links_[sibling].height + 1};
+        links_[sibling].parent = newParent;
+        links_[leaf].parent = newParent;
+
+        if (oldParent == kNullNode) {
+            root_ = newParent;
+        } else if (nodes_[oldParent].child1 == sibling) {
+            nodes_[oldParent].child1 = newParent;
+        } else {
+            nodes_[oldParent].child2 = newParent;
+        }
+
+        // Fix heights and boxes on the way up, rotating where the tree became lopsided
+        for (index = links_[leaf].parent; index != kNullNode; index = links_[index].parent) {
+            index = balance(index);
+            refit(index);
+        }
+    }
+
+    void DynamicAabbTree::removeLeaf(int32_t leaf) {
+        if (leaf == root_) {
+            root_ = kNullNode;
+            return;
+        }
+
+        const int32_t parent = links_[leaf].parent;
+        const int32_t grandParent = links_[parent].parent;
+        const int32_t sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+        // The sibling takes the parent's place
+        if (grandParent == kNullNode) {
+            root_ = sibling;
+            links_[sibling].parent = kNullNode;
+            freeNode(parent);
+            return;
+        }
+        if (nodes_[grandParent].child1 == parent) {
+            nodes_[grandParent].child1 = sibling;
+        } else {
+            nodes_[grandParent].child2 = sibling;
+        }
+        links_[sibling].parent = grandParent;
+        freeNode(parent);
+
+        for (int32_t index = grandParent; index != kNullNode; index = links_[index].parent) {
+            index = balance(index);
+            refit(index);
+        }
+    }
+
+    void DynamicAabbTree::refit(int32_t node) {
+        const Node& child1 = nodes_[nodes_[node].child1];
+        const Node& child2 = nodes_[nodes_[node].child2];
+        nodes_[node].min = glm::min(child1.min, child2.min);
+        nodes_[node].max = glm::max(child1.max, child2.max);
+        links_[node].height = 1 + std::max(links_[nodes_[node].child1].height, links_[nodes_[node].child2].height);
+    }
+
+    int32_t DynamicAabbTree::balance(int32_t iA) {
+        if (isLeaf(iA) || links_[iA].height < 2) {
+            return iA;
+        }
+
+        const int32_t iB = nodes_[iA].child1;
+        const int32_t iC = nodes_[iA].child2;
+        const int32_t heightDifference = links_[iC].height - links_[iB].height;
+
+        // Promotes child iUp of A, whose grandchildren are iF and iG; the taller of those stays under iUp and
+        // the other takes iUp's place under A
+        auto rotateUp = [this, iA](int32_t iUp) {
+            const int32_t iF = nodes_[iUp].child1;
+            const int32_t iG = nodes_[iUp].child2;
+
+            // Swap A and iUp
+            nodes_[iUp].child1 = iA;
+            links_[iUp].parent = links_[iA].parent;
+            links_[iA].parent = iUp;
+
+            const int32_t oldParent = links_[iUp].parent;
+            if (oldParent == kNullNode) {
+                root_ = iUp;
+            } else if (nodes_[oldParent].child1 == iA) {
+                nodes_[oldParent].child1 = iUp;
+            } else {
+                nodes_[oldParent].child2 = iUp;
+            }
+
+            const int32_t iTall = links_[iF].height > links_[iG].height ? iF : iG;
+            const int32_t iShort = iTall == iF ? iG : iF;
+            nodes_[iUp].child2 = iTall;
+            if (nodes_[iA].child1 == iUp) {
+                nodes_[iA].child1 = iShort;
+            } else {
+                nodes_[iA].child2 = iShort;
+            }
+            links_[iShort].parent = iA;
+
+            refit(iA);
+            refit(iUp);
+            return iUp;
+        };
+
+        if (heightDifference > 1) {
+            return rotateUp(iC);
+        }
+        if (heightDifference < -1) {
+            return rotateUp(iB);
+        }
+        return iA;
+    }
+
+    float DynamicAabbTree::getAreaRatio() const {
+        if (root_ == kNullNode) {
+            return 0.0f;
+        }
+        const float rootArea = surfaceArea(nodes_[root_].min, nodes_[root_].max);
+        float totalArea = 0.0f;
+        for (std::size_t i = 0; i < nodes_.size(); ++i) {
+            if (links_[i].height > 0) {
+                totalArea += surfaceArea(nodes_[i].min, nodes_[i].max);
+            }
+        }
+        return rootArea > 0.0f ? totalArea / rootArea : 0.0f;
+    }
+
+    bool DynamicAabbTree::validate() const {
+        std::size_t leaves = 0;
+        std::size_t reached = 0;
+        std::vector<int32_t> stack;
+        if (root_ != kNullNode) {
+            if (links_[root_].parent != kNullNode) {
+                return false;
+            }
+            stack.push_back(root_);
+        }
+        while (!stack.empty()) {
+            const int32_t index = stack.back();
+            stack.pop_back();
+            ++reached;
+            const Node& node = nodes_[index];
+            if (node.child1 == kNullNode) {
+                ++leaves;
+                if (links_[index].height != 0) {
+                    return false;
+                }
+                continue;
+            }
+
+            for (int32_t child : {node.child1, node.child2}) {
+                if (links_[child].parent != index || links_[child].height < 0) {
+                    return false;
+                }
+                const Node& childNode = nodes_[child];
+                if (childNode.min.x < node.min.x || childNode.min.y < node.min.y || childNode.min.z < node.min.z ||
+                    childNode.max.x > node.max.x || childNode.max.y > node.max.y || childNode.max.z > node.max.z) {
+                    return false;
+                }
+                stack.push_back(child);
+            }
+            const int32_t height1 = links_[node.child1].height;
+            const int32_t height2 = links_[node.child2].height;
+            if (links_[index].height != 1 + std::max(height1, height2)) {
+                return false;
+            }
+        }
+
+        std::size_t freeNodes = 0;
+        for (int32_t index = freeList_; index != kNullNode; index = links_[index].parent) {
+            ++freeNodes;
+        }
+        return leaves == leafCount_ && reached + freeNodes == nodes_.size();
+    }
+
+} // namespace s3Dive
@@ -0,0 +1,273 @@
+#ifndef THREEDIVE_DYNAMICAABBTREE_H
+#define THREEDIVE_DYNAMICAABBTREE_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <glm/glm.hpp>
+#include "../camera/frustum.h"
+
+namespace s3Dive {
+
+    // Incrementally maintained bounding volume hierarchy over axis-aligned boxes, after Box2D's b2DynamicTree.
+    // Leaves store boxes fattened by a margin, so objects that move a little stay in their leaf and cost nothing;
+    // ones that leave it are removed and reinserted next to the sibling that grows the tree's surface area least.
+    // Every insertion and removal rebalances the path to the root with rotations, which keeps the height close
+    // to log2 of the leaf count under any insertion order.
+    //
+    // Nodes are split hot and cold: traversal only reads 32-byte nodes (two per cache line), laid out as two
+    // 16-byte rows of min|child1 and max|child2 that load straight into 4-wide registers; parent links and
+    // heights, needed only while editing, live in a separate array. Queries are const and safe to run from
+    // several threads at once, but not alongside edits.
+    class DynamicAabbTree {
+    public:
+        static constexpr int32_t kNullNode = -1;
+
+        // margin is added on every side of the boxes stored in leaves
+        explicit DynamicAabbTree(float margin = 0.1f);
+
+        // Returns the leaf, which identifies the box from then on
+        int32_t insert(const glm::vec3& min, const glm::vec3& max, uint32_t userData);
+        void remove(int32_t leaf);
+        // Moves a leaf's box; returns false, leaving the tree untouched, while the box still fits the fat box
+        bool update(int32_t leaf, const glm::vec3& min, const glm::vec3& max);
+        void clear();
+
+        // callback(userData) for every leaf whose fat box intersects the frustum, conservatively as Frustum does
+        template<typename F>
+        void queryFrustum(const Frustum& frustum, F&& callback) const;
+
+        // callback(userData) for every leaf whose fat box overlaps [min, max]
+        template<typename F>
+        void queryBox(const glm::vec3& min, const glm::vec3& max, F&& callback) const;
+
+        // Visits leaves whose fat box the ray enters within maxDistance, nearest subtree first. callback(userData)
+        // runs the exact test and returns the hit distance, which then clips the ray, or a negative value for a
+        // miss. Returns the nearest distance reported, or maxDistance when there was none. direction need not be
+        // normalized; distances are in units of its length.
+        template<typename F>
+        float raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, F&& callback) const;
+
+        [[nodiscard]] uint32_t getUserData(int32_t leaf) const noexcept { return static_cast<uint32_t>(nodes_[leaf].child2); }
+        [[nodiscard]] glm::vec3 getFatMin(int32_t leaf) const noexcept { return nodes_[leaf].min; }
+        [[nodiscard]] glm::vec3 getFatMax(int32_t leaf) const noexcept { return nodes_[leaf].max; }
+
+        [[nodiscard]] std::size_t getLeafCount() const noexcept { return leafCount_; }
+        [[nodiscard]] int32_t getHeight() const noexcept { return root_ == kNullNode ? 0 : links_[root_].height; }
+        // Sum of the internal nodes' surface areas over the root's; lower means cheaper queries
+        [[nodiscard]] float getAreaRatio() const;
+        // Checks links, heights and that every parent encloses its children; for tests
+        [[nodiscard]] bool validate() const;
+
+    private:
+        struct Node {
+            glm::vec3 min;
+            int32_t child1; // kNullNode for leaves
+            glm::vec3 max;
+            int32_t child2; // The user data of a leaf
+        };
+
+        struct Links {
+            int32_t parent; // Next free node while on the free list
+            int32_t height; // 0 for leaves, -1 for free nodes
+        };
+
+        // Traversal stack that only allocates for unusually deep trees
+        template<typename T>
+        class Stack {
+        public:
+            void push(const T& value) {
+                if (size_ < inline_.size()) {
+                    inline_[size_++] = value;
+                } else {
+                    overflow_.push_back(value);
+                }
+            }
+            [[nodiscard]] bool empty() const noexcept { return size_ == 0 && overflow_.empty(); }
+            T pop() {
+                if (!overflow_.empty()) {
+                    T value = overflow_.back();
+                    overflow_.pop_back();
+                    return value;
+                }
+                return inline_[--size_];
+            }
+
+        private:
+            std::array<T, 64> inline_;
+            std::size_t size_ = 0;
+            std::vector<T> overflow_;
+        };
+
+        [[nodiscard]] bool isLeaf(int32_t node) const noexcept { return nodes_[node].child1 == kNullNode; }
+
+        int32_t allocateNode();
+        void freeNode(int32_t node);
+        void insertLeaf(int32_t leaf);
+        void removeLeaf(int32_t leaf);
+        // Rotates node's taller grandchild up when its children's heights differ by more than one; returns the
+        // node now at node's place
+        int32_t balance(int32_t node);
+        void refit(int32_t node);
+
+        [[nodiscard]] static float surfaceArea(const glm::vec3& min, const glm::vec3& max) noexcept {
+            const glm::vec3 size = max - min;
+            return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+        }
+
+        std::vector<Node> nodes_;
+        std::vector<Links> links_;
+        int32_t root_ = kNullNode;
+        int32_t freeList_ = kNullNode;
+        std::size_t leafCount_ = 0;
+        float margin_;
+    };
+
+    template<typename F>
+    void DynamicAabbTree::queryFrustum(const Frustum& frustum, F&& callback) const {
+        if (root_ == kNullNode) {
+            return;
+        }
+
+        // Each entry carries the planes its parent straddled; planes a box is fully inside are not tested
+        // again below it, and a box inside all six reports its whole subtree without further tests
+        constexpr uint32_t kAllPlanes = (1u << Frustum::PlaneCount) - 1;
+        struct Entry {
+            int32_t node;
+            uint32_t planes;
+        };
+        Stack<Entry> stack;
+        stack.push({root_, kAllPlanes});
+        while (!stack.empty()) {
+            const Entry entry = stack.pop();
+            const Node& node = nodes_[entry.node];
+
+            uint32_t planes = entry.planes;
+            bool outside = false;
+            if (planes != 0) {
+                const glm::vec3 center = (node.min + node.max) * 0.5f;
+                const glm::vec3 extent = (node.max - node.min) * 0.5f;
+                for (int i = 0; i < Frustum::PlaneCount; ++i) {
+                    if (!(planes & (1u << i))) {
+                        continue;
+                    }
+                    const glm::vec4& plane = frustum.planes[i];
+                    const float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+                    const float radius = std::abs(plane.x) * extent.x + std::abs(plane.y) * extent.y +
+                                         std::abs(plane.z) * extent.z;
+                    if (distance < -radius) {
+                        outside = true;
+                        break;
+                    }
+                    if (distance >= radius) {
+                        planes &= ~(1u << i);
+                    }
+                }
+            }
+            if (outside) {
+                continue;
+            }
+
+            if (node.child1 == kNullNode) {
+                callback(static_cast<uint32_t>(node.child2));
+            } else {
+                stack.push({node.child1, planes});
+                stack.push({node.child2, planes});
+            }
+        }
+    }
+
+    template<typename F>
+    void DynamicAabbTree::queryBox(const glm::vec3& min, const glm::vec3& max, F&& callback) const {
+        if (root_ == kNullNode) {
+            return;
+        }
+
+        Stack<int32_t> stack;
+        stack.push(root_);
+        while (!stack.empty()) {
+            const Node& node = nodes_[stack.pop()];
+            if (node.min.x > max.x || node.min.y > max.y || node.min.z > max.z ||
+                node.max.x < min.x || node.max.y < min.y || node.max.z < min.z) {
+                continue;
+            }
+            if (node.child1 == kNullNode) {
+                callback(static_cast<uint32_t>(node.child2));
+            } else {
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+    }
+
+    template<typename F>
+    float DynamicAabbTree::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance,
+                                   F&& callback) const {
+        if (root_ == kNullNode) {
+            return maxDistance;
+        }
+
+        // Slab test; an axis the ray is parallel to gets an infinite reciprocal, which the comparisons handle
+        const glm::vec3 inverse(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+        auto entryDistance = [&](const Node& node, float limit) {
+            float tMin = 0.0f;
+            float tMax = limit;
+            for (int axis = 0; axis < 3; ++axis) {
+                float t1 = (node.min[axis] - origin[axis]) * inverse[axis];
+                float t2 = (node.max[axis] - origin[axis]) * inverse[axis];
+                if (t1 > t2) {
+                    std::swap(t1, t2);
+                }
+                // NaN from 0 * inf (origin on a slab of a parallel axis) fails both tests and keeps the bounds
+                tMin = t1 > tMin ? t1 : tMin;
+                tMax = t2 < tMax ? t2 : tMax;
+                if (tMin > tMax) {
+                    return std::numeric_limits<float>::infinity();
+                }
+            }
+            return tMin;
+        };
+
+        struct Entry {
+            int32_t node;
+            float distance;
+        };
+        Stack<Entry> stack;
+        stack.push({root_, entryDistance(nodes_[root_], maxDistance)});
+        while (!stack.empty()) {
+            const Entry entry = stack.pop();
+            // The ray may have been clipped since this subtree was pushed
+            if (entry.distance > maxDistance) {
+                continue;
+            }
+            const Node& node = nodes_[entry.node];
+            if (node.child1 == kNullNode) {
+                const float hit = callback(static_cast<uint32_t>(node.child2));
+                if (hit >= 0.0f && hit < maxDistance) {
+                    maxDistance = hit;
+                }
+                continue;
+            }
+
+            Entry first{node.child1, entryDistance(nodes_[node.child1], maxDistance)};
+            Entry second{node.child2, entryDistance(nodes_[node.child2], maxDistance)};
+            if (first.distance > second.distance) {
+                std::swap(first, second);
+            }
+            // Nearer child on top so it is searched, and can clip the ray, first
+            if (second.distance <= maxDistance) {
+                stack.push(second);
+            }
+            if (first.distance <= maxDistance) {
+                stack.push(first);
+            }
+        }
+        return maxDistance;
+    }
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_DYNAMICAABBTREE_H
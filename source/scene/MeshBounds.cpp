@@ -0,0 +1,41 @@
+#include "MeshBounds.h"
+#include <algorithm>
+#include <cmath>
+
+namespace s3Dive {
+
+    MeshBounds computeMeshBounds(const float* vertexData, std::size_t vertexCount, std::size_t strideFloats) {
+        MeshBounds bounds;
+        if (vertexCount == 0) {
+            return bounds;
+        }
+
+        bounds.min = bounds.max = glm::vec3(vertexData[0], vertexData[1], vertexData[2]);
+        for (std::size_t i = 1; i < vertexCount; ++i) {
+            const float* position = vertexData + i * strideFloats;
+            const glm::vec3 point(position[0], position[1], position[2]);
+            bounds.min = glm::min(bounds.min, point);
+            bounds.max = glm::max(bounds.max, point);
+        }
+
+        bounds.sphereCenter = bounds.getCenter();
+        float radiusSquared = 0.0f;
+        for (std::size_t i = 0; i < vertexCount; ++i) {
+            const float* position = vertexData + i * strideFloats;
+            const glm::vec3 offset = glm::vec3(position[0], position[1], position[2]) - bounds.sphereCenter;
+            radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+        }
+        bounds.sphereRadius = std::sqrt(radiusSquared);
+        return bounds;
+    }
+
+    void transformBounds(const MeshBounds& bounds, const glm::mat4& transform, glm::vec3& center, glm::vec3& extent) {
+        // Arvo: the new half extent along each axis is the absolute linear part applied to the old one
+        const glm::vec3 localExtent = bounds.getExtent();
+        center = glm::vec3(transform * glm::vec4(bounds.getCenter(), 1.0f));
+        extent = glm::abs(glm::vec3(transform[0])) * localExtent.x +
+                 glm::abs(glm::vec3(transform[1])) * localExtent.y +
+                 glm::abs(glm::vec3(transform[2])) * localExtent.z;
+    }
+
+} // namespace s3Dive
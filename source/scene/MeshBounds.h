@@ -0,0 +1,29 @@
+#ifndef THREEDIVE_MESHBOUNDS_H
+#define THREEDIVE_MESHBOUNDS_H
+
+#include <cstddef>
+#include <glm/glm.hpp>
+
+namespace s3Dive {
+
+    // Object-space bounds of a mesh; an empty mesh has a zero-sized box at the origin
+    struct MeshBounds {
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+        glm::vec3 sphereCenter{0.0f};
+        float sphereRadius = 0.0f;
+
+        [[nodiscard]] glm::vec3 getCenter() const { return (min + max) * 0.5f; }
+        [[nodiscard]] glm::vec3 getExtent() const { return (max - min) * 0.5f; }
+    };
+
+    // Reads the position (first three floats) of each vertex; strideFloats is the vertex size in floats.
+    // The sphere is centred on the box and as tight as that centre allows.
+    [[nodiscard]] MeshBounds computeMeshBounds(const float* vertexData, std::size_t vertexCount, std::size_t strideFloats);
+
+    // Axis-aligned box around bounds transformed by an affine matrix, as centre and half extent
+    void transformBounds(const MeshBounds& bounds, const glm::mat4& transform, glm::vec3& center, glm::vec3& extent);
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_MESHBOUNDS_H
@@ -0,0 +1,285 @@
+#include "MeshCache.h"
+#include "../core/hash.h"
+#include "../core/mapped_file.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <spdlog/spdlog.h>
+
+namespace s3Dive {
+
+    namespace {
+
+        constexpr char kMagic[4] = {'3', 'D', 'M', 'C'};
+        constexpr std::size_t kBlobAlignment = 16;
+
+        struct FileHeader {
+            char magic[4];
+            uint32_t version;
+            uint64_t sourceHash;
+            uint32_t importFlags;
+            uint32_t meshCount;
+            uint32_t instanceCount;
+            uint32_t nodeCount;
+            uint64_t stringTableOffset;
+            uint64_t stringTableSize;
+        };
+
+        struct MeshRecord {
+            uint64_t vertexOffset;
+            uint64_t indexOffset;
+            uint32_t vertexFloatCount;
+            uint32_t indexCount;
+            float albedo[3];
+            float roughness;
+            uint32_t texturePathOffset;
+            uint32_t texturePathSize;
+            uint32_t firstInstance;
+            uint32_t instanceCount;
+        };
+
+        struct NodeRecord {
+            uint32_t parent;
+            float translation[3];
+            float rotation[3];
+            float scale[3];
+        };
+
+        struct InstanceRecord {
+            uint32_t node;
+        };
+
+        static_assert(sizeof(FileHeader) == 48, "MeshCache header layout changed, bump kFormatVersion");
+        static_assert(sizeof(MeshRecord) == 56, "MeshCache mesh record layout changed, bump kFormatVersion");
+        static_assert(sizeof(NodeRecord) == 40, "MeshCache node record layout changed, bump kFormatVersion");
+        static_assert(sizeof(InstanceRecord) == 4, "MeshCache instance record layout changed, bump kFormatVersion");
+
+        constexpr uint64_t alignUp(uint64_t value) {
+            return (value + kBlobAlignment - 1) & ~static_cast<uint64_t>(kBlobAlignment - 1);
+        }
+
+        bool isInBounds(uint64_t offset, uint64_t size, std::size_t fileSize) {
+            return offset <= fileSize && size <= fileSize - offset;
+        }
+
+    } // namespace
+
+    std::string MeshCache::getCachePath(const std::string& sourcePath) {
+        return sourcePath + ".3dcache";
+    }
+
+    std::optional<uint64_t> MeshCache::hashSourceFile(const std::string& sourcePath) {
+        MappedFile source(sourcePath);
+        if (!source.isOpen()) {
+            return std::nullopt;
+        }
+        return hash::fnv1a64(source.data(), source.size());
+    }
+
+    std::optional<ImportedModel> MeshCache::read(const std::string& cachePath,
+                                                 uint64_t sourceHash,
+                                                 uint32_t importFlags) {
+        auto mapping = std::make_shared<MappedFile>(cachePath);
+        if (!mapping->isOpen() || mapping->size() < sizeof(FileHeader)) {
+            return std::nullopt;
+        }
+
+        const std::byte* base = mapping->data();
+        const std::size_t fileSize = mapping->size();
+
+        FileHeader header{};
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+            header.version != kFormatVersion ||
+            header.sourceHash != sourceHash ||
+            header.importFlags != importFlags) {
+            return std::nullopt;
+        }
+
+        const uint64_t meshRecordsOffset = sizeof(FileHeader);
+        const uint64_t nodeRecordsOffset = meshRecordsOffset + uint64_t{header.meshCount} * sizeof(MeshRecord);
+        const uint64_t instanceRecordsOffset = nodeRecordsOffset + uint64_t{header.nodeCount} * sizeof(NodeRecord);
+        if (!isInBounds(meshRecordsOffset, uint64_t{header.meshCount} * sizeof(MeshRecord), fileSize) ||
+            !isInBounds(nodeRecordsOffset, uint64_t{header.nodeCount} * sizeof(NodeRecord), fileSize) ||
+            !isInBounds(instanceRecordsOffset, uint64_t{header.instanceCount} * sizeof(InstanceRecord), fileSize) ||
+            !isInBounds(header.stringTableOffset, header.stringTableSize, fileSize)) {
+            spdlog::warn("Ignoring truncated mesh cache: {}", cachePath);
+            return std::nullopt;
+        }
+
+        ImportedModel model;
+        model.nodes.resize(header.nodeCount);
+        for (uint32_t i = 0; i < header.nodeCount; ++i) {
+            NodeRecord record{};
+            std::memcpy(&record, base + nodeRecordsOffset + uint64_t{i} * sizeof(NodeRecord), sizeof(record));
+            // Parents come first, which also rules out cycles
+            if (record.parent != ImportedNode::kNoParent && record.parent >= i) {
+                spdlog::warn("Ignoring corrupted mesh cache: {}", cachePath);
+                return std::nullopt;
+            }
+            model.nodes[i].parent = record.parent;
+            model.nodes[i].local = TransformComponent(
+                    glm::vec3(record.translation[0], record.translation[1], record.translation[2]),
+                    glm::vec3(record.rotation[0], record.rotation[1], record.rotation[2]),
+                    glm::vec3(record.scale[0], record.scale[1], record.scale[2]));
+        }
+
+        auto& meshes = model.meshes;
+        meshes.resize(header.meshCount);
+        for (uint32_t i = 0; i < header.meshCount; ++i) {
+            MeshRecord record{};
+            std::memcpy(&record, base + meshRecordsOffset + uint64_t{i} * sizeof(MeshRecord), sizeof(record));
+
+            const uint64_t vertexBytes = uint64_t{record.vertexFloatCount} * sizeof(float);
+            const uint64_t indexBytes = uint64_t{record.indexCount} * sizeof(unsigned int);
+            if (!isInBounds(record.vertexOffset, vertexBytes, fileSize) ||
+                !isInBounds(record.indexOffset, indexBytes, fileSize) ||
+                record.vertexOffset % kBlobAlignment != 0 || record.indexOffset % kBlobAlignment != 0 ||
+                uint64_t{record.texturePathOffset} + record.texturePathSize > header.stringTableSize ||
+                uint64_t{record.firstInstance} + record.instanceCount > header.instanceCount) {
+                spdlog::warn("Ignoring corrupted mesh cache: {}", cachePath);
+                return std::nullopt;
+            }
+
+            auto& mesh = meshes[i];
+            mesh.buffers.vertexData = reinterpret_cast<const float*>(base + record.vertexOffset);
+            mesh.buffers.vertexFloatCount = record.vertexFloatCount;
+            mesh.buffers.indices = reinterpret_cast<const unsigned int*>(base + record.indexOffset);
+            mesh.buffers.indexCount = record.indexCount;
+            mesh.buffers.owner = mapping;
+
+            mesh.material.albedo = glm::vec3(record.albedo[0], record.albedo[1], record.albedo[2]);
+            mesh.material.roughness = record.roughness;
+            mesh.material.diffuseTexturePath.assign(
+                    reinterpret_cast<const char*>(base + header.stringTableOffset + record.texturePathOffset),
+                    record.texturePathSize);
+
+            mesh.instances.reserve(record.instanceCount);
+            for (uint32_t j = 0; j < record.instanceCount; ++j) {
+                InstanceRecord instance{};
+                std::memcpy(&instance,
+                            base + instanceRecordsOffset + uint64_t{record.firstInstance + j} * sizeof(InstanceRecord),
+                            sizeof(instance));
+                if (instance.node >= header.nodeCount) {
+                    spdlog::warn("Ignoring corrupted mesh cache: {}", cachePath);
+                    return std::nullopt;
+                }
+                mesh.instances.push_back(instance.node);
+            }
+        }
+
+        return model;
+    }
+
+    bool MeshCache::write(const std::string& cachePath,
+                          uint64_t sourceHash,
+                          uint32_t importFlags,
+                          const std::vector<ImportedNode>& nodes,
+                          const std::vector<ImportedMesh>& meshes) {
+        FileHeader header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kFormatVersion;
+        header.sourceHash = sourceHash;
+        header.importFlags = importFlags;
+        header.meshCount = static_cast<uint32_t>(meshes.size());
+        header.nodeCount = static_cast<uint32_t>(nodes.size());
+
+        std::vector<NodeRecord> nodeRecords;
+        nodeRecords.reserve(nodes.size());
+        for (const auto& node : nodes) {
+            const auto& transform = node.local;
+            nodeRecords.push_back({
+                    node.parent,
+                    {transform.Translation.x, transform.Translation.y, transform.Translation.z},
+                    {transform.Rotation.x, transform.Rotation.y, transform.Rotation.z},
+                    {transform.Scale.x, transform.Scale.y, transform.Scale.z}});
+        }
+
+        std::vector<MeshRecord> meshRecords(meshes.size());
+        std::vector<InstanceRecord> instanceRecords;
+        std::string stringTable;
+
+        for (std::size_t i = 0; i < meshes.size(); ++i) {
+            const auto& mesh = meshes[i];
+            auto& record = meshRecords[i];
+            record.vertexFloatCount = static_cast<uint32_t>(mesh.buffers.vertexFloatCount);
+            record.indexCount = static_cast<uint32_t>(mesh.buffers.indexCount);
+            record.albedo[0] = mesh.material.albedo.x;
+            record.albedo[1] = mesh.material.albedo.y;
+            record.albedo[2] = mesh.material.albedo.z;
+            record.roughness = mesh.material.roughness;
+            record.texturePathOffset = static_cast<uint32_t>(stringTable.size());
+            record.texturePathSize = static_cast<uint32_t>(mesh.material.diffuseTexturePath.size());
+            stringTable += mesh.material.diffuseTexturePath;
+
+            record.firstInstance = static_cast<uint32_t>(instanceRecords.size());
+            record.instanceCount = static_cast<uint32_t>(mesh.instances.size());
+            for (uint32_t node : mesh.instances) {
+                instanceRecords.push_back({node});
+            }
+        }
+
+        header.instanceCount = static_cast<uint32_t>(instanceRecords.size());
+        header.stringTableOffset = sizeof(FileHeader) +
+                                   meshRecords.size() * sizeof(MeshRecord) +
+                                   nodeRecords.size() * sizeof(NodeRecord) +
+                                   instanceRecords.size() * sizeof(InstanceRecord);
+        header.stringTableSize = stringTable.size();
+
+        uint64_t blobOffset = alignUp(header.stringTableOffset + header.stringTableSize);
+        for (std::size_t i = 0; i < meshes.size(); ++i) {
+            meshRecords[i].vertexOffset = blobOffset;
+            blobOffset = alignUp(blobOffset + meshes[i].buffers.vertexFloatCount * sizeof(float));
+            meshRecords[i].indexOffset = blobOffset;
+            blobOffset = alignUp(blobOffset + meshes[i].buffers.indexCount * sizeof(unsigned int));
+        }
+
+        // Write to a temporary file and rename so a crash never leaves a half-written cache behind
+        const std::string tempPath = cachePath + ".tmp";
+        {
+            std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+            if (!stream.is_open()) {
+                spdlog::warn("Failed to create mesh cache: {}", tempPath);
+                return false;
+            }
+
+            auto writeBytes = [&stream](const void* data, std::size_t size) {
+                stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+            };
+            auto padTo = [&stream](uint64_t offset) {
+                static constexpr char zeros[kBlobAlignment] = {};
+                const auto position = static_cast<uint64_t>(stream.tellp());
+                stream.write(zeros, static_cast<std::streamsize>(offset - position));
+            };
+
+            writeBytes(&header, sizeof(header));
+            writeBytes(meshRecords.data(), meshRecords.size() * sizeof(MeshRecord));
+            writeBytes(nodeRecords.data(), nodeRecords.size() * sizeof(NodeRecord));
+            writeBytes(instanceRecords.data(), instanceRecords.size() * sizeof(InstanceRecord));
+            writeBytes(stringTable.data(), stringTable.size());
+
+            for (std::size_t i = 0; i < meshes.size(); ++i) {
+                padTo(meshRecords[i].vertexOffset);
+                writeBytes(meshes[i].buffers.vertexData, meshes[i].buffers.vertexFloatCount * sizeof(float));
+                padTo(meshRecords[i].indexOffset);
+                writeBytes(meshes[i].buffers.indices, meshes[i].buffers.indexCount * sizeof(unsigned int));
+            }
+
+            if (!stream.good()) {
+                spdlog::warn("Failed to write mesh cache: {}", tempPath);
+                stream.close();
+                std::remove(tempPath.c_str());
+                return false;
+            }
+        }
+
+        if (std::rename(tempPath.c_str(), cachePath.c_str()) != 0) {
+            spdlog::warn("Failed to move mesh cache into place: {}", cachePath);
+            std::remove(tempPath.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+} // namespace s3Dive
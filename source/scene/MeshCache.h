@@ -0,0 +1,34 @@
+#ifndef THREEDIVE_MESHCACHE_H
+#define THREEDIVE_MESHCACHE_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+#include "MeshData.h"
+
+namespace s3Dive {
+
+    // Versioned binary cache of an imported model, stored next to the source file.
+    // Entries are keyed by the source content hash and the import flags; on a hit the
+    // returned MeshBuffers point straight into a read-only mapping of the cache file.
+    class MeshCache {
+    public:
+        static constexpr uint32_t kFormatVersion = 2;
+
+        [[nodiscard]] static std::string getCachePath(const std::string& sourcePath);
+        [[nodiscard]] static std::optional<uint64_t> hashSourceFile(const std::string& sourcePath);
+
+        [[nodiscard]] static std::optional<ImportedModel> read(const std::string& cachePath,
+                                                               uint64_t sourceHash,
+                                                               uint32_t importFlags);
+        static bool write(const std::string& cachePath,
+                          uint64_t sourceHash,
+                          uint32_t importFlags,
+                          const std::vector<ImportedNode>& nodes,
+                          const std::vector<ImportedMesh>& meshes);
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_MESHCACHE_H
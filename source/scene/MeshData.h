@@ -0,0 +1,69 @@
+#ifndef THREEDIVE_MESHDATA_H
+#define THREEDIVE_MESHDATA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "components.h"
+
+namespace s3Dive {
+
+    // Number of floats per interleaved vertex: position (3), normal (3), texture coordinates (2)
+    inline constexpr std::size_t kInterleavedVertexFloats = 8;
+
+    // Non-owning view of upload-ready mesh data; owner keeps the backing storage (vectors or a file mapping) alive.
+    struct MeshBuffers {
+        const float* vertexData = nullptr;
+        std::size_t vertexFloatCount = 0;
+        const unsigned int* indices = nullptr;
+        std::size_t indexCount = 0;
+        std::shared_ptr<const void> owner;
+    };
+
+    // Owning storage for MeshBuffers produced on the CPU (importers, native readers).
+    struct InterleavedMeshData {
+        std::vector<float> vertexData;
+        std::vector<unsigned int> indices;
+    };
+
+    [[nodiscard]] inline MeshBuffers makeMeshBuffers(std::shared_ptr<const InterleavedMeshData> data) {
+        MeshBuffers buffers;
+        buffers.vertexData = data->vertexData.data();
+        buffers.vertexFloatCount = data->vertexData.size();
+        buffers.indices = data->indices.data();
+        buffers.indexCount = data->indices.size();
+        buffers.owner = std::move(data);
+        return buffers;
+    }
+
+    // CPU-side material parameters, resolved into a MaterialComponent on the GL thread.
+    struct MaterialDescription {
+        glm::vec3 albedo = MaterialComponent{}.albedo;
+        float roughness = MaterialComponent{}.roughness;
+        std::string diffuseTexturePath;
+    };
+
+    // Node of an imported scene graph with its transform relative to the parent node
+    struct ImportedNode {
+        static constexpr uint32_t kNoParent = ~0u;
+
+        uint32_t parent = kNoParent; // Index into the model's nodes; always lower than the node's own index
+        TransformComponent local;
+    };
+
+    struct ImportedMesh {
+        MeshBuffers buffers;
+        MaterialDescription material;
+        std::vector<uint32_t> instances; // Nodes the mesh is attached to
+    };
+
+    struct ImportedModel {
+        std::vector<ImportedNode> nodes;
+        std::vector<ImportedMesh> meshes;
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_MESHDATA_H
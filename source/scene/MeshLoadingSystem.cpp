@@ -1,49 +1,358 @@
 #include "MeshLoadingSystem.h"
+#include "MeshCache.h"
+#include "NativeMeshReader.h"
+#include "../renderer/MaterialUniformCache.h"
+#include "../renderer/TextureCache.h"
 #include "../renderer/RenderCommand.h"
+#include "TransformSystem.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/matrix_decompose.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <iterator>
 
 namespace s3Dive {
 
-    void ModelLoadingSystem::loadModel(Scene& scene, const std::string& filepath) {
+    bool ModelImportHandle::isDone() const noexcept {
+        const auto status = getStatus();
+        return status == ModelImportStatus::Completed || status == ModelImportStatus::Failed;
+    }
+
+    float ModelImportHandle::getProgress() const noexcept {
+        const auto total = state_->totalMeshes.load();
+        if (total == 0) {
+            return isDone() ? 1.0f : 0.0f;
+        }
+        return static_cast<float>(state_->uploadedMeshes.load()) / static_cast<float>(total);
+    }
+
+    ModelLoadingSystem::ModelLoadingSystem(std::size_t workerCount) : threadPool_(workerCount) {}
 
+    ModelImportHandle ModelLoadingSystem::loadModelAsync(Scene& scene, const std::string& filepath) {
         spdlog::info("Loading model: {}", filepath);
 
-        Assimp::Importer importer;
-        constexpr unsigned int importFlags =
-                aiProcess_Triangulate |
-                aiProcess_FlipUVs |
-                aiProcess_CalcTangentSpace |
-                aiProcess_GenNormals |
-                aiProcess_JoinIdenticalVertices |
-                aiProcess_SortByPType;
+        auto state = std::make_shared<ModelImportState>();
+        state->filepath = filepath;
+
+        auto modelEntity = scene.createEntity();
+        state->modelEntityUUID = scene.getUUID(modelEntity);
+        scene.addComponent<ModelComponent>(state->modelEntityUUID).filepath = filepath;
+
+        auto job = std::make_shared<ImportJob>();
+        job->state = state;
+        job->quantization = quantizationSettings_;
+        job->optimization = optimizationSettings_;
+        activeImports_.push_back(state);
+
+        threadPool_.submit([this, job] { importModel(job); });
+
+        return ModelImportHandle(state);
+    }
+
+    void ModelLoadingSystem::loadModel(Scene& scene, const std::string& filepath) {
+        auto handle = loadModelAsync(scene, filepath);
+        handle.waitParsed();
+        while (!handle.isDone()) {
+            update(scene, 0.0f);
+        }
+    }
 
-        const aiScene* aiScene = importer.ReadFile(filepath, importFlags);
+    bool ModelLoadingSystem::markParsed(ModelImportState& state) {
+        if (state.parsedResolved.exchange(true)) {
+            return false;
+        }
+        state.status = ModelImportStatus::Uploading;
+        state.parsedPromise.set_value();
+        return true;
+    }
 
-        if (!aiScene || aiScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !aiScene->mRootNode) {
-//            throw std::runtime_error(fmt::format("ERROR::ASSIMP::{}", importer.GetErrorString()));
+    void ModelLoadingSystem::failImport(ModelImportState& state, std::string error) {
+        if (state.parsedResolved.exchange(true)) {
             return;
         }
+        state.error = std::move(error);
+        state.status = ModelImportStatus::Failed;
+        state.parsedPromise.set_value();
+    }
 
-        spdlog::info("Meshes in scene: {}", aiScene->mNumMeshes);
-        spdlog::info("Root node children: {}", aiScene->mRootNode->mNumChildren);
+    void ModelLoadingSystem::importModel(const std::shared_ptr<ImportJob>& job) {
+        // The pool discards the task's future, so nothing would see an exception escape; without this the
+        // import would stay Parsing and loadModel would wait on it forever
+        try {
+            parseModel(job);
+        } catch (const std::exception& exception) {
+            failImport(*job->state, exception.what());
+        } catch (...) {
+            failImport(*job->state, "Unknown error while parsing");
+        }
+    }
 
-        auto modelEntity = scene.createEntity();
-        auto modelEntityUUID = scene.getEntityUUID(modelEntity).value();
-        scene.addComponent<ModelComponent>(modelEntityUUID);
+    void ModelLoadingSystem::parseModel(const std::shared_ptr<ImportJob>& job) {
+        auto& state = *job->state;
+
+        // Plain scan formats are parsed straight into upload buffers at close to I/O speed, which is
+        // about as fast as reading the mesh cache back, so they skip it
+        if (NativeMeshReader::canRead(state.filepath)) {
+            if (auto nativeMesh = NativeMeshReader::read(state.filepath)) {
+                optimize(*job, *nativeMesh);
+                ImportedModel model;
+                model.nodes.emplace_back();
+                model.meshes.resize(1);
+                model.meshes[0].buffers = makeMeshBuffers(std::make_shared<InterleavedMeshData>(std::move(*nativeMesh)));
+                model.meshes[0].instances.push_back(0);
+                enqueueImportedModel(job, std::move(model));
+                return;
+            }
+        }
+
+        job->sourceHash = MeshCache::hashSourceFile(state.filepath);
+        if (job->sourceHash) {
+            const auto cachePath = MeshCache::getCachePath(state.filepath);
+            if (auto cachedModel = MeshCache::read(cachePath, *job->sourceHash, getCacheKeyFlags(*job))) {
+                spdlog::info("Loading {} from mesh cache {}", state.filepath, cachePath);
+                enqueueImportedModel(job, std::move(*cachedModel));
+                return;
+            }
+        }
+
+        job->scene = job->importer.ReadFile(state.filepath, kImportFlags);
+
+        if (!job->scene || job->scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !job->scene->mRootNode) {
+            failImport(state, fmt::format("ERROR::ASSIMP::{}", job->importer.GetErrorString()));
+            return;
+        }
+
+        spdlog::info("Meshes in scene: {}", job->scene->mNumMeshes);
+        spdlog::info("Root node children: {}", job->scene->mRootNode->mNumChildren);
 
-        processNode(scene, aiScene->mRootNode, aiScene, modelEntityUUID, glm::mat4(1.0f));
+        job->meshInstances.resize(job->scene->mNumMeshes);
+        processNode(job->scene->mRootNode, job->scene, ImportedNode::kNoParent, state.nodes, job->meshInstances);
+        stageNodeEntities(state);
+
+        std::vector<unsigned int> referencedMeshes;
+        for (unsigned int i = 0; i < job->scene->mNumMeshes; i++) {
+            if (!job->meshInstances[i].empty()) {
+                referencedMeshes.push_back(i);
+            }
+        }
+
+        state.totalMeshes = static_cast<uint32_t>(referencedMeshes.size());
+        if (referencedMeshes.empty()) {
+            markParsed(state);
+            return;
+        }
+
+        // Fan out one task per mesh; the last one to finish writes the cache and releases the importer
+        job->importedMeshes.resize(job->scene->mNumMeshes);
+        job->pendingMeshes = static_cast<uint32_t>(referencedMeshes.size());
+        for (unsigned int meshIndex : referencedMeshes) {
+            threadPool_.submit([this, job, meshIndex] { processMeshTask(job, meshIndex); });
+        }
     }
 
-    void ModelLoadingSystem::processNode(Scene& scene, const aiNode* node, const aiScene* aiScene,
-                                         const UUID& modelEntityUUID, const glm::mat4& parentTransform) {
-        // Extract the transformation matrix from the node and combine it with the parent transform
+    void ModelLoadingSystem::processMeshTask(const std::shared_ptr<ImportJob>& job, unsigned int meshIndex) {
+        if (job->state->status == ModelImportStatus::Failed) {
+            // Another mesh of the model failed; the rest are not worth parsing
+            return;
+        }
+
+        // A failed mesh fails the whole import and never counts down pendingMeshes, so the cache is not written
+        try {
+            const aiMesh* mesh = job->scene->mMeshes[meshIndex];
+
+            ProcessedMesh processedMesh;
+            processedMesh.state = job->state;
+            // Only the interleaved copy is kept: it backs the upload and the mesh cache, and is released after both
+            auto interleaved = std::make_shared<InterleavedMeshData>(processMesh(mesh));
+            optimize(*job, *interleaved);
+            processedMesh.imported.buffers = makeMeshBuffers(std::move(interleaved));
+            processedMesh.quantized = quantize(*job, processedMesh.imported.buffers);
+            processedMesh.bounds = computeBounds(processedMesh.imported.buffers);
+            processedMesh.occluder = buildOccluder(processedMesh.imported.buffers);
+            processedMesh.imported.material = processMaterial(job->scene->mMaterials[mesh->mMaterialIndex],
+                                                              std::filesystem::path(job->state->filepath).parent_path());
+            processedMesh.imported.instances = std::move(job->meshInstances[meshIndex]);
+
+            // Only shares the buffers, the vertex data itself is not copied
+            job->importedMeshes[meshIndex] = processedMesh.imported;
+
+            std::lock_guard lock(processedMutex_);
+            processedMeshes_.push_back(std::move(processedMesh));
+        } catch (const std::exception& exception) {
+            failImport(*job->state, fmt::format("Mesh {}: {}", meshIndex, exception.what()));
+            return;
+        } catch (...) {
+            failImport(*job->state, fmt::format("Mesh {}: unknown error", meshIndex));
+            return;
+        }
+
+        if (job->pendingMeshes.fetch_sub(1) != 1 || !markParsed(*job->state)) {
+            return;
+        }
+
+        if (job->sourceHash) {
+            // The model itself is loaded by now; a cache that cannot be written only costs the next import
+            try {
+                auto& meshes = job->importedMeshes;
+                meshes.erase(std::remove_if(meshes.begin(), meshes.end(), [](const ImportedMesh& importedMesh) {
+                    return importedMesh.instances.empty();
+                }), meshes.end());
+
+                const auto cachePath = MeshCache::getCachePath(job->state->filepath);
+                if (MeshCache::write(cachePath, *job->sourceHash, getCacheKeyFlags(*job), job->state->nodes, meshes)) {
+                    spdlog::info("Wrote mesh cache {}", cachePath);
+                }
+            } catch (const std::exception& exception) {
+                spdlog::warn("Could not write mesh cache for {}: {}", job->state->filepath, exception.what());
+            }
+        }
+    }
+
+    void ModelLoadingSystem::enqueueImportedModel(const std::shared_ptr<ImportJob>& job, ImportedModel&& model) {
+        const auto& state = job->state;
+        auto& meshes = model.meshes;
+        state->nodes = std::move(model.nodes);
+        stageNodeEntities(*state);
+        state->totalMeshes = static_cast<uint32_t>(meshes.size());
+
+        std::vector<ProcessedMesh> processed(meshes.size());
+        for (std::size_t i = 0; i < meshes.size(); ++i) {
+            processed[i].state = state;
+            processed[i].imported = std::move(meshes[i]);
+            processed[i].quantized = quantize(*job, processed[i].imported.buffers);
+            processed[i].bounds = computeBounds(processed[i].imported.buffers);
+            processed[i].occluder = buildOccluder(processed[i].imported.buffers);
+        }
+
+        {
+            std::lock_guard lock(processedMutex_);
+            std::move(processed.begin(), processed.end(), std::back_inserter(processedMeshes_));
+        }
+        markParsed(*state);
+    }
+
+    void ModelLoadingSystem::update(Scene& scene, [[maybe_unused]] float deltaTime) {
+        std::vector<ProcessedMesh> readyMeshes;
+        {
+            std::lock_guard lock(processedMutex_);
+            const auto count = std::min(uploadBudgetPerFrame_, processedMeshes_.size());
+            readyMeshes.assign(std::make_move_iterator(processedMeshes_.begin()),
+                               std::make_move_iterator(processedMeshes_.begin() + static_cast<std::ptrdiff_t>(count)));
+            processedMeshes_.erase(processedMeshes_.begin(), processedMeshes_.begin() + static_cast<std::ptrdiff_t>(count));
+        }
+
+        for (auto& processedMesh : readyMeshes) {
+            uploadMesh(scene, processedMesh);
+        }
+
+        finishImports(scene);
+    }
+
+    void ModelLoadingSystem::uploadMesh(Scene& scene, ProcessedMesh& processedMesh) const {
+        auto& state = *processedMesh.state;
+        if (!scene.hasComponent<ModelComponent>(state.modelEntityUUID)) {
+            // Model entity was destroyed while its meshes were still being parsed
+            state.uploadedMeshes++;
+            return;
+        }
+
+        if (!state.nodeStaging.empty()) {
+            state.nodeStaging.merge(scene);
+        }
+
+        // Uploaded once; every node that references the mesh shares the asset and is drawn instanced
+        auto asset = std::make_shared<MeshAsset>();
+        if (processedMesh.quantized) {
+            initializeQuantizedMeshAsset(*asset, *processedMesh.quantized);
+        } else {
+            initializeMeshAsset(*asset, processedMesh.imported.buffers);
+        }
+        asset->bounds = processedMesh.bounds;
+        asset->occluder = std::move(processedMesh.occluder);
+        const std::shared_ptr<const MeshAsset> sharedAsset = std::move(asset);
+        const MaterialComponent material = createMaterialComponent(processedMesh.imported.material);
+
+        const auto& instances = processedMesh.imported.instances;
+        const auto meshEntities = scene.createEntities(instances.size());
+        auto& meshEntityUUIDs = scene.getComponent<ModelComponent>(state.modelEntityUUID).meshEntities;
+        meshEntityUUIDs.reserve(meshEntityUUIDs.size() + instances.size());
+        for (std::size_t i = 0; i < instances.size(); ++i) {
+            const auto meshEntityUUID = scene.getUUID(meshEntities[i]);
+            scene.addComponent<MeshComponent>(meshEntityUUID, MeshComponent{sharedAsset, true});
+            scene.addComponent<MaterialComponent>(meshEntityUUID, material);
+            // Placed by its node; the mesh's own transform stays identity
+            scene.addComponent<TransformComponent>(meshEntityUUID);
+            TransformSystem::setParent(scene, meshEntityUUID, state.nodeEntities[instances[i]]);
+            meshEntityUUIDs.push_back(meshEntityUUID);
+        }
+
+        state.uploadedMeshes++;
+    }
+
+    void ModelLoadingSystem::stageNodeEntities(ModelImportState& state) {
+        auto& staging = state.nodeStaging;
+        // Moving the model entity moves the whole model with a single dirty root
+        staging.addComponent<TransformComponent>(state.modelEntityUUID);
+
+        state.nodeEntities.reserve(state.nodes.size());
+        for (const auto& node : state.nodes) {
+            const auto nodeEntityUUID = staging.createEntity();
+            staging.addComponent<TransformComponent>(nodeEntityUUID, node.local);
+            // Parents precede their children, so the parent's UUID is already known
+            const UUID parentUUID = node.parent == ImportedNode::kNoParent ? state.modelEntityUUID
+                                                                           : state.nodeEntities[node.parent];
+            staging.defer([nodeEntityUUID, parentUUID](Scene& scene) {
+                TransformSystem::setParent(scene, nodeEntityUUID, parentUUID);
+            });
+            state.nodeEntities.push_back(nodeEntityUUID);
+        }
+    }
+
+    void ModelLoadingSystem::finishImports(Scene& scene) {
+        auto isFinished = [&scene](const std::shared_ptr<ModelImportState>& state) {
+            const auto status = state->status.load();
+            if (status == ModelImportStatus::Failed) {
+                spdlog::error("Failed to load model {}: {}", state->filepath, state->error);
+                // Meshes of the model that finished before another one failed may already be in the scene
+                if (scene.hasComponent<ModelComponent>(state->modelEntityUUID)) {
+                    for (const auto& meshEntityUUID : scene.getComponent<ModelComponent>(state->modelEntityUUID).meshEntities) {
+                        scene.destroyEntity(meshEntityUUID);
+                    }
+                }
+                for (const auto& nodeEntityUUID : state->nodeEntities) {
+                    scene.destroyEntity(nodeEntityUUID);
+                }
+                scene.destroyEntity(state->modelEntityUUID);
+                return true;
+            }
+            if (status == ModelImportStatus::Uploading && state->uploadedMeshes == state->totalMeshes) {
+                spdlog::info("Model {} loaded with UUID: {}", state->filepath, state->modelEntityUUID.toString());
+                state->status = ModelImportStatus::Completed;
+                TextureCache::instance().logStatistics();
+                return true;
+            }
+            return false;
+        };
+
+        const auto activeCount = activeImports_.size();
+        activeImports_.erase(std::remove_if(activeImports_.begin(), activeImports_.end(), isFinished),
+                             activeImports_.end());
+
+        if (activeImports_.size() != activeCount) {
+            // Prune textures released by models destroyed since the last import finished
+            TextureCache::instance().evictExpired();
+            MaterialUniformCache::instance().evictExpired();
+        }
+    }
+
+    void ModelLoadingSystem::processNode(const aiNode* node, const aiScene* aiScene, uint32_t parent,
+                                         std::vector<ImportedNode>& nodes,
+                                         std::vector<std::vector<uint32_t>>& meshInstances) {
         aiMatrix4x4 aiTransform = node->mTransformation;
         aiTransform.Transpose(); // Assimp uses row-major matrices, we need column-major for glm
 
-        glm::mat4 nodeTransform = parentTransform * glm::make_mat4(&aiTransform.a1);
+        glm::mat4 nodeTransform = glm::make_mat4(&aiTransform.a1);
 
         // Apply scaling only at the root node
         if (node == aiScene->mRootNode) {
@@ -53,132 +362,176 @@ namespace s3Dive {
             auto translationAdjustment = glm::vec3(0.0f, 0.0f, 0.0f); // Adjust as needed
             nodeTransform = glm::translate(nodeTransform, translationAdjustment);
         }
-        for (unsigned int i = 0; i < node->mNumMeshes; i++) {
-            const aiMesh* mesh = aiScene->mMeshes[node->mMeshes[i]];
-            MeshComponent meshComponent = processMesh(mesh);
-            MaterialComponent materialComponent = processMaterial(aiScene->mMaterials[mesh->mMaterialIndex]);
-
-            auto meshEntity = scene.createEntity();
-            auto meshEntityUUID = scene.getEntityUUID(meshEntity).value();
-            scene.addComponent<MeshComponent>(meshEntityUUID, std::move(meshComponent));
-            scene.addComponent<MaterialComponent>(meshEntityUUID, std::move(materialComponent));
-
-            // Extract translation, rotation, and scale from the nodeTransform
-            glm::vec3 translation;
-            glm::vec3 rotation;
-            glm::vec3 scale;
-            glm::quat orientation;
-            glm::vec3 skew;
-            glm::vec4 perspective;
-            glm::decompose(nodeTransform, scale, orientation, translation, skew, perspective);
-            rotation = glm::eulerAngles(orientation);
-
-            // Create TransformComponent with the applied transformation
-            scene.addComponent<TransformComponent>(meshEntityUUID, TransformComponent{
-                    translation,
-                    rotation,
-                    scale // Scale down the model
-            });
 
-            auto& modelComponent = scene.getComponent<ModelComponent>(modelEntityUUID);
-            modelComponent.meshEntities.push_back(meshEntityUUID);
+        // Only the node's own matrix is decomposed; parents are composed as matrices at runtime, so the shear
+        // that non-uniform scale picks up through a chain of rotated nodes is kept
+        glm::vec3 translation;
+        glm::vec3 scale;
+        glm::quat orientation;
+        glm::vec3 skew;
+        glm::vec4 perspective;
+        glm::decompose(nodeTransform, scale, orientation, translation, skew, perspective);
+        glm::vec3 rotation = glm::eulerAngles(orientation);
+
+        const auto nodeIndex = static_cast<uint32_t>(nodes.size());
+        nodes.push_back({parent, TransformComponent(translation, rotation, scale)});
+
+        for (unsigned int i = 0; i < node->mNumMeshes; i++) {
+            meshInstances[node->mMeshes[i]].push_back(nodeIndex);
         }
 
         for (unsigned int i = 0; i < node->mNumChildren; i++) {
-            processNode(scene, node->mChildren[i], aiScene, modelEntityUUID, nodeTransform);
+            processNode(node->mChildren[i], aiScene, nodeIndex, nodes, meshInstances);
         }
     }
-    MeshComponent ModelLoadingSystem::processMesh(const aiMesh* mesh) {
-        MeshComponent meshComponent;
+
+    InterleavedMeshData ModelLoadingSystem::processMesh(const aiMesh* mesh) {
+        InterleavedMeshData data;
 
         spdlog::info("Processing mesh: {}, Vertices: {}, Faces: {}",
                      mesh->mName.C_Str(), mesh->mNumVertices, mesh->mNumFaces);
 
-        meshComponent.vertices.reserve(mesh->mNumVertices);
+        data.vertexData.reserve(static_cast<std::size_t>(mesh->mNumVertices) * kInterleavedVertexFloats);
         for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
-            Vertex vertex{};
-            vertex.Position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
-
-            if (mesh->HasNormals()) {
-                vertex.Normal = glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z);
-            }
-
-            if (mesh->mTextureCoords[0]) {
-                vertex.TexCoords = glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
-            } else {
-                vertex.TexCoords = glm::vec2(0.0f, 0.0f);
-            }
-
-            meshComponent.vertices.push_back(vertex);
+            const aiVector3D& position = mesh->mVertices[i];
+            const aiVector3D normal = mesh->HasNormals() ? mesh->mNormals[i] : aiVector3D(0.0f, 0.0f, 0.0f);
+            const aiVector3D texCoords = mesh->mTextureCoords[0] ? mesh->mTextureCoords[0][i] : aiVector3D(0.0f, 0.0f, 0.0f);
+            data.vertexData.insert(data.vertexData.end(), {
+                    position.x, position.y, position.z,
+                    normal.x, normal.y, normal.z,
+                    texCoords.x, texCoords.y
+            });
         }
 
-        meshComponent.indices.reserve(mesh->mNumFaces * 3);
+        data.indices.reserve(static_cast<std::size_t>(mesh->mNumFaces) * 3);
         for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
             const aiFace& face = mesh->mFaces[i];
             for (unsigned int j = 0; j < face.mNumIndices; j++) {
-                meshComponent.indices.push_back(face.mIndices[j]);
+                data.indices.push_back(face.mIndices[j]);
             }
         }
 
-        initializeMeshComponent(meshComponent);
-
-        return meshComponent;
+        return data;
     }
 
-    MaterialComponent ModelLoadingSystem::processMaterial(const aiMaterial* material) const {
-        MaterialComponent materialComponent;
+    MaterialDescription ModelLoadingSystem::processMaterial(const aiMaterial* material,
+                                                            const std::filesystem::path& modelDirectory) {
+        MaterialDescription description;
 
         aiColor3D color;
         float shininess;
 
         if (material->Get(AI_MATKEY_COLOR_DIFFUSE, color) == AI_SUCCESS) {
-            materialComponent.albedo = glm::vec3(color.r, color.g, color.b);
+            description.albedo = glm::vec3(color.r, color.g, color.b);
         }
 
         if (material->Get(AI_MATKEY_SHININESS, shininess) == AI_SUCCESS) {
-            materialComponent.roughness = 1.0f - (shininess / 128.0f);
+            description.roughness = 1.0f - (shininess / 128.0f);
+        }
+
+        if (material->GetTextureCount(aiTextureType_DIFFUSE) > 0) {
+            aiString str;
+            material->GetTexture(aiTextureType_DIFFUSE, 0, &str);
+            description.diffuseTexturePath = resolveTexturePath(str.C_Str(), modelDirectory);
         }
 
-        materialComponent.diffuseTexture = loadMaterialTexture(material, aiTextureType_DIFFUSE);
+        return description;
+    }
+
+    std::string ModelLoadingSystem::resolveTexturePath(const std::string& texturePath,
+                                                       const std::filesystem::path& modelDirectory) {
+        // Texture paths are usually stored relative to the model file
+        const std::filesystem::path path(texturePath);
+        if (std::error_code error; path.is_relative() && std::filesystem::exists(modelDirectory / path, error)) {
+            return (modelDirectory / path).string();
+        }
+        return texturePath;
+    }
 
+    MaterialComponent ModelLoadingSystem::createMaterialComponent(const MaterialDescription& description) {
+        MaterialComponent materialComponent;
+        materialComponent.albedo = description.albedo;
+        materialComponent.roughness = description.roughness;
+        materialComponent.diffuseTexture = loadMaterialTexture(description.diffuseTexturePath);
+        // The uniform block is left to RenderSystem, which builds it when the component is added
         return materialComponent;
     }
 
-    std::shared_ptr<GLTexture> ModelLoadingSystem::loadMaterialTexture(const aiMaterial* mat, aiTextureType type) {
-        if (mat->GetTextureCount(type) > 0) {
-            aiString str;
-            mat->GetTexture(type, 0, &str);
-            std::string texturePath = str.C_Str();
-            return std::make_shared<GLTexture>(texturePath);
+    std::shared_ptr<GLTexture> ModelLoadingSystem::loadMaterialTexture(const std::string& texturePath) {
+        // Shared through the cache: the fallback is decoded once for every untextured mesh
+        return TextureCache::instance().load(texturePath.empty() ? "wall.jpg" : texturePath);
+    }
+
+    MeshBounds ModelLoadingSystem::computeBounds(const MeshBuffers& buffers) {
+        return computeMeshBounds(buffers.vertexData, buffers.vertexFloatCount / kInterleavedVertexFloats,
+                                 kInterleavedVertexFloats);
+    }
+
+    std::shared_ptr<const OccluderMesh> ModelLoadingSystem::buildOccluder(const MeshBuffers& buffers) {
+        // Dense meshes would cost more to rasterize than they save; they are still tested as occludees
+        constexpr std::size_t kMaxOccluderTriangles = 4096;
+        if (buffers.indexCount < 3 || buffers.indexCount / 3 > kMaxOccluderTriangles) {
+            return nullptr;
+        }
+
+        auto occluder = std::make_shared<OccluderMesh>();
+        const auto vertexCount = buffers.vertexFloatCount / kInterleavedVertexFloats;
+        occluder->positions.reserve(vertexCount);
+        for (std::size_t i = 0; i < vertexCount; ++i) {
+            const float* position = buffers.vertexData + i * kInterleavedVertexFloats;
+            occluder->positions.emplace_back(position[0], position[1], position[2]);
         }
-        return std::make_shared<GLTexture>("wall.jpg");
+        occluder->indices.assign(buffers.indices, buffers.indices + buffers.indexCount);
+        return occluder;
     }
 
-    void ModelLoadingSystem::initializeMeshComponent(MeshComponent& meshComponent) {
-        std::vector<float> vertexData;
-        vertexData.reserve(meshComponent.vertices.size() * 8);
-        for (const auto& vertex : meshComponent.vertices) {
-            vertexData.insert(vertexData.end(), {
-                    vertex.Position.x, vertex.Position.y, vertex.Position.z,
-                    vertex.Normal.x, vertex.Normal.y, vertex.Normal.z,
-                    vertex.TexCoords.x, vertex.TexCoords.y
-            });
+    void ModelLoadingSystem::initializeMeshAsset(MeshAsset& asset, const MeshBuffers& buffers) {
+        asset.geometry = GeometryArena::instance().allocate(
+                VertexFormat::Float,
+                buffers.vertexData, static_cast<GLuint>(buffers.vertexFloatCount / kInterleavedVertexFloats),
+                buffers.indices, GL_UNSIGNED_INT, static_cast<GLuint>(buffers.indexCount));
+    }
+
+    uint32_t ModelLoadingSystem::getCacheKeyFlags(const ImportJob& job) {
+        // Our optimizer stands in for Assimp's cache locality step, so its bit marks optimized caches
+        return kImportFlags | (job.optimization.enabled ? aiProcess_ImproveCacheLocality : 0u);
+    }
+
+    void ModelLoadingSystem::optimize(const ImportJob& job, InterleavedMeshData& mesh) {
+        if (job.optimization.enabled) {
+            logOptimizationReport(job, optimizeMesh(mesh, job.optimization));
         }
+    }
 
-        auto vertexBuffer = std::make_shared<GLVertexBuffer>(vertexData);
-        GLVertexBufferLayout layout;
-        layout.addVertexElement<float>(3); // Position
-        layout.addVertexElement<float>(3); // Normal
-        layout.addVertexElement<float>(2); // TexCoords
-        vertexBuffer->setLayout(layout);
+    void ModelLoadingSystem::logOptimizationReport(const ImportJob& job, const MeshOptimizationReport& report) {
+        spdlog::info("Optimized mesh of {}: ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+                     job.state->filepath,
+                     report.before.acmr, report.after.acmr,
+                     report.before.atvr, report.after.atvr);
+    }
 
-        meshComponent.vertexArray = std::make_shared<GLVertexArray>();
-        meshComponent.vertexArray->addVertexBuffer(vertexBuffer);
+    std::shared_ptr<const QuantizedMeshData> ModelLoadingSystem::quantize(const ImportJob& job, const MeshBuffers& buffers) {
+        if (!job.quantization.enabled) {
+            return nullptr;
+        }
+        return std::make_shared<const QuantizedMeshData>(quantizeMesh(buffers, job.quantization.normalEncoding));
+    }
 
-        auto indexBuffer = std::make_shared<GLIndexBuffer>(meshComponent.indices);
-        meshComponent.vertexArray->setIndexBuffer(indexBuffer);
+    void ModelLoadingSystem::initializeQuantizedMeshAsset(MeshAsset& asset, const QuantizedMeshData& quantized) {
+        const auto format = quantized.quantization.octahedralNormals ? VertexFormat::QuantizedOctahedral
+                                                                     : VertexFormat::QuantizedPacked;
+        const auto vertexCount = static_cast<GLuint>(quantized.vertices.size());
+        if (!quantized.indices16.empty()) {
+            asset.geometry = GeometryArena::instance().allocate(
+                    format, quantized.vertices.data(), vertexCount,
+                    quantized.indices16.data(), GL_UNSIGNED_SHORT, static_cast<GLuint>(quantized.indices16.size()));
+        } else {
+            asset.geometry = GeometryArena::instance().allocate(
+                    format, quantized.vertices.data(), vertexCount,
+                    quantized.indices32.data(), GL_UNSIGNED_INT, static_cast<GLuint>(quantized.indices32.size()));
+        }
 
-        meshComponent.isInitialized = true;
+        asset.quantization = quantized.quantization;
     }
 
 } // namespace s3Dive
@@ -4,34 +4,169 @@
 #ifndef THREEDIVE_MESHLOADINGSYSTEM_H
 #define THREEDIVE_MESHLOADINGSYSTEM_H
 
+#include <atomic>
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <optional>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
+#include "../core/thread_pool.h"
 #include "../platform/openGLRender/gl_texture.h"
 #include "../platform/openGLRender/gl_vertex_array.h"
 #include "../platform/openGLRender/gl_vertex_buffer.h"
 #include "system.h"
 #include "components.h"
+#include "MeshData.h"
+#include "MeshOptimizer.h"
+#include "MeshQuantization.h"
+#include "SceneStaging.h"
 
 namespace s3Dive {
 
-    class ModelLoadingSystem {
+    enum class ModelImportStatus {
+        Parsing,
+        Uploading,
+        Completed,
+        Failed
+    };
+
+    // Shared between the worker threads that parse a model and the render thread that uploads it.
+    struct ModelImportState {
+        std::string filepath;
+        UUID modelEntityUUID{0};
+        std::atomic<ModelImportStatus> status{ModelImportStatus::Parsing};
+        std::atomic<uint32_t> totalMeshes{0};
+        std::atomic<uint32_t> uploadedMeshes{0};
+        std::string error; // Written by the worker before status becomes Failed
+        std::vector<ImportedNode> nodes; // Written by the worker before the first mesh is queued for upload
+        std::vector<UUID> nodeEntities;  // One per node, staged by the worker along with nodes
+        SceneStaging nodeStaging;        // Merged into the scene on the render thread with the first mesh
+        std::promise<void> parsedPromise;
+        std::shared_future<void> parsed{parsedPromise.get_future().share()};
+        std::atomic<bool> parsedResolved{false}; // Claimed by whichever worker resolves parsedPromise
+    };
+
+    class ModelImportHandle {
+    public:
+        ModelImportHandle() = default;
+        explicit ModelImportHandle(std::shared_ptr<ModelImportState> state) : state_(std::move(state)) {}
+
+        [[nodiscard]] bool isValid() const noexcept { return state_ != nullptr; }
+        [[nodiscard]] ModelImportStatus getStatus() const noexcept { return state_->status.load(); }
+        [[nodiscard]] bool isDone() const noexcept;
+        [[nodiscard]] float getProgress() const noexcept;
+        [[nodiscard]] const UUID& getModelEntityUUID() const noexcept { return state_->modelEntityUUID; }
+        [[nodiscard]] const std::string& getError() const noexcept { return state_->error; }
+
+        // Blocks until every mesh is parsed on the workers; GL uploads still happen in ModelLoadingSystem::update
+        void waitParsed() const { state_->parsed.wait(); }
+
+    private:
+        std::shared_ptr<ModelImportState> state_;
+    };
+
+    class ModelLoadingSystem : public System {
     public:
+        // Import threads beside the JobSystem's workers. Imports and mesh tasks stay off the JobSystem: a frame
+        // waiting on a TaskGroup runs whatever job is queued, and one of these would stall it. Their heavy loops
+        // (native readers, optimization, quantization) fan out to the JobSystem, so a few threads are enough and
+        // the machine is not oversubscribed.
+        static constexpr std::size_t kDefaultWorkerCount = 2;
+
+        explicit ModelLoadingSystem(std::size_t workerCount = kDefaultWorkerCount);
+
+        // Returns immediately; meshes are parsed on the worker pool and appear in the scene as update() uploads them
+        ModelImportHandle loadModelAsync(Scene& scene, const std::string& filepath);
         void loadModel(Scene& scene, const std::string& filepath);
 
+        // Uploads finished meshes to the GPU and creates their entities; must run on the GL thread
+        void update(Scene& scene, float deltaTime) override;
+        void declareAccess(SystemAccess& access) const override { access.structural().mainThread(); }
+
+        void setUploadBudgetPerFrame(std::size_t meshCount) noexcept { uploadBudgetPerFrame_ = meshCount; }
+
+        // Applies to imports started afterwards; the mesh cache always keeps full-precision vertices
+        void setQuantizationSettings(const MeshQuantizationSettings& settings) noexcept { quantizationSettings_ = settings; }
+        // Reorders each mesh for the vertex cache and overdraw on the workers before it is uploaded or cached
+        void setOptimizationSettings(const MeshOptimizationSettings& settings) noexcept { optimizationSettings_ = settings; }
+
+        // Part of the mesh cache key; changing the post-processing steps invalidates existing caches
+        static constexpr unsigned int kImportFlags =
+                aiProcess_Triangulate |
+                aiProcess_FlipUVs |
+                aiProcess_CalcTangentSpace |
+                aiProcess_GenNormals |
+                aiProcess_JoinIdenticalVertices |
+                aiProcess_SortByPType;
+
     private:
-        MeshComponent processMesh(const aiMesh* mesh);
-        MaterialComponent processMaterial(const aiMaterial* material) const;
-        static std::shared_ptr<GLTexture> loadMaterialTexture(const aiMaterial* mat, aiTextureType type);
-        static void initializeMeshComponent(MeshComponent& meshComponent);
-
-        void processNode(Scene &scene,
-                         const aiNode *node,
-                         const aiScene *aiScene,
-                         const UUID &modelEntityUUID,
-                         const glm::mat4& parentTransform);
+        struct ProcessedMesh {
+            std::shared_ptr<ModelImportState> state;
+            ImportedMesh imported;
+            std::shared_ptr<const QuantizedMeshData> quantized; // Uploaded instead of imported.buffers when set
+            MeshBounds bounds;
+            std::shared_ptr<const OccluderMesh> occluder;
+        };
+
+        struct ImportJob {
+            std::shared_ptr<ModelImportState> state;
+            MeshQuantizationSettings quantization;
+            MeshOptimizationSettings optimization;
+            Assimp::Importer importer;
+            const aiScene* scene = nullptr;
+            std::vector<std::vector<uint32_t>> meshInstances; // Nodes per aiScene mesh index
+            std::vector<ImportedMesh> importedMeshes;                   // Collected for the mesh cache
+            std::optional<uint64_t> sourceHash;
+            std::atomic<uint32_t> pendingMeshes{0};
+        };
+
+        // Runs parseModel, failing the import on any exception
+        void importModel(const std::shared_ptr<ImportJob>& job);
+        void parseModel(const std::shared_ptr<ImportJob>& job);
+        void processMeshTask(const std::shared_ptr<ImportJob>& job, unsigned int meshIndex);
+        // Resolve parsed exactly once: the first of them to run wins, later calls do nothing. markParsed
+        // returns whether it won.
+        static bool markParsed(ModelImportState& state);
+        static void failImport(ModelImportState& state, std::string error);
+        void enqueueImportedModel(const std::shared_ptr<ImportJob>& job, ImportedModel&& model);
+        void uploadMesh(Scene& scene, ProcessedMesh& processedMesh) const;
+        // Records the imported node tree as entities under the model entity, to be merged with the first mesh
+        static void stageNodeEntities(ModelImportState& state);
+        void finishImports(Scene& scene);
+
+        static InterleavedMeshData processMesh(const aiMesh* mesh);
+        static MaterialDescription processMaterial(const aiMaterial* material, const std::filesystem::path& modelDirectory);
+        static std::string resolveTexturePath(const std::string& texturePath, const std::filesystem::path& modelDirectory);
+        static MeshBounds computeBounds(const MeshBuffers& buffers);
+        static std::shared_ptr<const OccluderMesh> buildOccluder(const MeshBuffers& buffers);
+        static MaterialComponent createMaterialComponent(const MaterialDescription& description);
+        static std::shared_ptr<GLTexture> loadMaterialTexture(const std::string& texturePath);
+        static uint32_t getCacheKeyFlags(const ImportJob& job);
+        static void optimize(const ImportJob& job, InterleavedMeshData& mesh);
+        static void logOptimizationReport(const ImportJob& job, const MeshOptimizationReport& report);
+        static std::shared_ptr<const QuantizedMeshData> quantize(const ImportJob& job, const MeshBuffers& buffers);
+        static void initializeMeshAsset(MeshAsset& asset, const MeshBuffers& buffers);
+        static void initializeQuantizedMeshAsset(MeshAsset& asset, const QuantizedMeshData& quantized);
+
+        static void processNode(const aiNode* node,
+                                const aiScene* aiScene,
+                                uint32_t parent,
+                                std::vector<ImportedNode>& nodes,
+                                std::vector<std::vector<uint32_t>>& meshInstances);
+
+        std::mutex processedMutex_;
+        std::vector<ProcessedMesh> processedMeshes_;
+        std::vector<std::shared_ptr<ModelImportState>> activeImports_;
+        std::size_t uploadBudgetPerFrame_ = 16;
+        MeshQuantizationSettings quantizationSettings_;
+        MeshOptimizationSettings optimizationSettings_;
+
+        // Declared last so workers are joined before the queues they push into are destroyed
+        ThreadPool threadPool_;
     };
 
 } // namespace s3Dive
 
-#endif //THREEDIVE_MESHLOADINGSYSTEM_H
\ No newline at end of file
+#endif //THREEDIVE_MESHLOADINGSYSTEM_H
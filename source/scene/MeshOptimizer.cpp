@@ -0,0 +1,454 @@
+#include "MeshOptimizer.h"
+#include "../core/parallel_for.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+
+namespace s3Dive {
+
+    namespace {
+
+        // Triangles per independently optimized block; large enough that block seams cost a negligible ACMR
+        constexpr std::size_t kBlockTriangles = 1u << 16;
+        constexpr uint32_t kUnused = UINT32_MAX;
+
+        static_assert(sizeof(Vertex) == kInterleavedVertexFloats * sizeof(float),
+                      "Vertex must match the interleaved layout so both can share the optimizer");
+
+        struct PositionView {
+            const float* data;
+            std::size_t stride; // In floats
+
+            [[nodiscard]] glm::vec3 operator[](unsigned int vertex) const {
+                const float* position = data + std::size_t{vertex} * stride;
+                return glm::vec3(position[0], position[1], position[2]);
+            }
+        };
+
+        // FIFO post-transform cache, the model both Tipsify and the ACMR figures assume
+        class CacheSimulator {
+        public:
+            CacheSimulator(std::size_t vertexCount, unsigned int cacheSize)
+                    : timestamps_(vertexCount, 0), cacheSize_(cacheSize), time_(cacheSize + 1) {}
+
+            // Returns how many of the triangle's vertices had to be transformed
+            unsigned int addTriangle(const unsigned int* triangle) {
+                unsigned int misses = 0;
+                for (std::size_t i = 0; i < 3; ++i) {
+                    uint32_t& timestamp = timestamps_[triangle[i]];
+                    if (time_ - timestamp > cacheSize_) {
+                        timestamp = time_++;
+                        ++misses;
+                    }
+                }
+                return misses;
+            }
+
+            void flush() { time_ += cacheSize_ + 1; }
+
+        private:
+            std::vector<uint32_t> timestamps_;
+            uint32_t cacheSize_;
+            uint32_t time_;
+        };
+
+        // Reorders a triangle list with Tipsify. indices are dense local ids below vertexCount. Triangle offsets
+        // where the fan had to restart from a dead end are appended to hardBoundaries, starting with 0.
+        std::vector<unsigned int> tipsify(const std::vector<unsigned int>& indices,
+                                          std::size_t vertexCount,
+                                          unsigned int cacheSize,
+                                          std::vector<std::size_t>& hardBoundaries) {
+            const std::size_t triangleCount = indices.size() / 3;
+
+            std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+            for (unsigned int vertex : indices) {
+                ++adjacencyOffsets[vertex + 1];
+            }
+            std::partial_sum(adjacencyOffsets.begin(), adjacencyOffsets.end(), adjacencyOffsets.begin());
+
+            std::vector<uint32_t> adjacency(indices.size());
+            std::vector<uint32_t> fillCursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (std::size_t triangle = 0; triangle < triangleCount; ++triangle) {
+                for (std::size_t corner = 0; corner < 3; ++corner) {
+                    adjacency[fillCursor[indices[triangle * 3 + corner]]++] = static_cast<uint32_t>(triangle);
+                }
+            }
+
+            std::vector<uint32_t> liveTriangles(vertexCount);
+            for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+                liveTriangles[vertex] = adjacencyOffsets[vertex + 1] - adjacencyOffsets[vertex];
+            }
+
+            std::vector<uint32_t> cacheTime(vertexCount, 0);
+            std::vector<bool> emitted(triangleCount, false);
+            std::vector<uint32_t> deadEndStack;
+            std::vector<uint32_t> candidates;
+            uint32_t timestamp = cacheSize + 1;
+            std::size_t scanCursor = 0;
+
+            auto skipDeadEnd = [&]() -> int64_t {
+                while (!deadEndStack.empty()) {
+                    const uint32_t vertex = deadEndStack.back();
+                    deadEndStack.pop_back();
+                    if (liveTriangles[vertex] > 0) {
+                        return vertex;
+                    }
+                }
+                for (; scanCursor < vertexCount; ++scanCursor) {
+                    if (liveTriangles[scanCursor] > 0) {
+                        return static_cast<int64_t>(scanCursor);
+                    }
+                }
+                return -1;
+            };
+
+            std::vector<unsigned int> output;
+            output.reserve(indices.size());
+            hardBoundaries.push_back(0);
+
+            int64_t fanVertex = skipDeadEnd();
+            while (fanVertex >= 0) {
+                candidates.clear();
+                const auto fan = static_cast<uint32_t>(fanVertex);
+                for (uint32_t a = adjacencyOffsets[fan]; a < adjacencyOffsets[fan + 1]; ++a) {
+                    const uint32_t triangle = adjacency[a];
+                    if (emitted[triangle]) {
+                        continue;
+                    }
+                    emitted[triangle] = true;
+                    for (std::size_t corner = 0; corner < 3; ++corner) {
+                        const unsigned int vertex = indices[std::size_t{triangle} * 3 + corner];
+                        output.push_back(vertex);
+                        deadEndStack.push_back(vertex);
+                        candidates.push_back(vertex);
+                        --liveTriangles[vertex];
+                        if (timestamp - cacheTime[vertex] > cacheSize) {
+                            cacheTime[vertex] = timestamp++;
+                        }
+                    }
+                }
+
+                // Prefer the candidate that stays in the cache longest while its remaining fan is emitted
+                int64_t nextVertex = -1;
+                int64_t bestPriority = -1;
+                for (uint32_t vertex : candidates) {
+                    if (liveTriangles[vertex] == 0) {
+                        continue;
+                    }
+                    int64_t priority = 0;
+                    if (timestamp - cacheTime[vertex] + 2 * liveTriangles[vertex] <= cacheSize) {
+                        priority = timestamp - cacheTime[vertex];
+                    }
+                    if (priority > bestPriority) {
+                        bestPriority = priority;
+                        nextVertex = vertex;
+                    }
+                }
+
+                if (nextVertex < 0) {
+                    nextVertex = skipDeadEnd();
+                    if (nextVertex >= 0 && output.size() / 3 > hardBoundaries.back()) {
+                        hardBoundaries.push_back(output.size() / 3);
+                    }
+                }
+                fanVertex = nextVertex;
+            }
+
+            return output;
+        }
+
+        // Splits each hard cluster further wherever the running ACMR is within threshold of the cluster's own
+        // ACMR, so clusters can be drawn in any order for a bounded cache cost (Sander et al., section 4)
+        std::vector<std::size_t> splitClusters(const std::vector<unsigned int>& indices,
+                                               const std::vector<std::size_t>& hardBoundaries,
+                                               std::size_t vertexCount,
+                                               const MeshOptimizationSettings& settings) {
+            const std::size_t triangleCount = indices.size() / 3;
+            CacheSimulator cache(vertexCount, settings.cacheSize);
+            std::vector<std::size_t> boundaries;
+
+            for (std::size_t h = 0; h < hardBoundaries.size(); ++h) {
+                const std::size_t begin = hardBoundaries[h];
+                const std::size_t end = h + 1 < hardBoundaries.size() ? hardBoundaries[h + 1] : triangleCount;
+
+                cache.flush();
+                std::size_t misses = 0;
+                for (std::size_t triangle = begin; triangle < end; ++triangle) {
+                    misses += cache.addTriangle(&indices[triangle * 3]);
+                }
+                const float threshold = settings.overdrawThreshold * static_cast<float>(misses) /
+                                        static_cast<float>(end - begin);
+
+                cache.flush();
+                boundaries.push_back(begin);
+                std::size_t clusterBegin = begin;
+                misses = 0;
+                for (std::size_t triangle = begin; triangle < end; ++triangle) {
+                    misses += cache.addTriangle(&indices[triangle * 3]);
+                    if (triangle + 1 < end &&
+                        static_cast<float>(misses) <= static_cast<float>(triangle + 1 - clusterBegin) * threshold) {
+                        boundaries.push_back(triangle + 1);
+                        clusterBegin = triangle + 1;
+                        misses = 0;
+                        cache.flush();
+                    }
+                }
+            }
+
+            return boundaries;
+        }
+
+        struct OptimizedBlock {
+            std::vector<unsigned int> indices;       // Global vertex ids
+            std::vector<std::size_t> clusterStarts;  // Triangle offsets within the block
+        };
+
+        OptimizedBlock optimizeBlock(const unsigned int* indices, std::size_t indexCount,
+                                     const MeshOptimizationSettings& settings) {
+            // Renumber the block's vertices densely so per-vertex state stays proportional to the block
+            std::vector<unsigned int> globalIds(indices, indices + indexCount);
+            std::sort(globalIds.begin(), globalIds.end());
+            globalIds.erase(std::unique(globalIds.begin(), globalIds.end()), globalIds.end());
+
+            std::vector<unsigned int> localIndices(indexCount);
+            for (std::size_t i = 0; i < indexCount; ++i) {
+                localIndices[i] = static_cast<unsigned int>(
+                        std::lower_bound(globalIds.begin(), globalIds.end(), indices[i]) - globalIds.begin());
+            }
+
+            std::vector<std::size_t> hardBoundaries;
+            auto reordered = tipsify(localIndices, globalIds.size(), settings.cacheSize, hardBoundaries);
+
+            OptimizedBlock block;
+            block.clusterStarts = splitClusters(reordered, hardBoundaries, globalIds.size(), settings);
+            for (auto& index : reordered) {
+                index = globalIds[index];
+            }
+            block.indices = std::move(reordered);
+            return block;
+        }
+
+        uint32_t expandBits(uint32_t value) {
+            value = (value * 0x00010001u) & 0xFF0000FFu;
+            value = (value * 0x00000101u) & 0x0F00F00Fu;
+            value = (value * 0x00000011u) & 0xC30C30C3u;
+            value = (value * 0x00000005u) & 0x49249249u;
+            return value;
+        }
+
+        // Sorts triangles along a Morton curve through their centroids so that each block covers a compact
+        // region; input order is arbitrary for merged or shuffled scans and would leave blocks disconnected
+        void sortTrianglesSpatially(std::vector<unsigned int>& indices, const PositionView& positions) {
+            const std::size_t triangleCount = indices.size() / 3;
+
+            glm::vec3 minimum(std::numeric_limits<float>::max());
+            glm::vec3 maximum(std::numeric_limits<float>::lowest());
+            for (unsigned int index : indices) {
+                minimum = glm::min(minimum, positions[index]);
+                maximum = glm::max(maximum, positions[index]);
+            }
+            const glm::vec3 extent = glm::max(maximum - minimum, glm::vec3(std::numeric_limits<float>::min()));
+
+            std::vector<std::pair<uint32_t, uint32_t>> keys(triangleCount);
+            parallelFor(triangleCount, 1u << 15, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t t = begin; t < end; ++t) {
+                    const glm::vec3 centroid = (positions[indices[t * 3]] +
+                                                positions[indices[t * 3 + 1]] +
+                                                positions[indices[t * 3 + 2]]) / 3.0f;
+                    const glm::vec3 cell = glm::clamp((centroid - minimum) / extent, 0.0f, 1.0f) * 1023.0f;
+                    const uint32_t code = (expandBits(static_cast<uint32_t>(cell.x)) << 2) |
+                                          (expandBits(static_cast<uint32_t>(cell.y)) << 1) |
+                                          expandBits(static_cast<uint32_t>(cell.z));
+                    keys[t] = {code, static_cast<uint32_t>(t)};
+                }
+            });
+            std::sort(keys.begin(), keys.end());
+
+            std::vector<unsigned int> sorted(indices.size());
+            for (std::size_t t = 0; t < triangleCount; ++t) {
+                std::copy_n(indices.begin() + static_cast<std::ptrdiff_t>(std::size_t{keys[t].second} * 3), 3,
+                            sorted.begin() + static_cast<std::ptrdiff_t>(t * 3));
+            }
+            indices.swap(sorted);
+        }
+
+        struct Cluster {
+            std::size_t block;
+            std::size_t firstTriangle;
+            std::size_t triangleCount;
+            float sortKey = 0.0f;
+        };
+
+        void reorderTriangles(std::vector<unsigned int>& indices, const PositionView& positions,
+                              const MeshOptimizationSettings& settings) {
+            const std::size_t triangleCount = indices.size() / 3;
+            const std::size_t blockCount = (triangleCount + kBlockTriangles - 1) / kBlockTriangles;
+            if (blockCount > 1) {
+                sortTrianglesSpatially(indices, positions);
+            }
+
+            std::vector<OptimizedBlock> blocks(blockCount);
+            parallelFor(blockCount, 1, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t b = begin; b < end; ++b) {
+                    const std::size_t firstTriangle = b * kBlockTriangles;
+                    const std::size_t blockTriangles = std::min(kBlockTriangles, triangleCount - firstTriangle);
+                    blocks[b] = optimizeBlock(indices.data() + firstTriangle * 3, blockTriangles * 3, settings);
+                }
+            });
+
+            std::vector<Cluster> clusters;
+            for (std::size_t b = 0; b < blockCount; ++b) {
+                const auto& starts = blocks[b].clusterStarts;
+                const std::size_t blockTriangles = blocks[b].indices.size() / 3;
+                for (std::size_t c = 0; c < starts.size(); ++c) {
+                    const std::size_t end = c + 1 < starts.size() ? starts[c + 1] : blockTriangles;
+                    clusters.push_back({b, starts[c], end - starts[c]});
+                }
+            }
+
+            // Area-weighted centroid of the whole mesh
+            glm::vec3 weightedCentroid(0.0f);
+            float totalArea = 0.0f;
+            for (std::size_t t = 0; t < triangleCount; ++t) {
+                const glm::vec3 p0 = positions[indices[t * 3]];
+                const glm::vec3 p1 = positions[indices[t * 3 + 1]];
+                const glm::vec3 p2 = positions[indices[t * 3 + 2]];
+                const float area = glm::length(glm::cross(p1 - p0, p2 - p0));
+                weightedCentroid += (p0 + p1 + p2) * (area / 3.0f);
+                totalArea += area;
+            }
+            const glm::vec3 meshCentroid = totalArea > 0.0f ? weightedCentroid / totalArea : glm::vec3(0.0f);
+
+            // Clusters facing away from the mesh centre tend to occlude the others, so they are drawn first
+            parallelFor(clusters.size(), 256, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t c = begin; c < end; ++c) {
+                    auto& cluster = clusters[c];
+                    const auto& blockIndices = blocks[cluster.block].indices;
+
+                    glm::vec3 centroid(0.0f);
+                    glm::vec3 normal(0.0f);
+                    float area = 0.0f;
+                    for (std::size_t t = cluster.firstTriangle; t < cluster.firstTriangle + cluster.triangleCount; ++t) {
+                        const glm::vec3 p0 = positions[blockIndices[t * 3]];
+                        const glm::vec3 p1 = positions[blockIndices[t * 3 + 1]];
+                        const glm::vec3 p2 = positions[blockIndices[t * 3 + 2]];
+                        const glm::vec3 faceNormal = glm::cross(p1 - p0, p2 - p0);
+                        const float faceArea = glm::length(faceNormal);
+                        centroid += (p0 + p1 + p2) * (faceArea / 3.0f);
+                        normal += faceNormal;
+                        area += faceArea;
+                    }
+
+                    const float normalLength = glm::length(normal);
+                    if (area > 0.0f && normalLength > 0.0f) {
+                        cluster.sortKey = glm::dot(centroid / area - meshCentroid, normal / normalLength);
+                    }
+                }
+            });
+
+            std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& lhs, const Cluster& rhs) {
+                return lhs.sortKey > rhs.sortKey;
+            });
+
+            auto output = indices.begin();
+            for (const auto& cluster : clusters) {
+                const auto first = blocks[cluster.block].indices.begin() +
+                                   static_cast<std::ptrdiff_t>(cluster.firstTriangle * 3);
+                output = std::copy(first, first + static_cast<std::ptrdiff_t>(cluster.triangleCount * 3), output);
+            }
+        }
+
+        // Renumbers vertices in first-use order; returns old-to-new ids (kUnused for unreferenced vertices)
+        std::vector<uint32_t> remapVertexFetch(std::vector<unsigned int>& indices, std::size_t vertexCount,
+                                               std::size_t& remappedCount) {
+            std::vector<uint32_t> remap(vertexCount, kUnused);
+            uint32_t nextVertex = 0;
+            for (auto& index : indices) {
+                if (remap[index] == kUnused) {
+                    remap[index] = nextVertex++;
+                }
+                index = remap[index];
+            }
+            remappedCount = nextVertex;
+            return remap;
+        }
+
+        template<typename T>
+        void applyVertexRemap(std::vector<T>& data, std::size_t elementsPerVertex,
+                              const std::vector<uint32_t>& remap, std::size_t remappedCount) {
+            std::vector<T> remapped(remappedCount * elementsPerVertex);
+            for (std::size_t vertex = 0; vertex < remap.size(); ++vertex) {
+                if (remap[vertex] != kUnused) {
+                    std::copy_n(data.begin() + static_cast<std::ptrdiff_t>(vertex * elementsPerVertex),
+                                elementsPerVertex,
+                                remapped.begin() + static_cast<std::ptrdiff_t>(std::size_t{remap[vertex]} * elementsPerVertex));
+                }
+            }
+            data.swap(remapped);
+        }
+
+        template<typename T>
+        MeshOptimizationReport optimize(std::vector<T>& vertexData, std::size_t elementsPerVertex,
+                                        const PositionView& positions, std::vector<unsigned int>& indices,
+                                        const MeshOptimizationSettings& settings) {
+            MeshOptimizationReport report;
+            const std::size_t vertexCount = vertexData.size() / elementsPerVertex;
+            report.before = analyzeVertexCache(indices.data(), indices.size(), vertexCount, settings.cacheSize);
+            if (indices.size() < 3 || vertexCount == 0) {
+                report.after = report.before;
+                return report;
+            }
+
+            reorderTriangles(indices, positions, settings);
+
+            std::size_t remappedCount = 0;
+            const auto remap = remapVertexFetch(indices, vertexCount, remappedCount);
+            applyVertexRemap(vertexData, elementsPerVertex, remap, remappedCount);
+
+            report.after = analyzeVertexCache(indices.data(), indices.size(), remappedCount, settings.cacheSize);
+            return report;
+        }
+
+    } // namespace
+
+    VertexCacheStatistics analyzeVertexCache(const unsigned int* indices, std::size_t indexCount,
+                                             std::size_t vertexCount, unsigned int cacheSize) {
+        VertexCacheStatistics statistics;
+        const std::size_t triangleCount = indexCount / 3;
+        if (triangleCount == 0) {
+            return statistics;
+        }
+
+        CacheSimulator cache(vertexCount, cacheSize);
+        std::vector<bool> referenced(vertexCount, false);
+        std::size_t misses = 0;
+        std::size_t referencedCount = 0;
+        for (std::size_t t = 0; t < triangleCount; ++t) {
+            misses += cache.addTriangle(indices + t * 3);
+            for (std::size_t corner = 0; corner < 3; ++corner) {
+                if (!referenced[indices[t * 3 + corner]]) {
+                    referenced[indices[t * 3 + corner]] = true;
+                    ++referencedCount;
+                }
+            }
+        }
+
+        statistics.acmr = static_cast<float>(misses) / static_cast<float>(triangleCount);
+        statistics.atvr = static_cast<float>(misses) / static_cast<float>(referencedCount);
+        return statistics;
+    }
+
+    MeshOptimizationReport optimizeMesh(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices,
+                                        const MeshOptimizationSettings& settings) {
+        const PositionView positions{vertices.empty() ? nullptr : &vertices[0].Position.x, kInterleavedVertexFloats};
+        return optimize(vertices, 1, positions, indices, settings);
+    }
+
+    MeshOptimizationReport optimizeMesh(InterleavedMeshData& mesh, const MeshOptimizationSettings& settings) {
+        const PositionView positions{mesh.vertexData.data(), kInterleavedVertexFloats};
+        return optimize(mesh.vertexData, kInterleavedVertexFloats, positions, mesh.indices, settings);
+    }
+
+} // namespace s3Dive
@@ -0,0 +1,42 @@
+#ifndef THREEDIVE_MESHOPTIMIZER_H
+#define THREEDIVE_MESHOPTIMIZER_H
+
+#include <cstddef>
+#include <vector>
+#include "components.h"
+#include "MeshData.h"
+
+namespace s3Dive {
+
+    struct MeshOptimizationSettings {
+        bool enabled = false;
+        unsigned int cacheSize = 16;     // Simulated post-transform FIFO, in vertices
+        float overdrawThreshold = 1.05f; // ACMR loss accepted in exchange for an overdraw-friendly cluster order
+    };
+
+    struct VertexCacheStatistics {
+        float acmr = 0.0f; // Average cache miss ratio: vertex shader invocations per triangle (3 is worst)
+        float atvr = 0.0f; // Average transform to vertex ratio: invocations per referenced vertex (1 is ideal)
+    };
+
+    struct MeshOptimizationReport {
+        VertexCacheStatistics before;
+        VertexCacheStatistics after;
+    };
+
+    [[nodiscard]] VertexCacheStatistics analyzeVertexCache(const unsigned int* indices,
+                                                           std::size_t indexCount,
+                                                           std::size_t vertexCount,
+                                                           unsigned int cacheSize);
+
+    // Tipsify vertex cache ordering (Sander, Nehab & Barczak 2007) followed by overdraw-aware cluster sorting
+    // and vertex fetch remapping. Large meshes are split into triangle blocks that are optimized in parallel.
+    // Vertices are renumbered in first-use order and unreferenced ones are dropped.
+    MeshOptimizationReport optimizeMesh(std::vector<Vertex>& vertices,
+                                        std::vector<unsigned int>& indices,
+                                        const MeshOptimizationSettings& settings);
+    MeshOptimizationReport optimizeMesh(InterleavedMeshData& mesh, const MeshOptimizationSettings& settings);
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_MESHOPTIMIZER_H
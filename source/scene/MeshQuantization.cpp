@@ -0,0 +1,141 @@
+#include "MeshQuantization.h"
+#include "../core/parallel_for.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace s3Dive {
+
+    namespace {
+
+        constexpr float kUnorm16Max = 65535.0f;
+        constexpr float kSnorm16Max = 32767.0f;
+        constexpr float kSnorm10Max = 511.0f;
+
+        uint32_t packSnorm16x2(const glm::vec2& value) {
+            const auto x = static_cast<int16_t>(std::lround(std::clamp(value.x, -1.0f, 1.0f) * kSnorm16Max));
+            const auto y = static_cast<int16_t>(std::lround(std::clamp(value.y, -1.0f, 1.0f) * kSnorm16Max));
+            // Component 0 is the low half-word, matching the attribute fetch on little-endian targets
+            return uint32_t{static_cast<uint16_t>(x)} | (uint32_t{static_cast<uint16_t>(y)} << 16);
+        }
+
+    } // namespace
+
+    uint16_t floatToHalf(float value) noexcept {
+        // Round-to-nearest-even conversion (F. Giesen, "float_to_half_fast3_rtne")
+        constexpr uint32_t kFloatInfinity = 255u << 23;
+        constexpr uint32_t kHalfOverflow = (127u + 16u) << 23;
+        constexpr uint32_t kSubnormalMagic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        const uint32_t sign = bits & 0x80000000u;
+        bits ^= sign;
+
+        uint32_t half;
+        if (bits >= kHalfOverflow) {
+            half = bits > kFloatInfinity ? 0x7E00u : 0x7C00u;
+        } else if (bits < (113u << 23)) {
+            // Subnormal or zero: let the FPU do the rounding by adding a magic number
+            float magic;
+            std::memcpy(&magic, &kSubnormalMagic, sizeof(magic));
+            float magnitude;
+            std::memcpy(&magnitude, &bits, sizeof(magnitude));
+            magnitude += magic;
+            std::memcpy(&bits, &magnitude, sizeof(bits));
+            half = bits - kSubnormalMagic;
+        } else {
+            const uint32_t mantissaOdd = (bits >> 13) & 1u;
+            bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xFFFu;
+            bits += mantissaOdd;
+            half = bits >> 13;
+        }
+
+        return static_cast<uint16_t>(half | (sign >> 16));
+    }
+
+    glm::vec2 encodeOctahedral(const glm::vec3& normal) noexcept {
+        const float l1Norm = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+        if (l1Norm == 0.0f) {
+            return glm::vec2(0.0f);
+        }
+
+        glm::vec2 encoded(normal.x / l1Norm, normal.y / l1Norm);
+        if (normal.z < 0.0f) {
+            // Fold the lower hemisphere over the diagonals
+            const float signX = encoded.x >= 0.0f ? 1.0f : -1.0f;
+            const float signY = encoded.y >= 0.0f ? 1.0f : -1.0f;
+            encoded = glm::vec2((1.0f - std::abs(encoded.y)) * signX, (1.0f - std::abs(encoded.x)) * signY);
+        }
+        return encoded;
+    }
+
+    uint32_t packSnorm2101010(const glm::vec3& normal) noexcept {
+        auto packComponent = [](float value) {
+            return static_cast<uint32_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * kSnorm10Max)) & 0x3FFu;
+        };
+        // w stays zero; the shader only reads xyz
+        return packComponent(normal.x) | (packComponent(normal.y) << 10) | (packComponent(normal.z) << 20);
+    }
+
+    QuantizedMeshData quantizeMesh(const MeshBuffers& buffers, NormalEncoding normalEncoding) {
+        const std::size_t vertexCount = buffers.vertexFloatCount / kInterleavedVertexFloats;
+        const float* source = buffers.vertexData;
+
+        glm::vec3 minimum(FLT_MAX);
+        glm::vec3 maximum(-FLT_MAX);
+        for (std::size_t v = 0; v < vertexCount; ++v) {
+            const glm::vec3 position(source[v * kInterleavedVertexFloats],
+                                     source[v * kInterleavedVertexFloats + 1],
+                                     source[v * kInterleavedVertexFloats + 2]);
+            minimum = glm::min(minimum, position);
+            maximum = glm::max(maximum, position);
+        }
+        if (vertexCount == 0) {
+            minimum = maximum = glm::vec3(0.0f);
+        }
+
+        QuantizedMeshData result;
+        const glm::vec3 extent = maximum - minimum;
+        result.quantization.positionOffset = minimum;
+        result.quantization.positionScale = extent;
+        result.quantization.octahedralNormals = normalEncoding == NormalEncoding::Octahedral;
+
+        glm::vec3 inverseExtent(0.0f);
+        for (int axis = 0; axis < 3; ++axis) {
+            inverseExtent[axis] = extent[axis] > 0.0f ? kUnorm16Max / extent[axis] : 0.0f;
+        }
+
+        result.vertices.resize(vertexCount);
+        parallelFor(vertexCount, 1u << 15, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t v = begin; v < end; ++v) {
+                const float* in = source + v * kInterleavedVertexFloats;
+                auto& out = result.vertices[v];
+
+                for (int axis = 0; axis < 3; ++axis) {
+                    const float scaled = (in[axis] - minimum[axis]) * inverseExtent[axis];
+                    out.position[axis] = static_cast<uint16_t>(std::lround(std::clamp(scaled, 0.0f, kUnorm16Max)));
+                }
+                out.position[3] = 0;
+
+                const glm::vec3 normal(in[3], in[4], in[5]);
+                out.normal = normalEncoding == NormalEncoding::Octahedral
+                             ? packSnorm16x2(encodeOctahedral(normal))
+                             : packSnorm2101010(normal);
+
+                out.texCoords[0] = floatToHalf(in[6]);
+                out.texCoords[1] = floatToHalf(in[7]);
+            }
+        });
+
+        if (vertexCount <= 0x10000) {
+            result.indices16.assign(buffers.indices, buffers.indices + buffers.indexCount);
+        } else {
+            result.indices32.assign(buffers.indices, buffers.indices + buffers.indexCount);
+        }
+
+        return result;
+    }
+
+} // namespace s3Dive
@@ -0,0 +1,48 @@
+#ifndef THREEDIVE_MESHQUANTIZATION_H
+#define THREEDIVE_MESHQUANTIZATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "MeshData.h"
+
+namespace s3Dive {
+
+    enum class NormalEncoding {
+        Octahedral,        // Two snorm16 components, decoded in the vertex shader
+        PackedSnorm2101010 // GL_INT_2_10_10_10_REV, read by the vertex fetch as a plain vec3
+    };
+
+    struct MeshQuantizationSettings {
+        bool enabled = false;
+        NormalEncoding normalEncoding = NormalEncoding::Octahedral;
+    };
+
+    // 16-byte vertex: positions as unorm16 relative to the mesh AABB (w is padding), a 4-byte normal and
+    // half-float texture coordinates. Half the size of the 32-byte interleaved float vertex.
+    struct QuantizedVertex {
+        uint16_t position[4];
+        uint32_t normal;
+        uint16_t texCoords[2];
+    };
+
+    static_assert(sizeof(QuantizedVertex) == 16, "QuantizedVertex must stay tightly packed");
+
+    struct QuantizedMeshData {
+        std::vector<QuantizedVertex> vertices;
+        std::vector<uint16_t> indices16; // Used when every index fits in 16 bits
+        std::vector<unsigned int> indices32;
+        VertexQuantization quantization;
+    };
+
+    // Quantizes interleaved float vertices; runs on the import workers
+    [[nodiscard]] QuantizedMeshData quantizeMesh(const MeshBuffers& buffers, NormalEncoding normalEncoding);
+
+    [[nodiscard]] uint16_t floatToHalf(float value) noexcept;
+    [[nodiscard]] glm::vec2 encodeOctahedral(const glm::vec3& normal) noexcept;
+    [[nodiscard]] uint32_t packSnorm2101010(const glm::vec3& normal) noexcept;
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_MESHQUANTIZATION_H
@@ -4,6 +4,7 @@
 
 #include <spdlog/spdlog.h>
 #include "Model.h"
+#include "../renderer/TextureCache.h"
 
 namespace s3Dive {
 
@@ -101,20 +102,8 @@ namespace s3Dive {
             aiString str;
             mat->GetTexture(type, i, &str);
 
-            // Check if texture was loaded before
-            bool skip = false;
-//            for (unsigned int j = 0; j < m_LoadedTextures.size(); j++) {
-//                if (std::strcmp(m_LoadedTextures[j]->getPath().data(), str.C_Str()) == 0) {
-//                    textures.push_back(m_LoadedTextures[j]);
-//                    skip = true;
-//                    break;
-//                }
-//            }
-            if (!skip) {
-                auto texture = std::make_shared<GLTexture>(m_Directory + '/' + str.C_Str());
-                textures.push_back(texture);
-                m_LoadedTextures.push_back(texture);
-            }
+            // Textures shared between meshes (or models) are decoded and uploaded once
+            textures.push_back(TextureCache::instance().load(m_Directory + '/' + str.C_Str()));
         }
         return textures;
     }
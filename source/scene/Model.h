@@ -42,7 +42,6 @@ namespace s3Dive {
 
             std::vector<Mesh> m_Meshes;
             std::string m_Directory;
-            std::vector<std::shared_ptr<GLTexture>> m_LoadedTextures;
         };
 
 } // s3Dive
@@ -0,0 +1,1048 @@
+#include "NativeMeshReader.h"
+#include "../core/mapped_file.h"
+#include "../core/parallel_for.h"
+#include "../core/text_parsing.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <spdlog/spdlog.h>
+
+namespace s3Dive {
+
+    namespace {
+
+        constexpr std::size_t kNormalOffset = 3;
+        constexpr std::size_t kTexCoordOffset = 6;
+
+        // Text is split into chunks of at least this many bytes before being parsed in parallel
+        constexpr std::size_t kTextChunkBytes = 1u << 20;
+
+        using VertexKey = std::array<uint32_t, 3>;
+        constexpr uint32_t kAbsentIndex = UINT32_MAX;
+
+        // Open-addressing (linear probing) map from a 96-bit vertex key to an output vertex index
+        class VertexWelder {
+        public:
+            explicit VertexWelder(std::size_t expectedVertices) {
+                std::size_t capacity = 16;
+                while (capacity < expectedVertices * 2) {
+                    capacity <<= 1;
+                }
+                keys_.resize(capacity);
+                values_.assign(capacity, kEmpty);
+                mask_ = capacity - 1;
+            }
+
+            // Returns the index stored for key, inserting candidateIndex when the key is new
+            std::pair<uint32_t, bool> insert(const VertexKey& key, uint32_t candidateIndex) {
+                if ((size_ + 1) * 2 > values_.size()) {
+                    grow();
+                }
+
+                std::size_t slot = hashKey(key) & mask_;
+                while (values_[slot] != kEmpty) {
+                    if (keys_[slot] == key) {
+                        return {values_[slot], false};
+                    }
+                    slot = (slot + 1) & mask_;
+                }
+
+                keys_[slot] = key;
+                values_[slot] = candidateIndex;
+                ++size_;
+                return {candidateIndex, true};
+            }
+
+        private:
+            static constexpr uint32_t kEmpty = UINT32_MAX;
+
+            static std::size_t hashKey(const VertexKey& key) noexcept {
+                uint64_t value = uint64_t{key[0]} * 0x9E3779B185EBCA87ULL;
+                value ^= (value >> 29) ^ (uint64_t{key[1]} * 0xC2B2AE3D27D4EB4FULL);
+                value ^= (value >> 32) ^ (uint64_t{key[2]} * 0x165667B19E3779F9ULL);
+                value ^= value >> 33;
+                value *= 0xFF51AFD7ED558CCDULL;
+                value ^= value >> 33;
+                return static_cast<std::size_t>(value);
+            }
+
+            void grow() {
+                std::vector<VertexKey> oldKeys = std::move(keys_);
+                std::vector<uint32_t> oldValues = std::move(values_);
+
+                keys_.assign(oldKeys.size() * 2, VertexKey{});
+                values_.assign(oldValues.size() * 2, kEmpty);
+                mask_ = values_.size() - 1;
+
+                for (std::size_t i = 0; i < oldValues.size(); ++i) {
+                    if (oldValues[i] == kEmpty) {
+                        continue;
+                    }
+                    std::size_t slot = hashKey(oldKeys[i]) & mask_;
+                    while (values_[slot] != kEmpty) {
+                        slot = (slot + 1) & mask_;
+                    }
+                    keys_[slot] = oldKeys[i];
+                    values_[slot] = oldValues[i];
+                }
+            }
+
+            std::vector<VertexKey> keys_;
+            std::vector<uint32_t> values_;
+            std::size_t mask_ = 0;
+            std::size_t size_ = 0;
+        };
+
+        VertexKey positionKey(const float* position) {
+            VertexKey key{};
+            for (std::size_t i = 0; i < 3; ++i) {
+                // Adding zero folds -0.0 into +0.0 so both weld together
+                const float value = position[i] + 0.0f;
+                std::memcpy(&key[i], &value, sizeof(float));
+            }
+            return key;
+        }
+
+        uint32_t appendVertex(InterleavedMeshData& mesh, const float* position, const float* normal, const float* texCoord) {
+            const auto index = static_cast<uint32_t>(mesh.vertexData.size() / kInterleavedVertexFloats);
+            mesh.vertexData.insert(mesh.vertexData.end(), {
+                    position[0], position[1], position[2],
+                    normal ? normal[0] : 0.0f, normal ? normal[1] : 0.0f, normal ? normal[2] : 0.0f,
+                    texCoord ? texCoord[0] : 0.0f, texCoord ? texCoord[1] : 0.0f
+            });
+            return index;
+        }
+
+        std::size_t textChunkCount(std::size_t byteCount) {
+            const std::size_t hardwareThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+            return std::clamp<std::size_t>(byteCount / kTextChunkBytes, 1, hardwareThreads * 4);
+        }
+
+        template<typename T>
+        std::vector<T> concatenate(std::vector<std::vector<T>>& parts) {
+            std::size_t total = 0;
+            for (const auto& part : parts) {
+                total += part.size();
+            }
+            std::vector<T> result;
+            result.reserve(total);
+            for (auto& part : parts) {
+                result.insert(result.end(), part.begin(), part.end());
+                std::vector<T>().swap(part);
+            }
+            return result;
+        }
+
+        // Welds a triangle soup; cornerAt(corner, position) writes the three position floats of a corner.
+        // Triangles that collapse after welding are dropped.
+        template<typename CornerReader>
+        void weldTriangleSoup(std::size_t triangleCount, CornerReader&& cornerAt, InterleavedMeshData& mesh) {
+            // Closed scans share each vertex between about six triangles
+            const std::size_t expectedVertices = triangleCount / 2 + 3;
+            VertexWelder welder(expectedVertices);
+            mesh.vertexData.reserve(expectedVertices * kInterleavedVertexFloats);
+            mesh.indices.reserve(triangleCount * 3);
+
+            for (std::size_t triangle = 0; triangle < triangleCount; ++triangle) {
+                std::array<uint32_t, 3> triangleIndices{};
+                for (std::size_t i = 0; i < 3; ++i) {
+                    float position[3];
+                    cornerAt(triangle * 3 + i, position);
+                    const auto nextIndex = static_cast<uint32_t>(mesh.vertexData.size() / kInterleavedVertexFloats);
+                    const auto [index, inserted] = welder.insert(positionKey(position), nextIndex);
+                    if (inserted) {
+                        appendVertex(mesh, position, nullptr, nullptr);
+                    }
+                    triangleIndices[i] = index;
+                }
+
+                if (triangleIndices[0] != triangleIndices[1] &&
+                    triangleIndices[1] != triangleIndices[2] &&
+                    triangleIndices[0] != triangleIndices[2]) {
+                    mesh.indices.insert(mesh.indices.end(), triangleIndices.begin(), triangleIndices.end());
+                }
+            }
+        }
+
+        // Area-weighted vertex normals from the triangle list
+        void computeSmoothNormals(InterleavedMeshData& mesh) {
+            float* vertices = mesh.vertexData.data();
+            const std::size_t vertexCount = mesh.vertexData.size() / kInterleavedVertexFloats;
+
+            for (std::size_t v = 0; v < vertexCount; ++v) {
+                std::fill_n(vertices + v * kInterleavedVertexFloats + kNormalOffset, 3, 0.0f);
+            }
+
+            for (std::size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+                float* p0 = vertices + std::size_t{mesh.indices[i]} * kInterleavedVertexFloats;
+                float* p1 = vertices + std::size_t{mesh.indices[i + 1]} * kInterleavedVertexFloats;
+                float* p2 = vertices + std::size_t{mesh.indices[i + 2]} * kInterleavedVertexFloats;
+
+                const float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+                const float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+                // Unnormalized cross product, so larger triangles weigh more
+                const float faceNormal[3] = {
+                        e1[1] * e2[2] - e1[2] * e2[1],
+                        e1[2] * e2[0] - e1[0] * e2[2],
+                        e1[0] * e2[1] - e1[1] * e2[0]};
+
+                for (float* corner : {p0, p1, p2}) {
+                    corner[kNormalOffset] += faceNormal[0];
+                    corner[kNormalOffset + 1] += faceNormal[1];
+                    corner[kNormalOffset + 2] += faceNormal[2];
+                }
+            }
+
+            parallelFor(vertexCount, 1u << 16, [vertices](std::size_t begin, std::size_t end) {
+                for (std::size_t v = begin; v < end; ++v) {
+                    float* normal = vertices + v * kInterleavedVertexFloats + kNormalOffset;
+                    const float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+                    if (length > 0.0f) {
+                        normal[0] /= length;
+                        normal[1] /= length;
+                        normal[2] /= length;
+                    } else {
+                        normal[0] = 0.0f;
+                        normal[1] = 0.0f;
+                        normal[2] = 1.0f;
+                    }
+                }
+            });
+        }
+
+        const char* textBegin(const MappedFile& file) {
+            return reinterpret_cast<const char*>(file.data());
+        }
+
+        const char* textEnd(const MappedFile& file) {
+            return reinterpret_cast<const char*>(file.data()) + file.size();
+        }
+
+        // ---------------------------------------------------------------- STL
+
+        constexpr std::size_t kStlHeaderBytes = 84;
+        constexpr std::size_t kStlTriangleBytes = 50;
+
+        bool isBinaryStl(const MappedFile& file) {
+            if (file.size() < kStlHeaderBytes) {
+                return false;
+            }
+            // "solid" is not a reliable ASCII marker, many exporters write it into binary headers too
+            uint32_t triangleCount = 0;
+            std::memcpy(&triangleCount, file.data() + 80, sizeof(triangleCount));
+            return kStlHeaderBytes + uint64_t{triangleCount} * kStlTriangleBytes == file.size();
+        }
+
+        std::optional<InterleavedMeshData> readBinaryStl(const MappedFile& file) {
+            uint32_t triangleCount = 0;
+            std::memcpy(&triangleCount, file.data() + 80, sizeof(triangleCount));
+            const std::byte* records = file.data() + kStlHeaderBytes;
+
+            InterleavedMeshData mesh;
+            weldTriangleSoup(triangleCount, [records](std::size_t corner, float* position) {
+                // Each record: facet normal (12 bytes), three vertices (36 bytes), attribute byte count (2 bytes)
+                std::memcpy(position, records + (corner / 3) * kStlTriangleBytes + 12 + (corner % 3) * 12, 12);
+            }, mesh);
+            computeSmoothNormals(mesh);
+            return mesh;
+        }
+
+        std::optional<InterleavedMeshData> readAsciiStl(const MappedFile& file) {
+            const char* last = textEnd(file);
+            const auto chunks = text::splitLines(textBegin(file), last, textChunkCount(file.size()));
+
+            std::vector<std::vector<float>> chunkCorners(chunks.size() - 1);
+            std::atomic<bool> failed{false};
+
+            parallelFor(chunkCorners.size(), 1, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t chunk = begin; chunk < end; ++chunk) {
+                    auto& corners = chunkCorners[chunk];
+                    for (const char* line = chunks[chunk]; line != chunks[chunk + 1];) {
+                        const char* lineEnd = text::nextLine(line, chunks[chunk + 1]);
+                        const char* cursor = text::skipSpaces(line, lineEnd);
+                        if (text::isKeyword(cursor, lineEnd, "vertex")) {
+                            cursor += 6;
+                            float position[3];
+                            for (float& value : position) {
+                                cursor = cursor ? text::parseFloat(cursor, lineEnd, value) : nullptr;
+                            }
+                            if (!cursor) {
+                                failed = true;
+                                return;
+                            }
+                            corners.insert(corners.end(), position, position + 3);
+                        }
+                        line = lineEnd;
+                    }
+                }
+            });
+
+            std::vector<float> corners = concatenate(chunkCorners);
+            if (failed || corners.empty() || corners.size() % 9 != 0) {
+                return std::nullopt;
+            }
+
+            InterleavedMeshData mesh;
+            weldTriangleSoup(corners.size() / 9, [&corners](std::size_t corner, float* position) {
+                std::memcpy(position, corners.data() + corner * 3, 3 * sizeof(float));
+            }, mesh);
+            computeSmoothNormals(mesh);
+            return mesh;
+        }
+
+        std::optional<InterleavedMeshData> readStl(const MappedFile& file) {
+            return isBinaryStl(file) ? readBinaryStl(file) : readAsciiStl(file);
+        }
+
+        // ---------------------------------------------------------------- PLY
+
+        enum class PlyFormat {
+            Ascii,
+            BinaryLittleEndian,
+            BinaryBigEndian
+        };
+
+        enum class PlyType {
+            Int8,
+            UInt8,
+            Int16,
+            UInt16,
+            Int32,
+            UInt32,
+            Float32,
+            Float64,
+            Invalid
+        };
+
+        struct PlyProperty {
+            std::string name;
+            PlyType type = PlyType::Invalid;
+            bool isList = false;
+            PlyType countType = PlyType::Invalid;
+        };
+
+        struct PlyElement {
+            std::string name;
+            std::size_t count = 0;
+            std::vector<PlyProperty> properties;
+        };
+
+        struct PlyHeader {
+            PlyFormat format = PlyFormat::Ascii;
+            std::vector<PlyElement> elements;
+            const char* body = nullptr;
+        };
+
+        PlyType parsePlyType(std::string_view name) {
+            if (name == "char" || name == "int8") return PlyType::Int8;
+            if (name == "uchar" || name == "uint8") return PlyType::UInt8;
+            if (name == "short" || name == "int16") return PlyType::Int16;
+            if (name == "ushort" || name == "uint16") return PlyType::UInt16;
+            if (name == "int" || name == "int32") return PlyType::Int32;
+            if (name == "uint" || name == "uint32") return PlyType::UInt32;
+            if (name == "float" || name == "float32") return PlyType::Float32;
+            if (name == "double" || name == "float64") return PlyType::Float64;
+            return PlyType::Invalid;
+        }
+
+        std::size_t plyTypeSize(PlyType type) {
+            switch (type) {
+                case PlyType::Int8:
+                case PlyType::UInt8:
+                    return 1;
+                case PlyType::Int16:
+                case PlyType::UInt16:
+                    return 2;
+                case PlyType::Int32:
+                case PlyType::UInt32:
+                case PlyType::Float32:
+                    return 4;
+                case PlyType::Float64:
+                    return 8;
+                default:
+                    return 0;
+            }
+        }
+
+        template<typename T>
+        T loadBinary(const std::byte* data, bool swapBytes) {
+            std::array<std::byte, sizeof(T)> bytes{};
+            std::memcpy(bytes.data(), data, sizeof(T));
+            if (swapBytes) {
+                std::reverse(bytes.begin(), bytes.end());
+            }
+            T value;
+            std::memcpy(&value, bytes.data(), sizeof(T));
+            return value;
+        }
+
+        double readPlyValue(const std::byte* data, PlyType type, bool swapBytes) {
+            switch (type) {
+                case PlyType::Int8: return loadBinary<int8_t>(data, swapBytes);
+                case PlyType::UInt8: return loadBinary<uint8_t>(data, swapBytes);
+                case PlyType::Int16: return loadBinary<int16_t>(data, swapBytes);
+                case PlyType::UInt16: return loadBinary<uint16_t>(data, swapBytes);
+                case PlyType::Int32: return loadBinary<int32_t>(data, swapBytes);
+                case PlyType::UInt32: return loadBinary<uint32_t>(data, swapBytes);
+                case PlyType::Float32: return loadBinary<float>(data, swapBytes);
+                case PlyType::Float64: return loadBinary<double>(data, swapBytes);
+                default: return 0.0;
+            }
+        }
+
+        std::vector<std::string_view> splitTokens(const char* first, const char* last) {
+            std::vector<std::string_view> tokens;
+            while (true) {
+                first = text::skipSpaces(first, last);
+                if (first == last || *first == '\n') {
+                    return tokens;
+                }
+                const char* tokenEnd = first;
+                while (tokenEnd != last && !std::isspace(static_cast<unsigned char>(*tokenEnd))) {
+                    ++tokenEnd;
+                }
+                tokens.emplace_back(first, static_cast<std::size_t>(tokenEnd - first));
+                first = tokenEnd;
+            }
+        }
+
+        std::optional<PlyHeader> parsePlyHeader(const char* first, const char* last) {
+            if (!text::startsWith(first, last, "ply")) {
+                return std::nullopt;
+            }
+
+            PlyHeader header;
+            bool hasFormat = false;
+            for (const char* line = text::nextLine(first, last); line != last;) {
+                const char* lineEnd = text::nextLine(line, last);
+                const auto tokens = splitTokens(line, lineEnd);
+                line = lineEnd;
+
+                if (tokens.empty() || tokens[0] == "comment" || tokens[0] == "obj_info") {
+                    continue;
+                }
+                if (tokens[0] == "end_header") {
+                    header.body = line;
+                    return hasFormat ? std::optional<PlyHeader>(std::move(header)) : std::nullopt;
+                }
+                if (tokens[0] == "format" && tokens.size() >= 2) {
+                    hasFormat = true;
+                    if (tokens[1] == "ascii") {
+                        header.format = PlyFormat::Ascii;
+                    } else if (tokens[1] == "binary_little_endian") {
+                        header.format = PlyFormat::BinaryLittleEndian;
+                    } else if (tokens[1] == "binary_big_endian") {
+                        header.format = PlyFormat::BinaryBigEndian;
+                    } else {
+                        return std::nullopt;
+                    }
+                } else if (tokens[0] == "element" && tokens.size() >= 3) {
+                    int64_t count = 0;
+                    if (!text::parseInt(tokens[2].data(), tokens[2].data() + tokens[2].size(), count) || count < 0) {
+                        return std::nullopt;
+                    }
+                    header.elements.push_back({std::string(tokens[1]), static_cast<std::size_t>(count), {}});
+                } else if (tokens[0] == "property" && !header.elements.empty()) {
+                    PlyProperty property;
+                    if (tokens.size() >= 5 && tokens[1] == "list") {
+                        property.isList = true;
+                        property.countType = parsePlyType(tokens[2]);
+                        property.type = parsePlyType(tokens[3]);
+                        property.name = std::string(tokens[4]);
+                    } else if (tokens.size() >= 3) {
+                        property.type = parsePlyType(tokens[1]);
+                        property.name = std::string(tokens[2]);
+                    }
+                    if (property.type == PlyType::Invalid || (property.isList && property.countType == PlyType::Invalid)) {
+                        return std::nullopt;
+                    }
+                    header.elements.back().properties.push_back(std::move(property));
+                }
+            }
+            return std::nullopt;
+        }
+
+        // Where each interesting vertex property lives in a record, or -1 when absent
+        struct PlyVertexLayout {
+            std::array<int, 3> position{-1, -1, -1};
+            std::array<int, 3> normal{-1, -1, -1};
+            std::array<int, 2> texCoord{-1, -1};
+
+            [[nodiscard]] bool hasNormals() const { return normal[0] >= 0 && normal[1] >= 0 && normal[2] >= 0; }
+            [[nodiscard]] bool hasTexCoords() const { return texCoord[0] >= 0 && texCoord[1] >= 0; }
+        };
+
+        std::optional<PlyVertexLayout> findVertexLayout(const PlyElement& element) {
+            PlyVertexLayout layout;
+            for (std::size_t i = 0; i < element.properties.size(); ++i) {
+                const auto& property = element.properties[i];
+                if (property.isList) {
+                    return std::nullopt;
+                }
+                const auto& name = property.name;
+                const int index = static_cast<int>(i);
+                if (name == "x") layout.position[0] = index;
+                else if (name == "y") layout.position[1] = index;
+                else if (name == "z") layout.position[2] = index;
+                else if (name == "nx") layout.normal[0] = index;
+                else if (name == "ny") layout.normal[1] = index;
+                else if (name == "nz") layout.normal[2] = index;
+                else if (name == "u" || name == "s" || name == "texture_u" || name == "texture_s") layout.texCoord[0] = index;
+                else if (name == "v" || name == "t" || name == "texture_v" || name == "texture_t") layout.texCoord[1] = index;
+            }
+            if (layout.position[0] < 0 || layout.position[1] < 0 || layout.position[2] < 0) {
+                return std::nullopt;
+            }
+            return layout;
+        }
+
+        int findFaceIndexProperty(const PlyElement& element) {
+            for (std::size_t i = 0; i < element.properties.size(); ++i) {
+                const auto& property = element.properties[i];
+                if (property.isList && (property.name == "vertex_indices" || property.name == "vertex_index")) {
+                    return static_cast<int>(i);
+                }
+            }
+            return -1;
+        }
+
+        void writePlyVertex(float* out, const PlyVertexLayout& layout, const double* values) {
+            for (std::size_t i = 0; i < 3; ++i) {
+                out[i] = static_cast<float>(values[layout.position[i]]);
+                out[kNormalOffset + i] = layout.hasNormals() ? static_cast<float>(values[layout.normal[i]]) : 0.0f;
+            }
+            for (std::size_t i = 0; i < 2; ++i) {
+                out[kTexCoordOffset + i] = layout.hasTexCoords() ? static_cast<float>(values[layout.texCoord[i]]) : 0.0f;
+            }
+        }
+
+        // Appends a polygon as a triangle fan; false when an index is out of range
+        bool appendPolygon(std::vector<unsigned int>& indices, const int64_t* polygon, std::size_t cornerCount, std::size_t vertexCount) {
+            for (std::size_t i = 0; i < cornerCount; ++i) {
+                if (polygon[i] < 0 || static_cast<std::size_t>(polygon[i]) >= vertexCount) {
+                    return false;
+                }
+            }
+            for (std::size_t i = 2; i < cornerCount; ++i) {
+                indices.insert(indices.end(), {
+                        static_cast<unsigned int>(polygon[0]),
+                        static_cast<unsigned int>(polygon[i - 1]),
+                        static_cast<unsigned int>(polygon[i])});
+            }
+            return true;
+        }
+
+        // Smallest size a binary record of element can have: its scalars plus the count of every list. Never 0,
+        // so header counts can be checked against the bytes left before anything is allocated for them.
+        std::size_t minimumBinaryRecordSize(const PlyElement& element) {
+            std::size_t size = 0;
+            for (const auto& property : element.properties) {
+                size += plyTypeSize(property.isList ? property.countType : property.type);
+            }
+            return std::max<std::size_t>(size, 1);
+        }
+
+        // Reads the length of the list at cursor and moves past it. Fails on a count that is negative, or whose
+        // items would run past last; the count is compared as read, before any conversion to an unsigned size.
+        std::optional<std::size_t> readPlyListLength(const PlyProperty& property, const std::byte*& cursor,
+                                                     const std::byte* last, bool swapBytes) {
+            const std::size_t countSize = plyTypeSize(property.countType);
+            if (countSize == 0 || static_cast<std::size_t>(last - cursor) < countSize) {
+                return std::nullopt;
+            }
+            const double count = readPlyValue(cursor, property.countType, swapBytes);
+            cursor += countSize;
+
+            const std::size_t itemSize = std::max<std::size_t>(plyTypeSize(property.type), 1);
+            const std::size_t maxCount = static_cast<std::size_t>(last - cursor) / itemSize;
+            if (!(count >= 0.0) || count > static_cast<double>(maxCount)) {
+                return std::nullopt;
+            }
+            return static_cast<std::size_t>(count);
+        }
+
+        // Walks one binary record of element; returns the position after it, or nullptr past the end of data
+        const std::byte* skipBinaryRecord(const PlyElement& element, const std::byte* cursor, const std::byte* last, bool swapBytes) {
+            for (const auto& property : element.properties) {
+                if (property.isList) {
+                    const auto count = readPlyListLength(property, cursor, last, swapBytes);
+                    if (!count) {
+                        return nullptr;
+                    }
+                    cursor += *count * plyTypeSize(property.type);
+                } else {
+                    const std::size_t size = plyTypeSize(property.type);
+                    if (static_cast<std::size_t>(last - cursor) < size) {
+                        return nullptr;
+                    }
+                    cursor += size;
+                }
+            }
+            return cursor;
+        }
+
+        std::optional<InterleavedMeshData> readBinaryPlyBody(const PlyHeader& header, const std::byte* cursor, const std::byte* last) {
+            const bool swapBytes = header.format == PlyFormat::BinaryBigEndian;
+            InterleavedMeshData mesh;
+            std::size_t vertexCount = 0;
+            bool hasNormals = false;
+            bool hasVertices = false;
+
+            for (const auto& element : header.elements) {
+                if (element.name == "vertex") {
+                    auto layout = findVertexLayout(element);
+                    if (!layout) {
+                        return std::nullopt;
+                    }
+
+                    // Scalar-only records have a fixed stride, so vertices can be decoded in parallel in place
+                    std::vector<std::size_t> offsets;
+                    std::size_t stride = 0;
+                    for (const auto& property : element.properties) {
+                        offsets.push_back(stride);
+                        stride += plyTypeSize(property.type);
+                    }
+                    if (static_cast<std::size_t>(last - cursor) / std::max<std::size_t>(stride, 1) < element.count) {
+                        return std::nullopt;
+                    }
+
+                    vertexCount = element.count;
+                    hasVertices = true;
+                    hasNormals = layout->hasNormals();
+                    mesh.vertexData.resize(vertexCount * kInterleavedVertexFloats);
+
+                    const std::byte* records = cursor;
+                    parallelFor(vertexCount, 1u << 15, [&](std::size_t begin, std::size_t end) {
+                        std::vector<double> values(element.properties.size());
+                        for (std::size_t v = begin; v < end; ++v) {
+                            const std::byte* record = records + v * stride;
+                            for (std::size_t p = 0; p < values.size(); ++p) {
+                                values[p] = readPlyValue(record + offsets[p], element.properties[p].type, swapBytes);
+                            }
+                            writePlyVertex(mesh.vertexData.data() + v * kInterleavedVertexFloats, *layout, values.data());
+                        }
+                    });
+                    cursor += vertexCount * stride;
+                } else if (element.name == "face" && hasVertices && findFaceIndexProperty(element) >= 0) {
+                    const int indexProperty = findFaceIndexProperty(element);
+                    if (static_cast<std::size_t>(last - cursor) / minimumBinaryRecordSize(element) < element.count) {
+                        return std::nullopt;
+                    }
+                    mesh.indices.reserve(element.count * 3);
+                    std::vector<int64_t> polygon;
+
+                    // Records are variable length, so faces are walked sequentially
+                    for (std::size_t f = 0; f < element.count; ++f) {
+                        for (std::size_t p = 0; p < element.properties.size(); ++p) {
+                            const auto& property = element.properties[p];
+                            if (!property.isList) {
+                                cursor += plyTypeSize(property.type);
+                                if (cursor > last) {
+                                    return std::nullopt;
+                                }
+                                continue;
+                            }
+
+                            const std::size_t itemSize = plyTypeSize(property.type);
+                            const auto listLength = readPlyListLength(property, cursor, last, swapBytes);
+                            if (!listLength) {
+                                return std::nullopt;
+                            }
+                            const std::size_t count = *listLength;
+
+                            if (static_cast<int>(p) == indexProperty) {
+                                polygon.resize(count);
+                                for (std::size_t i = 0; i < count; ++i) {
+                                    polygon[i] = static_cast<int64_t>(readPlyValue(cursor + i * itemSize, property.type, swapBytes));
+                                }
+                                if (!appendPolygon(mesh.indices, polygon.data(), count, vertexCount)) {
+                                    return std::nullopt;
+                                }
+                            }
+                            cursor += count * itemSize;
+                        }
+                    }
+                } else {
+                    if (static_cast<std::size_t>(last - cursor) / minimumBinaryRecordSize(element) < element.count) {
+                        return std::nullopt;
+                    }
+                    for (std::size_t i = 0; i < element.count; ++i) {
+                        cursor = skipBinaryRecord(element, cursor, last, swapBytes);
+                        if (!cursor) {
+                            return std::nullopt;
+                        }
+                    }
+                }
+            }
+
+            if (!hasNormals) {
+                computeSmoothNormals(mesh);
+            }
+            return mesh;
+        }
+
+        // Returns the position after count lines starting at first, or nullptr if the text ends early
+        const char* skipLines(const char* first, const char* last, std::size_t count) {
+            for (std::size_t i = 0; i < count; ++i) {
+                if (first == last) {
+                    return nullptr;
+                }
+                first = text::nextLine(first, last);
+            }
+            return first;
+        }
+
+        // Parses one ASCII record into values; list properties other than indexProperty are skipped
+        const char* parseAsciiRecord(const PlyElement& element, const char* cursor, const char* lineEnd,
+                                     double* values, int indexProperty, std::vector<int64_t>& polygon) {
+            for (std::size_t p = 0; p < element.properties.size() && cursor; ++p) {
+                const auto& property = element.properties[p];
+                if (!property.isList) {
+                    float value = 0.0f;
+                    cursor = text::parseFloat(cursor, lineEnd, value);
+                    if (values) {
+                        values[p] = value;
+                    }
+                    continue;
+                }
+
+                int64_t count = 0;
+                cursor = text::parseInt(cursor, lineEnd, count);
+                if (!cursor || count < 0) {
+                    return nullptr;
+                }
+                const bool isIndexList = static_cast<int>(p) == indexProperty;
+                if (isIndexList) {
+                    polygon.resize(static_cast<std::size_t>(count));
+                }
+                // Integer items are read as integers: indices past 2^24 do not survive a trip through float
+                const bool isIntegerList = property.type != PlyType::Float32 && property.type != PlyType::Float64;
+                for (int64_t i = 0; i < count && cursor; ++i) {
+                    int64_t value = 0;
+                    if (isIntegerList) {
+                        cursor = text::parseInt(cursor, lineEnd, value);
+                    } else {
+                        float item = 0.0f;
+                        cursor = text::parseFloat(cursor, lineEnd, item);
+                        value = static_cast<int64_t>(item);
+                    }
+                    if (isIndexList) {
+                        polygon[static_cast<std::size_t>(i)] = value;
+                    }
+                }
+            }
+            return cursor;
+        }
+
+        std::optional<InterleavedMeshData> readAsciiPlyBody(const PlyHeader& header, const char* cursor, const char* last) {
+            InterleavedMeshData mesh;
+            std::size_t vertexCount = 0;
+            bool hasNormals = false;
+            bool hasVertices = false;
+
+            for (const auto& element : header.elements) {
+                const char* sectionEnd = skipLines(cursor, last, element.count);
+                if (!sectionEnd) {
+                    return std::nullopt;
+                }
+
+                const bool isVertex = element.name == "vertex";
+                const int indexProperty = findFaceIndexProperty(element);
+                const bool isFace = element.name == "face" && hasVertices && indexProperty >= 0;
+                if (!isVertex && !isFace) {
+                    cursor = sectionEnd;
+                    continue;
+                }
+
+                std::optional<PlyVertexLayout> layout;
+                if (isVertex) {
+                    layout = findVertexLayout(element);
+                    if (!layout) {
+                        return std::nullopt;
+                    }
+                }
+
+                const auto chunks = text::splitLines(cursor, sectionEnd,
+                                                     textChunkCount(static_cast<std::size_t>(sectionEnd - cursor)));
+                std::vector<std::vector<float>> chunkVertices(chunks.size() - 1);
+                std::vector<std::vector<unsigned int>> chunkIndices(chunks.size() - 1);
+                std::atomic<bool> failed{false};
+                const std::size_t knownVertices = vertexCount;
+
+                parallelFor(chunks.size() - 1, 1, [&](std::size_t begin, std::size_t end) {
+                    std::vector<double> values(element.properties.size());
+                    std::vector<int64_t> polygon;
+                    for (std::size_t chunk = begin; chunk < end && !failed; ++chunk) {
+                        for (const char* line = chunks[chunk]; line != chunks[chunk + 1];) {
+                            const char* lineEnd = text::nextLine(line, chunks[chunk + 1]);
+                            polygon.clear();
+                            if (!parseAsciiRecord(element, line, lineEnd, values.data(), indexProperty, polygon)) {
+                                failed = true;
+                                return;
+                            }
+
+                            if (isVertex) {
+                                auto& vertices = chunkVertices[chunk];
+                                vertices.resize(vertices.size() + kInterleavedVertexFloats);
+                                writePlyVertex(vertices.data() + vertices.size() - kInterleavedVertexFloats, *layout, values.data());
+                            } else if (!appendPolygon(chunkIndices[chunk], polygon.data(), polygon.size(), knownVertices)) {
+                                failed = true;
+                                return;
+                            }
+                            line = lineEnd;
+                        }
+                    }
+                });
+
+                if (failed) {
+                    return std::nullopt;
+                }
+
+                if (isVertex) {
+                    mesh.vertexData = concatenate(chunkVertices);
+                    vertexCount = mesh.vertexData.size() / kInterleavedVertexFloats;
+                    hasNormals = layout->hasNormals();
+                    hasVertices = true;
+                } else {
+                    mesh.indices = concatenate(chunkIndices);
+                }
+                cursor = sectionEnd;
+            }
+
+            if (!hasNormals) {
+                computeSmoothNormals(mesh);
+            }
+            return mesh;
+        }
+
+        std::optional<InterleavedMeshData> readPly(const MappedFile& file) {
+            auto header = parsePlyHeader(textBegin(file), textEnd(file));
+            if (!header) {
+                return std::nullopt;
+            }
+
+            if (header->format == PlyFormat::Ascii) {
+                return readAsciiPlyBody(*header, header->body, textEnd(file));
+            }
+            return readBinaryPlyBody(*header,
+                                     reinterpret_cast<const std::byte*>(header->body),
+                                     file.data() + file.size());
+        }
+
+        // ---------------------------------------------------------------- OBJ
+
+        struct ObjChunkCounts {
+            std::size_t positions = 0;
+            std::size_t texCoords = 0;
+            std::size_t normals = 0;
+        };
+
+        // Resolves a 1-based (or negative, relative) OBJ index against the number of elements defined so far
+        bool resolveObjIndex(int64_t index, std::size_t definedSoFar, std::size_t total, uint32_t& resolved) {
+            const int64_t absolute = index > 0 ? index - 1 : static_cast<int64_t>(definedSoFar) + index;
+            if (index == 0 || absolute < 0 || static_cast<std::size_t>(absolute) >= total) {
+                return false;
+            }
+            resolved = static_cast<uint32_t>(absolute);
+            return true;
+        }
+
+        std::optional<InterleavedMeshData> readObj(const MappedFile& file) {
+            const char* last = textEnd(file);
+            const auto chunks = text::splitLines(textBegin(file), last, textChunkCount(file.size()));
+            const std::size_t chunkCount = chunks.size() - 1;
+
+            // Pass 1: count attributes per chunk so every chunk knows its global offsets (needed for
+            // negative indices and for writing attributes in place)
+            std::vector<ObjChunkCounts> counts(chunkCount);
+            parallelFor(chunkCount, 1, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t chunk = begin; chunk < end; ++chunk) {
+                    for (const char* line = chunks[chunk]; line != chunks[chunk + 1]; line = text::nextLine(line, chunks[chunk + 1])) {
+                        const char* cursor = text::skipSpaces(line, chunks[chunk + 1]);
+                        if (text::isKeyword(cursor, chunks[chunk + 1], "v")) {
+                            ++counts[chunk].positions;
+                        } else if (text::isKeyword(cursor, chunks[chunk + 1], "vt")) {
+                            ++counts[chunk].texCoords;
+                        } else if (text::isKeyword(cursor, chunks[chunk + 1], "vn")) {
+                            ++counts[chunk].normals;
+                        }
+                    }
+                }
+            });
+
+            std::vector<ObjChunkCounts> offsets(chunkCount);
+            ObjChunkCounts totals;
+            for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+                offsets[chunk] = totals;
+                totals.positions += counts[chunk].positions;
+                totals.texCoords += counts[chunk].texCoords;
+                totals.normals += counts[chunk].normals;
+            }
+            if (totals.positions == 0) {
+                return std::nullopt;
+            }
+
+            std::vector<float> positions(totals.positions * 3);
+            std::vector<float> texCoords(totals.texCoords * 2);
+            std::vector<float> normals(totals.normals * 3);
+            // Triangulated corners as (position, texCoord, normal) index triples
+            std::vector<std::vector<VertexKey>> chunkCorners(chunkCount);
+            std::atomic<bool> failed{false};
+
+            // Pass 2: parse attributes into place and triangulate faces with resolved indices
+            parallelFor(chunkCount, 1, [&](std::size_t begin, std::size_t end) {
+                std::vector<VertexKey> polygon;
+                for (std::size_t chunk = begin; chunk < end && !failed; ++chunk) {
+                    ObjChunkCounts defined = offsets[chunk];
+                    auto& corners = chunkCorners[chunk];
+
+                    for (const char* line = chunks[chunk]; line != chunks[chunk + 1];) {
+                        const char* lineEnd = text::nextLine(line, chunks[chunk + 1]);
+                        const char* cursor = text::skipSpaces(line, lineEnd);
+
+                        if (text::isKeyword(cursor, lineEnd, "v")) {
+                            cursor += 1;
+                            for (std::size_t i = 0; i < 3 && cursor; ++i) {
+                                cursor = text::parseFloat(cursor, lineEnd, positions[defined.positions * 3 + i]);
+                            }
+                            ++defined.positions;
+                        } else if (text::isKeyword(cursor, lineEnd, "vt")) {
+                            cursor += 2;
+                            for (std::size_t i = 0; i < 2 && cursor; ++i) {
+                                cursor = text::parseFloat(cursor, lineEnd, texCoords[defined.texCoords * 2 + i]);
+                            }
+                            ++defined.texCoords;
+                        } else if (text::isKeyword(cursor, lineEnd, "vn")) {
+                            cursor += 2;
+                            for (std::size_t i = 0; i < 3 && cursor; ++i) {
+                                cursor = text::parseFloat(cursor, lineEnd, normals[defined.normals * 3 + i]);
+                            }
+                            ++defined.normals;
+                        } else if (text::isKeyword(cursor, lineEnd, "f")) {
+                            cursor += 1;
+                            polygon.clear();
+                            while (cursor) {
+                                cursor = text::skipSpaces(cursor, lineEnd);
+                                if (cursor == lineEnd || *cursor == '\n' || *cursor == '#') {
+                                    break;
+                                }
+
+                                VertexKey corner{kAbsentIndex, kAbsentIndex, kAbsentIndex};
+                                int64_t index = 0;
+                                cursor = text::parseInt(cursor, lineEnd, index);
+                                if (!cursor || !resolveObjIndex(index, defined.positions, totals.positions, corner[0])) {
+                                    cursor = nullptr;
+                                    break;
+                                }
+                                if (cursor != lineEnd && *cursor == '/') {
+                                    ++cursor;
+                                    if (cursor != lineEnd && *cursor != '/') {
+                                        cursor = text::parseInt(cursor, lineEnd, index);
+                                        if (!cursor || !resolveObjIndex(index, defined.texCoords, totals.texCoords, corner[1])) {
+                                            cursor = nullptr;
+                                            break;
+                                        }
+                                    }
+                                    if (cursor != lineEnd && *cursor == '/') {
+                                        ++cursor;
+                                        cursor = text::parseInt(cursor, lineEnd, index);
+                                        if (!cursor || !resolveObjIndex(index, defined.normals, totals.normals, corner[2])) {
+                                            cursor = nullptr;
+                                            break;
+                                        }
+                                    }
+                                }
+                                polygon.push_back(corner);
+                            }
+
+                            for (std::size_t i = 2; cursor && i < polygon.size(); ++i) {
+                                corners.insert(corners.end(), {polygon[0], polygon[i - 1], polygon[i]});
+                            }
+                        }
+
+                        if (!cursor) {
+                            failed = true;
+                            return;
+                        }
+                        line = lineEnd;
+                    }
+                }
+            });
+
+            if (failed) {
+                return std::nullopt;
+            }
+
+            std::vector<VertexKey> corners = concatenate(chunkCorners);
+
+            // Weld identical index triples into shared output vertices
+            InterleavedMeshData mesh;
+            VertexWelder welder(totals.positions);
+            mesh.vertexData.reserve(totals.positions * kInterleavedVertexFloats);
+            mesh.indices.reserve(corners.size());
+            bool hasAllNormals = true;
+
+            for (const auto& corner : corners) {
+                const auto nextIndex = static_cast<uint32_t>(mesh.vertexData.size() / kInterleavedVertexFloats);
+                const auto [index, inserted] = welder.insert(corner, nextIndex);
+                if (inserted) {
+                    hasAllNormals &= corner[2] != kAbsentIndex;
+                    appendVertex(mesh,
+                                 positions.data() + std::size_t{corner[0]} * 3,
+                                 corner[2] != kAbsentIndex ? normals.data() + std::size_t{corner[2]} * 3 : nullptr,
+                                 corner[1] != kAbsentIndex ? texCoords.data() + std::size_t{corner[1]} * 2 : nullptr);
+                }
+                mesh.indices.push_back(index);
+            }
+
+            if (!hasAllNormals) {
+                computeSmoothNormals(mesh);
+            }
+            return mesh;
+        }
+
+        std::string lowercaseExtension(const std::string& path) {
+            auto extension = std::filesystem::path(path).extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(),
+                           [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return extension;
+        }
+
+    } // namespace
+
+    bool NativeMeshReader::canRead(const std::string& path) {
+        const auto extension = lowercaseExtension(path);
+        return extension == ".stl" || extension == ".ply" || extension == ".obj";
+    }
+
+    std::optional<InterleavedMeshData> NativeMeshReader::read(const std::string& path) {
+        MappedFile file(path);
+        if (!file.isOpen()) {
+            return std::nullopt;
+        }
+
+        const auto extension = lowercaseExtension(path);
+        std::optional<InterleavedMeshData> mesh;
+        if (extension == ".stl") {
+            mesh = readStl(file);
+        } else if (extension == ".ply") {
+            mesh = readPly(file);
+        } else if (extension == ".obj") {
+            mesh = readObj(file);
+        }
+
+        if (!mesh || mesh->indices.empty()) {
+            spdlog::warn("Native reader could not parse {}, falling back to Assimp", path);
+            return std::nullopt;
+        }
+
+        spdlog::info("Read {} natively: {} vertices, {} triangles",
+                     path, mesh->vertexData.size() / kInterleavedVertexFloats, mesh->indices.size() / 3);
+        return mesh;
+    }
+
+} // namespace s3Dive
@@ -0,0 +1,24 @@
+#ifndef THREEDIVE_NATIVEMESHREADER_H
+#define THREEDIVE_NATIVEMESHREADER_H
+
+#include <optional>
+#include <string>
+#include "MeshData.h"
+
+namespace s3Dive {
+
+    // Streaming readers for the large scan formats (binary/ASCII STL, PLY, OBJ). Files are memory mapped,
+    // text is parsed in parallel line-aligned chunks, and vertices are written straight into the interleaved
+    // layout uploaded by ModelLoadingSystem, skipping Assimp's aiScene and the std::vector<Vertex> copy.
+    // STL triangle soups and OBJ index triples are welded through a hash table; missing normals are
+    // generated by area-weighted smoothing. Anything the readers do not understand returns std::nullopt
+    // so the caller can fall back to Assimp.
+    class NativeMeshReader {
+    public:
+        [[nodiscard]] static bool canRead(const std::string& path);
+        [[nodiscard]] static std::optional<InterleavedMeshData> read(const std::string& path);
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_NATIVEMESHREADER_H
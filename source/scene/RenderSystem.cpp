@@ -1,66 +1,156 @@
 #include "RenderSystem.h"
 #include "components.h"
-#include "../renderer/RenderCommand.h"
-#include <glm/gtc/type_ptr.hpp>
+#include "../renderer/MaterialUniformCache.h"
+#include "../renderer/Renderer.h"
+#include <algorithm>
 
 namespace s3Dive {
 
-    void RenderSystem::render(Scene& scene, GLShaderProgram& shaderProgram, const CameraController& cameraController) {
-        shaderProgram.use();
+    void RenderSystem::update(Scene& scene, [[maybe_unused]] float deltaTime) {
+        auto& registry = scene.getRegistry();
+        if (!transformChanges_) {
+            transformChanges_ = &scene.getChangeTracker().subscribe<WorldTransformComponent>();
+            meshChanges_ = &scene.getChangeTracker().subscribe<MeshComponent>();
+            materialChanges_ = &scene.getChangeTracker().subscribe<MaterialComponent>();
+        }
 
-        // Set up global light
-        shaderProgram.updateShaderUniform("lightColor", glm::vec3(1.0f, 1.0f, 1.0f)); // White light
-        shaderProgram.updateShaderUniform("ambientStrength", 0.7f); // Stronger ambient for more uniform lighting
+        auto refresh = [&registry](entt::entity entity) {
+            if (!registry.valid(entity)) {
+                return;
+            }
+            const auto* transform = registry.try_get<WorldTransformComponent>(entity);
+            const auto* mesh = registry.try_get<MeshComponent>(entity);
+            if (!transform || !mesh || !mesh->asset) {
+                registry.remove<WorldBoundsComponent>(entity);
+                return;
+            }
+            // Replaced rather than edited in place so WorldBoundsComponent subscribers see the change
+            WorldBoundsComponent bounds;
+            transformBounds(mesh->asset->bounds, transform->world, bounds.center, bounds.extent);
+            registry.emplace_or_replace<WorldBoundsComponent>(entity, bounds);
+        };
+        for (auto entity : transformChanges_->getEntities()) {
+            refresh(entity);
+        }
+        for (auto entity : meshChanges_->getEntities()) {
+            if (!transformChanges_->contains(entity)) {
+                refresh(entity);
+            }
+        }
+        transformChanges_->clear();
+        meshChanges_->clear();
+    }
 
-        // Set view position (camera position)
-        const auto& camera = cameraController.getCamera();
-        shaderProgram.updateShaderUniform("viewPos", cameraController.getDistanceToTarget());
+    void RenderSystem::refreshMaterialUniforms(Scene& scene) {
+        auto& registry = scene.getRegistry();
+        auto& cache = MaterialUniformCache::instance();
+        for (auto entity : materialChanges_->getEntities()) {
+            auto* material = registry.valid(entity) ? registry.try_get<MaterialComponent>(entity) : nullptr;
+            if (!material) {
+                continue;
+            }
+            // Assigned without a patch: the block only mirrors values whose change was already signalled
+            material->uniforms = cache.get(MaterialUniforms{material->albedo, material->metallic,
+                                                            material->roughness, material->ao});
+        }
+        materialChanges_->clear();
+    }
 
-        glm::mat4 projectionMatrix = camera.getProjectionMatrix();
-        glm::mat4 viewMatrix = camera.getViewMatrix();
-        shaderProgram.updateShaderUniform("view", glm::value_ptr(viewMatrix));
-        shaderProgram.updateShaderUniform("projection", glm::value_ptr(projectionMatrix));
+    void RenderSystem::render(Scene& scene, GLShaderProgram& shaderProgram, const CameraController& cameraController) {
+        if (materialChanges_) {
+            refreshMaterialUniforms(scene);
+        }
 
-        // Iterate through all entities with a ModelComponent
-        auto modelView = scene.view<ModelComponent>();
-        for (auto modelEntity : modelView) {
-            const auto& modelComponent = modelView.get<ModelComponent>(modelEntity);
+        // Camera and lighting come from the FrameData block written by Renderer::beginScene
+        candidates_.clear();
+        bounds_.clear();
 
-            // Render each mesh entity associated with the model
-            for (const auto& meshEntityUUID : modelComponent.meshEntities) {
-                if (!scene.hasComponent<TransformComponent>(meshEntityUUID) ||
-                    !scene.hasComponent<MeshComponent>(meshEntityUUID) ||
-                    !scene.hasComponent<MaterialComponent>(meshEntityUUID)) {
-                    continue;
-                }
+        // Owning group: the four pools are packed so that the group's entities come first, in the same order
+        // in each, and this walks four arrays front to back instead of probing per mesh. Models keep their
+        // ModelComponent::meshEntities for editing; drawing does not go through them.
+        auto meshes = scene.getRegistry().group<WorldTransformComponent, MeshComponent, MaterialComponent,
+                                                WorldBoundsComponent>();
+        candidates_.reserve(meshes.size());
+        meshes.each([this](const WorldTransformComponent& transform, const MeshComponent& mesh,
+                           const MaterialComponent& material, const WorldBoundsComponent& bounds) {
+            if (!mesh.isInitialized || !mesh.asset || !mesh.asset->geometry) {
+                return;
+            }
+            // Matrices and boxes are only rebuilt for meshes that moved, by TransformSystem and update
+            candidates_.push_back(Candidate{mesh.asset.get(), &material, &transform});
+            bounds_.push(bounds.center, bounds.extent);
+        });
 
-                const auto& transform = scene.getComponent<TransformComponent>(meshEntityUUID);
-                const auto& mesh = scene.getComponent<MeshComponent>(meshEntityUUID);
-                const auto& material = scene.getComponent<MaterialComponent>(meshEntityUUID);
+        const auto visibleCount = cullFrustum(cameraController.getFrustum(), bounds_, visible_);
+        statistics_.occludedMeshes = occlusionEnabled_ ? cullOccluded(cameraController) : 0;
+        statistics_.occluders = occlusionEnabled_ ? occlusionCuller_.getStatistics().occluders : 0;
+        statistics_.totalMeshes = static_cast<uint32_t>(candidates_.size());
+        statistics_.visibleMeshes = static_cast<uint32_t>(visibleCount) - statistics_.occludedMeshes;
 
-                if (!mesh.isInitialized || !mesh.vertexArray) {
-                    continue;
-                }
+        for (std::size_t i = 0; i < candidates_.size(); ++i) {
+            if (!visible_[i]) {
+                continue;
+            }
+            const auto& candidate = candidates_[i];
+            Renderer::submit(RenderPass::Opaque, shaderProgram, *candidate.mesh, *candidate.material,
+                             candidate.transform->world, candidate.transform->normal);
+        }
+    }
 
-                // Set model matrix using the TransformComponent's transformation matrix
-                glm::mat4 model = transform.GetTransform();
-                shaderProgram.updateShaderUniform("model", glm::value_ptr(model));
-                shaderProgram.updateShaderUniform("albedo", material.albedo);
-//                shaderProgram.updateShaderUniform("metallic", material.metallic);
-//                shaderProgram.updateShaderUniform("roughness", material.roughness);
+    uint32_t RenderSystem::cullOccluded(const CameraController& cameraController) {
+        const auto& camera = cameraController.getCamera();
+        occlusionCuller_.beginFrame(camera.getProjectionMatrix() * camera.getViewMatrix());
 
-                if (material.diffuseTexture) {
-                    material.diffuseTexture->bind(0);
-                    shaderProgram.updateShaderUniform("material.diffuseTexture", 0);
-                }
+        auto boxAt = [this](std::size_t i, glm::vec3& center, glm::vec3& extent) {
+            center = {bounds_.get(CullingBounds::CenterX)[i], bounds_.get(CullingBounds::CenterY)[i],
+                      bounds_.get(CullingBounds::CenterZ)[i]};
+            extent = {bounds_.get(CullingBounds::ExtentX)[i], bounds_.get(CullingBounds::ExtentY)[i],
+                      bounds_.get(CullingBounds::ExtentZ)[i]};
+        };
 
-                mesh.vertexArray->bind();
-                RenderCommand::drawIndexed(*mesh.vertexArray, static_cast<GLint>(mesh.indices.size()));
-                mesh.vertexArray->unbind();
+        // The biggest meshes on screen hide the most; small ones are not worth rasterizing
+        const auto& settings = occlusionCuller_.getSettings();
+        occluderCandidates_.clear();
+        for (std::size_t i = 0; i < candidates_.size(); ++i) {
+            if (!visible_[i] || !candidates_[i].mesh->occluder) {
+                continue;
+            }
+            glm::vec3 center;
+            glm::vec3 extent;
+            boxAt(i, center, extent);
+            const float area = occlusionCuller_.getScreenArea(center, extent);
+            if (area >= settings.minOccluderScreenArea) {
+                occluderCandidates_.emplace_back(area, static_cast<uint32_t>(i));
             }
         }
 
-        shaderProgram.unuse();
+        const auto occluderCount = std::min<std::size_t>(occluderCandidates_.size(), settings.maxOccluders);
+        std::partial_sort(occluderCandidates_.begin(), occluderCandidates_.begin() + static_cast<std::ptrdiff_t>(occluderCount),
+                          occluderCandidates_.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+        for (std::size_t i = 0; i < occluderCount; ++i) {
+            const auto& candidate = candidates_[occluderCandidates_[i].second];
+            occlusionCuller_.addOccluder(*candidate.mesh->occluder, candidate.transform->world);
+        }
+        if (occluderCount == 0) {
+            return 0;
+        }
+        occlusionCuller_.rasterize();
+
+        // An occluder passes its own test: its box is never entirely behind its own surface
+        uint32_t occluded = 0;
+        for (std::size_t i = 0; i < candidates_.size(); ++i) {
+            if (!visible_[i]) {
+                continue;
+            }
+            glm::vec3 center;
+            glm::vec3 extent;
+            boxAt(i, center, extent);
+            if (!occlusionCuller_.isVisible(center, extent)) {
+                visible_[i] = 0;
+                ++occluded;
+            }
+        }
+        return occluded;
     }
 
 } // namespace s3Dive
@@ -5,17 +5,67 @@
 #ifndef THREEDIVE_RENDERSYSTEM_H
 #define THREEDIVE_RENDERSYSTEM_H
 
+#include <cstdint>
+#include <vector>
 #include "system.h"
 #include "components.h"
+#include "../renderer/FrustumCulling.h"
+#include "../renderer/OcclusionCuller.h"
 
 namespace s3Dive {
 
     class RenderSystem : public System {
     public:
+        struct Statistics {
+            uint32_t totalMeshes = 0;   // Initialized mesh entities considered this frame
+            uint32_t visibleMeshes = 0;  // Left after frustum and occlusion culling, i.e. submitted to the Renderer
+            uint32_t occludedMeshes = 0; // Inside the frustum but hidden behind occluders
+            uint32_t occluders = 0;
+        };
+
+        // Refreshes WorldBoundsComponent for mesh entities whose world transform or mesh changed
+        void update(Scene& scene, float deltaTime) override;
+
+        // Culls every initialized mesh entity against the camera frustum, then against a software depth buffer
+        // of the largest visible occluders, and submits what is left to the Renderer; the caller brackets this
+        // with beginScene/endScene
         void render(Scene& scene, GLShaderProgram& shaderProgram,  const CameraController& cameraController) override;
+        // Structural: adds and removes WorldBoundsComponent
+        void declareAccess(SystemAccess& access) const override {
+            access.structural().reads<WorldTransformComponent, MeshComponent>().writes<WorldBoundsComponent>();
+        }
+
+        // Counters of the last render
+        [[nodiscard]] const Statistics& getStatistics() const noexcept { return statistics_; }
+
+        void setOcclusionEnabled(bool enabled) noexcept { occlusionEnabled_ = enabled; }
 
     private:
+        struct Candidate {
+            const MeshAsset* mesh;
+            const MaterialComponent* material;
+            const WorldTransformComponent* transform;
+        };
+
         void setupLights(Scene& scene, GLShaderProgram& shaderProgram) const;
+        // Points materials added or patched since the last render at the uniform block for their values
+        void refreshMaterialUniforms(Scene& scene);
+        // Clears visible_ for candidates hidden behind occluders; returns how many were
+        uint32_t cullOccluded(const CameraController& cameraController);
+
+        // Subscribed on the first update; one scene per system
+        ChangeSet* transformChanges_ = nullptr;
+        ChangeSet* meshChanges_ = nullptr;
+        ChangeSet* materialChanges_ = nullptr; // Drained by render: the blocks need the GL context
+
+        // Reused across frames so culling does not allocate once the scene has been seen
+        std::vector<Candidate> candidates_;
+        CullingBounds bounds_;
+        std::vector<uint8_t> visible_;
+        std::vector<std::pair<float, uint32_t>> occluderCandidates_; // Screen area, candidate index
+        OcclusionCuller occlusionCuller_;
+        bool occlusionEnabled_ = true;
+        Statistics statistics_;
     };
 
 } // s3Dive
@@ -0,0 +1,34 @@
+#include "SceneStaging.h"
+#include <spdlog/spdlog.h>
+
+namespace s3Dive {
+
+    void SceneStaging::merge(Scene& scene) {
+        static_cast<void>(scene.createEntities(entities_));
+
+        auto& registry = scene.getRegistry();
+        std::size_t nextDeferred = 0;
+        auto runDeferredUpTo = [&](std::size_t position) {
+            for (; nextDeferred < deferred_.size() && deferred_[nextDeferred].position <= position; ++nextDeferred) {
+                deferred_[nextDeferred].apply(scene);
+            }
+        };
+
+        for (std::size_t i = 0; i < commands_.size(); ++i) {
+            runDeferredUpTo(i);
+            const auto entity = scene.getEntity(commands_[i].uuid);
+            if (entity == entt::null) {
+                // Destroyed in the scene between recording and merging
+                spdlog::warn("Dropping staged component for missing entity {}", commands_[i].uuid.toString());
+                continue;
+            }
+            commands_[i].apply(registry, entity);
+        }
+        runDeferredUpTo(commands_.size());
+
+        entities_.clear();
+        commands_.clear();
+        deferred_.clear();
+    }
+
+} // namespace s3Dive
@@ -0,0 +1,72 @@
+#ifndef THREEDIVE_SCENESTAGING_H
+#define THREEDIVE_SCENESTAGING_H
+
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "scene.h"
+
+namespace s3Dive {
+
+    // Command buffer for building part of a scene away from the thread that owns it. A worker records entity
+    // creation and components into its own SceneStaging, which touches no shared state; the owner then applies
+    // it with merge at a sync point. UUIDs are handed out at record time, so staged entities can already refer
+    // to each other. One staging per thread: recording is not synchronized.
+    class SceneStaging {
+    public:
+        SceneStaging() = default;
+
+        SceneStaging(const SceneStaging&) = delete;
+        SceneStaging& operator=(const SceneStaging&) = delete;
+        SceneStaging(SceneStaging&&) noexcept = default;
+        SceneStaging& operator=(SceneStaging&&) noexcept = default;
+
+        // The entity is created by merge; the UUID is valid right away
+        [[nodiscard]] UUID createEntity() {
+            return entities_.emplace_back();
+        }
+
+        // For a staged entity or one already in the scene. Replaces a component the entity already has.
+        template<typename T, typename... Args>
+        void addComponent(const UUID& uuid, Args&&... args) {
+            commands_.push_back({uuid, [component = T(std::forward<Args>(args)...)](entt::registry& registry,
+                                                                                    entt::entity entity) mutable {
+                registry.emplace_or_replace<T>(entity, std::move(component));
+            }});
+        }
+
+        // Anything else that must wait for the merge, such as parenting staged entities; runs after the
+        // components recorded before it
+        void defer(std::function<void(Scene&)> command) {
+            deferred_.push_back({commands_.size(), std::move(command)});
+        }
+
+        // Creates the staged entities in one batch, then applies the commands in recording order, and leaves the
+        // staging empty. Call on the thread that owns the scene.
+        void merge(Scene& scene);
+
+        [[nodiscard]] bool empty() const noexcept {
+            return entities_.empty() && commands_.empty() && deferred_.empty();
+        }
+        [[nodiscard]] std::size_t getEntityCount() const noexcept { return entities_.size(); }
+
+    private:
+        struct ComponentCommand {
+            UUID uuid;
+            std::function<void(entt::registry&, entt::entity)> apply;
+        };
+
+        struct DeferredCommand {
+            std::size_t position; // Component commands recorded before it
+            std::function<void(Scene&)> apply;
+        };
+
+        std::vector<UUID> entities_;
+        std::vector<ComponentCommand> commands_;
+        std::vector<DeferredCommand> deferred_;
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_SCENESTAGING_H
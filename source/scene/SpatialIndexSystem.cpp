@@ -0,0 +1,90 @@
+#include "SpatialIndexSystem.h"
+#include <algorithm>
+
+namespace s3Dive {
+
+    namespace {
+
+        uint32_t toUserData(entt::entity entity) noexcept { return static_cast<uint32_t>(entity); }
+        entt::entity toEntity(uint32_t userData) noexcept { return static_cast<entt::entity>(userData); }
+
+        // Distance at which the ray enters [min, max], or a negative value when it misses within maxDistance
+        float intersectBox(const glm::vec3& origin, const glm::vec3& inverseDirection, const glm::vec3& min,
+                           const glm::vec3& max, float maxDistance) {
+            float tMin = 0.0f;
+            float tMax = maxDistance;
+            for (int axis = 0; axis < 3; ++axis) {
+                float t1 = (min[axis] - origin[axis]) * inverseDirection[axis];
+                float t2 = (max[axis] - origin[axis]) * inverseDirection[axis];
+                if (t1 > t2) {
+                    std::swap(t1, t2);
+                }
+                tMin = t1 > tMin ? t1 : tMin;
+                tMax = t2 < tMax ? t2 : tMax;
+                if (tMin > tMax) {
+                    return -1.0f;
+                }
+            }
+            return tMin;
+        }
+
+    } // namespace
+
+    void SpatialIndexSystem::update(Scene& scene, [[maybe_unused]] float deltaTime) {
+        auto& registry = scene.getRegistry();
+        if (!boundsChanges_) {
+            boundsChanges_ = &scene.getChangeTracker().subscribe<WorldBoundsComponent>();
+        }
+
+        for (auto entity : boundsChanges_->getEntities()) {
+            const auto* bounds = registry.valid(entity) ? registry.try_get<WorldBoundsComponent>(entity) : nullptr;
+            const int32_t* leaf = leaves_.find(entity);
+            if (!bounds) {
+                if (leaf) {
+                    tree_.remove(*leaf);
+                    leaves_.erase(entity);
+                }
+                continue;
+            }
+
+            const glm::vec3 min = bounds->center - bounds->extent;
+            const glm::vec3 max = bounds->center + bounds->extent;
+            if (leaf) {
+                tree_.update(*leaf, min, max);
+            } else {
+                leaves_.insertOrAssign(entity, tree_.insert(min, max, toUserData(entity)));
+            }
+        }
+        boundsChanges_->clear();
+    }
+
+    void SpatialIndexSystem::queryFrustum(const Frustum& frustum, std::vector<entt::entity>& entities) const {
+        tree_.queryFrustum(frustum, [&entities](uint32_t userData) { entities.push_back(toEntity(userData)); });
+    }
+
+    void SpatialIndexSystem::queryBox(const glm::vec3& min, const glm::vec3& max,
+                                      std::vector<entt::entity>& entities) const {
+        tree_.queryBox(min, max, [&entities](uint32_t userData) { entities.push_back(toEntity(userData)); });
+    }
+
+    SpatialIndexSystem::RaycastHit SpatialIndexSystem::raycast(const Scene& scene, const glm::vec3& origin,
+                                                               const glm::vec3& direction, float maxDistance) const {
+        const auto& registry = scene.getRegistry();
+        const glm::vec3 inverseDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+
+        // The tree holds padded boxes; the exact world bounds decide the hit
+        RaycastHit hit;
+        tree_.raycast(origin, direction, maxDistance, [&](uint32_t userData) {
+            const entt::entity entity = toEntity(userData);
+            const auto& bounds = registry.get<WorldBoundsComponent>(entity);
+            const float distance = intersectBox(origin, inverseDirection, bounds.center - bounds.extent,
+                                                bounds.center + bounds.extent, std::min(hit.distance, maxDistance));
+            if (distance >= 0.0f && distance < hit.distance) {
+                hit = {entity, distance};
+            }
+            return distance;
+        });
+        return hit;
+    }
+
+} // namespace s3Dive
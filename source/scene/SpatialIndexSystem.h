@@ -0,0 +1,56 @@
+#ifndef THREEDIVE_SPATIALINDEXSYSTEM_H
+#define THREEDIVE_SPATIALINDEXSYSTEM_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "system.h"
+#include "components.h"
+#include "DynamicAabbTree.h"
+#include "../core/flat_hash_map.h"
+
+namespace s3Dive {
+
+    // Keeps a DynamicAabbTree over the WorldBoundsComponent of mesh entities, for questions about a region of the
+    // scene: which meshes a frustum or box touches, and which one a ray hits first. update only touches entities
+    // whose bounds changed, and those that moved less than the tree's margin do not even reach the tree, so a
+    // mostly static scene costs close to nothing per frame. Queries read the tree as of the last update.
+    class SpatialIndexSystem : public System {
+    public:
+        struct RaycastHit {
+            entt::entity entity = entt::null;
+            float distance = std::numeric_limits<float>::infinity(); // In units of the ray direction's length
+        };
+
+        // margin pads the boxes in the tree; larger means fewer reinsertions for moving meshes, but looser queries
+        explicit SpatialIndexSystem(float margin = 0.1f) : tree_(margin) {}
+
+        void update(Scene& scene, float deltaTime) override;
+        // Structural until the first update has subscribed to bounds changes, a plain reader afterwards
+        void declareAccess(SystemAccess& access) const override {
+            if (!boundsChanges_) {
+                access.structural();
+            }
+            access.reads<WorldBoundsComponent>();
+        }
+
+        // Appends the entities whose padded bounds intersect the frustum; conservative like Frustum::intersectsBox
+        void queryFrustum(const Frustum& frustum, std::vector<entt::entity>& entities) const;
+        // Appends the entities whose padded bounds overlap [min, max]
+        void queryBox(const glm::vec3& min, const glm::vec3& max, std::vector<entt::entity>& entities) const;
+        // Nearest entity whose world bounds the ray enters within maxDistance; entity is entt::null on a miss.
+        // Box-level only: a caller after the exact triangle goes on from the returned entity.
+        [[nodiscard]] RaycastHit raycast(const Scene& scene, const glm::vec3& origin, const glm::vec3& direction,
+                                         float maxDistance = std::numeric_limits<float>::infinity()) const;
+
+        [[nodiscard]] const DynamicAabbTree& getTree() const noexcept { return tree_; }
+
+    private:
+        DynamicAabbTree tree_;
+        FlatHashMap<entt::entity, int32_t> leaves_; // Tree leaf of every indexed entity
+        ChangeSet* boundsChanges_ = nullptr;        // Subscribed on the first update; one scene per system
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_SPATIALINDEXSYSTEM_H
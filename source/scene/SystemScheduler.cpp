@@ -0,0 +1,127 @@
+#include "SystemScheduler.h"
+#include <thread>
+#include <spdlog/spdlog.h>
+
+namespace s3Dive {
+
+    namespace {
+
+        uint64_t nanosecondsBetween(std::chrono::steady_clock::time_point from, std::chrono::steady_clock::time_point to) {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+        }
+
+    } // namespace
+
+    SystemScheduler::SystemScheduler(JobSystem& jobSystem) : jobSystem_(jobSystem) {}
+
+    void SystemScheduler::add(System& system, std::string name) {
+        auto node = std::make_unique<Node>();
+        node->system = &system;
+        nodes_.push_back(std::move(node));
+        timings_.push_back({std::move(name)});
+    }
+
+    void SystemScheduler::buildGraph() {
+        for (auto& node : nodes_) {
+            node->access = {};
+            node->system->declareAccess(node->access);
+            node->dependents.clear();
+            node->dependencyCount = 0;
+        }
+        // Earlier systems go first on conflict; quadratic, but there are a handful of systems
+        for (std::size_t i = 0; i < nodes_.size(); ++i) {
+            for (std::size_t j = i + 1; j < nodes_.size(); ++j) {
+                if (nodes_[i]->access.conflictsWith(nodes_[j]->access)) {
+                    nodes_[i]->dependents.push_back(j);
+                    ++nodes_[j]->dependencyCount;
+                }
+            }
+        }
+    }
+
+    void SystemScheduler::update(Scene& scene, float deltaTime) {
+        if (nodes_.empty()) {
+            return;
+        }
+
+        buildGraph();
+        frameStart_ = Clock::now();
+        finishedSystems_.store(0, std::memory_order_relaxed);
+        for (std::size_t i = 0; i < nodes_.size(); ++i) {
+            auto& timing = timings_[i];
+            timing.waitNanoseconds = 0;
+            timing.queueNanoseconds = 0;
+            timing.runNanoseconds = 0;
+            timing.blockedBy = -1;
+            nodes_[i]->remainingDependencies.store(nodes_[i]->dependencyCount, std::memory_order_relaxed);
+        }
+
+        TaskGroup group(jobSystem_);
+        for (std::size_t i = 0; i < nodes_.size(); ++i) {
+            if (nodes_[i]->dependencyCount == 0) {
+                schedule(scene, deltaTime, group, i);
+            }
+        }
+
+        // Main-thread systems are queued by whichever thread finished their last dependency
+        while (finishedSystems_.load(std::memory_order_acquire) < nodes_.size()) {
+            std::size_t index = nodes_.size();
+            {
+                std::lock_guard lock(mainThreadMutex_);
+                if (!mainThreadQueue_.empty()) {
+                    index = mainThreadQueue_.front();
+                    mainThreadQueue_.pop_front();
+                }
+            }
+            if (index < nodes_.size()) {
+                runNode(scene, deltaTime, group, index);
+            } else if (!jobSystem_.tryRunOne()) {
+                std::this_thread::yield();
+            }
+        }
+        group.wait();
+        frameNanoseconds_ = nanosecondsBetween(frameStart_, Clock::now());
+    }
+
+    void SystemScheduler::schedule(Scene& scene, float deltaTime, TaskGroup& group, std::size_t index) {
+        nodes_[index]->readyAt = Clock::now();
+        if (nodes_[index]->access.isMainThread()) {
+            std::lock_guard lock(mainThreadMutex_);
+            mainThreadQueue_.push_back(index);
+            return;
+        }
+        group.run([this, &scene, deltaTime, &group, index] { runNode(scene, deltaTime, group, index); });
+    }
+
+    void SystemScheduler::runNode(Scene& scene, float deltaTime, TaskGroup& group, std::size_t index) {
+        auto& node = *nodes_[index];
+        auto& timing = timings_[index];
+        const auto start = Clock::now();
+        timing.queueNanoseconds = nanosecondsBetween(node.readyAt, start);
+        node.system->update(scene, deltaTime);
+        const auto end = Clock::now();
+        timing.runNanoseconds = nanosecondsBetween(start, end);
+
+        for (auto dependent : node.dependents) {
+            // Whoever releases the last dependency owns the dependent's timing until it is scheduled
+            if (nodes_[dependent]->remainingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                timings_[dependent].blockedBy = static_cast<int>(index);
+                timings_[dependent].waitNanoseconds = nanosecondsBetween(frameStart_, end);
+                schedule(scene, deltaTime, group, dependent);
+            }
+        }
+        finishedSystems_.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    void SystemScheduler::logTimings() const {
+        spdlog::info("System update: {:.3f} ms", static_cast<double>(frameNanoseconds_) / 1e6);
+        for (const auto& timing : timings_) {
+            spdlog::info("  {}: {:.3f} ms run, {:.3f} ms waiting on {}, {:.3f} ms queued", timing.name,
+                         static_cast<double>(timing.runNanoseconds) / 1e6,
+                         static_cast<double>(timing.waitNanoseconds) / 1e6,
+                         timing.blockedBy >= 0 ? timings_[timing.blockedBy].name : std::string("nothing"),
+                         static_cast<double>(timing.queueNanoseconds) / 1e6);
+        }
+    }
+
+} // namespace s3Dive
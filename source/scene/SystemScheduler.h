@@ -0,0 +1,74 @@
+#ifndef THREEDIVE_SYSTEMSCHEDULER_H
+#define THREEDIVE_SYSTEMSCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "system.h"
+#include "../core/job_system.h"
+
+namespace s3Dive {
+
+    // Runs the update phase of its systems on the JobSystem. Every frame each system declares its access and a
+    // system depends on every earlier-registered system it conflicts with, so the result is the same as calling
+    // the updates one after another in registration order, but systems that touch disjoint components run side
+    // by side. Main-thread systems run on the thread that calls update, which helps with the other systems'
+    // jobs while it waits. Render phases are not scheduled; they stay with the caller on the GL thread.
+    class SystemScheduler {
+    public:
+        struct SystemTiming {
+            std::string name;
+            uint64_t waitNanoseconds = 0;  // From the start of the frame until its last dependency finished
+            uint64_t queueNanoseconds = 0; // From ready until a thread picked it up
+            uint64_t runNanoseconds = 0;
+            int blockedBy = -1;            // Index of the dependency that finished last, -1 when it had none
+        };
+
+        explicit SystemScheduler(JobSystem& jobSystem = JobSystem::instance());
+
+        // Systems are not owned and must outlive the scheduler; registration order breaks conflicts
+        void add(System& system, std::string name);
+
+        void update(Scene& scene, float deltaTime);
+
+        // Per system, in registration order, for the last update
+        [[nodiscard]] const std::vector<SystemTiming>& getTimings() const noexcept { return timings_; }
+        [[nodiscard]] uint64_t getFrameNanoseconds() const noexcept { return frameNanoseconds_; }
+        void logTimings() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Node {
+            System* system;
+            SystemAccess access;
+            std::vector<std::size_t> dependents;
+            uint32_t dependencyCount = 0;
+            std::atomic<uint32_t> remainingDependencies{0};
+            Clock::time_point readyAt;
+        };
+
+        void buildGraph();
+        void schedule(Scene& scene, float deltaTime, TaskGroup& group, std::size_t index);
+        void runNode(Scene& scene, float deltaTime, TaskGroup& group, std::size_t index);
+
+        JobSystem& jobSystem_;
+        std::vector<std::unique_ptr<Node>> nodes_; // Nodes hold atomics, so they stay put
+        std::vector<SystemTiming> timings_;
+
+        // Per-frame state
+        Clock::time_point frameStart_;
+        std::atomic<std::size_t> finishedSystems_{0};
+        std::mutex mainThreadMutex_;
+        std::deque<std::size_t> mainThreadQueue_;
+        uint64_t frameNanoseconds_ = 0;
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_SYSTEMSCHEDULER_H
@@ -0,0 +1,277 @@
+#include "TransformSystem.h"
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+#include "../core/parallel_for.h"
+#include "../core/simd.h"
+
+namespace s3Dive {
+
+    namespace {
+
+        // A level is a matrix product per entity, so only wide levels are worth spreading over threads
+        constexpr std::size_t kMinTransformsPerRange = 4096;
+
+    } // namespace
+
+    void TransformSystem::update(Scene& scene, [[maybe_unused]] float deltaTime) {
+        auto& registry = scene.getRegistry();
+
+        // Transforms added, replaced or patched since the last update; the tag also covers in-place edits
+        // reported through markDirty
+        if (!transformChanges_) {
+            transformChanges_ = &scene.getChangeTracker().subscribe<TransformComponent>();
+        }
+        for (auto entity : transformChanges_->getEntities()) {
+            if (!registry.valid(entity) || !registry.all_of<TransformComponent>(entity)) {
+                continue;
+            }
+            if (!registry.all_of<WorldTransformComponent>(entity)) {
+                registry.emplace<WorldTransformComponent>(entity);
+            }
+            registry.emplace_or_replace<TransformDirtyComponent>(entity);
+        }
+        transformChanges_->clear();
+
+        entities_.clear();
+        for (auto entity : registry.view<TransformComponent, WorldTransformComponent, TransformDirtyComponent>()) {
+            entities_.push_back(entity);
+        }
+        statistics_ = {};
+        statistics_.updatedTransforms = static_cast<uint32_t>(entities_.size());
+        if (entities_.empty()) {
+            return;
+        }
+
+        const std::size_t count = entities_.size();
+        const std::size_t padded = simd::paddedCount(count);
+        for (auto& input : inputs_) {
+            input.resize(padded, 0.0f);
+        }
+        for (auto& output : outputs_) {
+            output.resize(padded);
+        }
+
+        // Trigonometry stays scalar; everything downstream of it is vectorized
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto& transform = registry.get<TransformComponent>(entities_[i]);
+            const glm::vec3 halfAngles = transform.Rotation * 0.5f;
+            inputs_[SinX][i] = std::sin(halfAngles.x);
+            inputs_[SinY][i] = std::sin(halfAngles.y);
+            inputs_[SinZ][i] = std::sin(halfAngles.z);
+            inputs_[CosX][i] = std::cos(halfAngles.x);
+            inputs_[CosY][i] = std::cos(halfAngles.y);
+            inputs_[CosZ][i] = std::cos(halfAngles.z);
+            for (int axis = 0; axis < 3; ++axis) {
+                const float scale = transform.Scale[axis];
+                inputs_[ScaleX + axis][i] = scale;
+                // A zero scale flattens the mesh; its normals are meaningless either way
+                inputs_[InverseScaleX + axis][i] = scale != 0.0f ? 1.0f / scale : 0.0f;
+            }
+        }
+
+        computeBatch(padded);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto& transform = registry.get<TransformComponent>(entities_[i]);
+            auto& world = registry.get<WorldTransformComponent>(entities_[i]);
+            const auto& out = outputs_;
+            world.local = glm::mat4(glm::vec4(out[World00][i], out[World01][i], out[World02][i], 0.0f),
+                                    glm::vec4(out[World10][i], out[World11][i], out[World12][i], 0.0f),
+                                    glm::vec4(out[World20][i], out[World21][i], out[World22][i], 0.0f),
+                                    glm::vec4(transform.Translation, 1.0f));
+            world.localNormal = glm::mat3(glm::vec3(out[Normal00][i], out[Normal01][i], out[Normal02][i]),
+                                          glm::vec3(out[Normal10][i], out[Normal11][i], out[Normal12][i]),
+                                          glm::vec3(out[Normal20][i], out[Normal21][i], out[Normal22][i]));
+        }
+
+        propagate(registry);
+        registry.clear<TransformDirtyComponent>();
+
+        // Announced after the parallel part, so subscribers' change sets are only touched from this thread
+        for (const auto& level : levels_) {
+            for (auto entity : level) {
+                registry.patch<WorldTransformComponent>(entity);
+            }
+        }
+    }
+
+    void TransformSystem::propagate(entt::registry& registry) {
+        for (auto& level : levels_) {
+            level.clear();
+        }
+        // A dirty entity below another dirty entity is reached through the ancestor's subtree, which keeps
+        // the subtrees disjoint and every entity collected once
+        for (auto entity : entities_) {
+            if (!hasDirtyAncestor(registry, entity)) {
+                collectSubtree(registry, entity);
+            }
+        }
+
+        const entt::registry& constRegistry = registry;
+        for (const auto& level : levels_) {
+            if (level.empty()) {
+                continue;
+            }
+            ++statistics_.levels;
+            statistics_.propagatedTransforms += static_cast<uint32_t>(level.size());
+
+            // Writes touch only this level's entities and reads only the previous level's, so ranges never overlap
+            parallelFor(level.size(), kMinTransformsPerRange, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    auto& world = registry.get<WorldTransformComponent>(level[i]);
+                    const auto* hierarchy = constRegistry.try_get<HierarchyComponent>(level[i]);
+                    const auto* parent = hierarchy && hierarchy->parent != entt::null && constRegistry.valid(hierarchy->parent)
+                                         ? constRegistry.try_get<WorldTransformComponent>(hierarchy->parent)
+                                         : nullptr;
+                    if (parent) {
+                        world.world = parent->world * world.local;
+                        // The inverse transpose of a product is the product of the inverse transposes
+                        world.normal = parent->normal * world.localNormal;
+                    } else {
+                        world.world = world.local;
+                        world.normal = world.localNormal;
+                    }
+                }
+            });
+        }
+    }
+
+    void TransformSystem::collectSubtree(const entt::registry& registry, entt::entity root) {
+        stack_.clear();
+        stack_.push_back(root);
+        while (!stack_.empty()) {
+            const auto entity = stack_.back();
+            stack_.pop_back();
+            if (!registry.valid(entity)) {
+                continue; // Destroyed without being detached first
+            }
+            const auto* hierarchy = registry.try_get<HierarchyComponent>(entity);
+            if (registry.all_of<WorldTransformComponent>(entity)) {
+                const uint32_t depth = hierarchy ? hierarchy->depth : 0;
+                if (depth >= levels_.size()) {
+                    levels_.resize(depth + 1);
+                }
+                levels_[depth].push_back(entity);
+            }
+            if (hierarchy) {
+                stack_.insert(stack_.end(), hierarchy->children.begin(), hierarchy->children.end());
+            }
+        }
+    }
+
+    bool TransformSystem::hasDirtyAncestor(const entt::registry& registry, entt::entity entity) {
+        const auto* hierarchy = registry.try_get<HierarchyComponent>(entity);
+        while (hierarchy && hierarchy->parent != entt::null && registry.valid(hierarchy->parent)) {
+            // Same condition as the dirty view in update, so the ancestor's subtree is collected for sure
+            if (registry.all_of<TransformComponent, WorldTransformComponent, TransformDirtyComponent>(hierarchy->parent)) {
+                return true;
+            }
+            hierarchy = registry.try_get<HierarchyComponent>(hierarchy->parent);
+        }
+        return false;
+    }
+
+    void TransformSystem::computeBatch(std::size_t count) {
+        using simd::FloatV;
+        const FloatV one = simd::set1(1.0f);
+        const FloatV two = simd::set1(2.0f);
+
+        for (std::size_t i = 0; i < count; i += simd::kWidth) {
+            auto in = [&](Input input) { return simd::load(inputs_[input].data() + i); };
+            auto out = [&](Output output, FloatV value) { simd::store(outputs_[output].data() + i, value); };
+
+            const FloatV sx = in(SinX), sy = in(SinY), sz = in(SinZ);
+            const FloatV cx = in(CosX), cy = in(CosY), cz = in(CosZ);
+
+            // Quaternion of the Euler angles, as glm::quat(eulerAngles) builds it
+            const FloatV w = cx * cy * cz + sx * sy * sz;
+            const FloatV x = sx * cy * cz - cx * sy * sz;
+            const FloatV y = cx * sy * cz + sx * cy * sz;
+            const FloatV z = cx * cy * sz - sx * sy * cz;
+
+            const FloatV xx = x * x, yy = y * y, zz = z * z;
+            const FloatV xy = x * y, xz = x * z, yz = y * z;
+            const FloatV wx = w * x, wy = w * y, wz = w * z;
+
+            // Rotation columns, as glm::mat3_cast
+            const FloatV r00 = one - two * (yy + zz), r01 = two * (xy + wz), r02 = two * (xz - wy);
+            const FloatV r10 = two * (xy - wz), r11 = one - two * (xx + zz), r12 = two * (yz + wx);
+            const FloatV r20 = two * (xz + wy), r21 = two * (yz - wx), r22 = one - two * (xx + yy);
+
+            // World = R * S scales column k by s_k; its inverse transpose R * S^-1 divides it instead
+            const FloatV scaleX = in(ScaleX), scaleY = in(ScaleY), scaleZ = in(ScaleZ);
+            out(World00, r00 * scaleX); out(World01, r01 * scaleX); out(World02, r02 * scaleX);
+            out(World10, r10 * scaleY); out(World11, r11 * scaleY); out(World12, r12 * scaleY);
+            out(World20, r20 * scaleZ); out(World21, r21 * scaleZ); out(World22, r22 * scaleZ);
+
+            const FloatV inverseX = in(InverseScaleX), inverseY = in(InverseScaleY), inverseZ = in(InverseScaleZ);
+            out(Normal00, r00 * inverseX); out(Normal01, r01 * inverseX); out(Normal02, r02 * inverseX);
+            out(Normal10, r10 * inverseY); out(Normal11, r11 * inverseY); out(Normal12, r12 * inverseY);
+            out(Normal20, r20 * inverseZ); out(Normal21, r21 * inverseZ); out(Normal22, r22 * inverseZ);
+        }
+    }
+
+    void TransformSystem::setTransform(Scene& scene, const UUID& uuid, const TransformComponent& transform) {
+        scene.addComponent<TransformComponent>(uuid) = transform;
+        markDirty(scene, uuid);
+    }
+
+    void TransformSystem::setParent(Scene& scene, const UUID& child, const UUID& parent) {
+        auto& registry = scene.getRegistry();
+        const auto childEntity = scene.getEntity(child);
+        if (childEntity == entt::null) {
+            return;
+        }
+        const auto parentEntity = scene.getEntity(parent);
+
+        for (auto ancestor = parentEntity; ancestor != entt::null && registry.valid(ancestor);) {
+            if (ancestor == childEntity) {
+                spdlog::error("Cannot parent an entity under its own descendant");
+                return;
+            }
+            const auto* hierarchy = registry.try_get<HierarchyComponent>(ancestor);
+            ancestor = hierarchy ? hierarchy->parent : entt::null;
+        }
+
+        auto& hierarchy = registry.all_of<HierarchyComponent>(childEntity)
+                          ? registry.get<HierarchyComponent>(childEntity)
+                          : registry.emplace<HierarchyComponent>(childEntity);
+        if (hierarchy.parent != entt::null && registry.valid(hierarchy.parent)) {
+            auto& siblings = registry.get<HierarchyComponent>(hierarchy.parent).children;
+            siblings.erase(std::remove(siblings.begin(), siblings.end(), childEntity), siblings.end());
+        }
+
+        uint32_t depth = 0;
+        hierarchy.parent = parentEntity;
+        if (parentEntity != entt::null) {
+            auto& parentHierarchy = registry.all_of<HierarchyComponent>(parentEntity)
+                                    ? registry.get<HierarchyComponent>(parentEntity)
+                                    : registry.emplace<HierarchyComponent>(parentEntity);
+            parentHierarchy.children.push_back(childEntity);
+            depth = parentHierarchy.depth + 1;
+        }
+        updateDepths(registry, childEntity, depth);
+        markDirty(scene, child);
+    }
+
+    void TransformSystem::updateDepths(entt::registry& registry, entt::entity entity, uint32_t depth) {
+        auto& hierarchy = registry.get<HierarchyComponent>(entity);
+        if (hierarchy.depth == depth) {
+            return; // Depths below are kept consistent, so the subtree is already right
+        }
+        hierarchy.depth = depth;
+        for (auto child : hierarchy.children) {
+            updateDepths(registry, child, depth + 1);
+        }
+    }
+
+    void TransformSystem::markDirty(Scene& scene, const UUID& uuid) {
+        const auto entity = scene.getEntity(uuid);
+        if (entity != entt::null) {
+            // Empty tags have no instance to return, so this bypasses Scene::addComponent
+            scene.getRegistry().emplace_or_replace<TransformDirtyComponent>(entity);
+        }
+    }
+
+} // namespace s3Dive
@@ -0,0 +1,79 @@
+#ifndef THREEDIVE_TRANSFORMSYSTEM_H
+#define THREEDIVE_TRANSFORMSYSTEM_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "system.h"
+#include "components.h"
+
+namespace s3Dive {
+
+    // Keeps WorldTransformComponent in sync with TransformComponent and the hierarchy. Entities whose transform
+    // was added, replaced or patched get a world transform and are flagged dirty; dirty entities are gathered
+    // into SoA arrays and their local and local normal matrices computed simd::kWidth at a time. World matrices
+    // are then rebuilt for the dirty entities' subtrees only, breadth first: every entity of one depth reads
+    // parents of the previous depth, so each level is processed in parallel. Entities that did not move cost
+    // nothing. Rebuilt world transforms are patched afterwards, so WorldTransformComponent subscribers see the
+    // whole subtree change.
+    class TransformSystem : public System {
+    public:
+        struct Statistics {
+            uint32_t updatedTransforms = 0;    // Dirty entities whose local matrices were rebuilt by the last update
+            uint32_t propagatedTransforms = 0; // World matrices rebuilt, i.e. the dirty entities' subtrees
+            uint32_t levels = 0;               // Depths the propagation went through
+        };
+
+        void update(Scene& scene, float deltaTime) override;
+        // Structural: gives new transforms a WorldTransformComponent and clears the dirty tags
+        void declareAccess(SystemAccess& access) const override {
+            access.structural().reads<TransformComponent, HierarchyComponent>().writes<WorldTransformComponent>();
+        }
+
+        // Replaces the local transform and flags it for the next update
+        static void setTransform(Scene& scene, const UUID& uuid, const TransformComponent& transform);
+        // Flags an entity whose TransformComponent was edited in place; registry.patch does the same
+        static void markDirty(Scene& scene, const UUID& uuid);
+        // Attaches child under parent, or makes it a root when parent is not an entity. Refused, with an error
+        // logged, when parent is inside the child's own subtree.
+        static void setParent(Scene& scene, const UUID& child, const UUID& parent);
+
+        [[nodiscard]] const Statistics& getStatistics() const noexcept { return statistics_; }
+
+    private:
+        // Half-angle sines and cosines of the Euler rotation, scale and its reciprocal
+        enum Input {
+            SinX, SinY, SinZ, CosX, CosY, CosZ,
+            ScaleX, ScaleY, ScaleZ, InverseScaleX, InverseScaleY, InverseScaleZ,
+            InputCount
+        };
+
+        // Upper 3x3 of the world matrix and the normal matrix, column-major
+        enum Output {
+            World00, World01, World02, World10, World11, World12, World20, World21, World22,
+            Normal00, Normal01, Normal02, Normal10, Normal11, Normal12, Normal20, Normal21, Normal22,
+            OutputCount
+        };
+
+        void computeBatch(std::size_t count);
+        void propagate(entt::registry& registry);
+        // Appends the entity and its descendants to levels_ by depth
+        void collectSubtree(const entt::registry& registry, entt::entity root);
+
+        [[nodiscard]] static bool hasDirtyAncestor(const entt::registry& registry, entt::entity entity);
+        static void updateDepths(entt::registry& registry, entt::entity entity, uint32_t depth);
+
+        ChangeSet* transformChanges_ = nullptr; // Subscribed on the first update; one scene per system
+
+        // Reused across updates so steady-state edits do not allocate
+        std::vector<entt::entity> entities_;
+        std::vector<std::vector<entt::entity>> levels_; // Entities to propagate, by depth
+        std::vector<entt::entity> stack_;
+        std::array<std::vector<float>, InputCount> inputs_;
+        std::array<std::vector<float>, OutputCount> outputs_;
+        Statistics statistics_;
+    };
+
+} // namespace s3Dive
+
+#endif //THREEDIVE_TRANSFORMSYSTEM_H
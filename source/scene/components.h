@@ -8,6 +8,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <entt/entity/registry.hpp>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -16,6 +17,10 @@
 #include "../core/uuid.h"
 #include "../platform/openGLRender/gl_texture.h"
 #include "../platform/openGLRender/gl_vertex_array.h"
+#include "../renderer/GeometryArena.h"
+#include "../renderer/OcclusionCuller.h"
+#include "../renderer/UniformBlocks.h"
+#include "MeshBounds.h"
 
 namespace s3Dive {
 
@@ -28,6 +33,7 @@ namespace s3Dive {
         TransformComponent(const glm::vec3& translation, const glm::vec3& rotation, const glm::vec3& scale)
                 : Translation(translation), Rotation(rotation), Scale(scale) {}
 
+        // Builds the matrix from scratch; per-frame code reads WorldTransformComponent instead
         glm::mat4 GetTransform() const {
             glm::mat4 rotation = glm::toMat4(glm::quat(Rotation));
             return glm::translate(glm::mat4(1.0f), Translation)
@@ -36,6 +42,25 @@ namespace s3Dive {
         }
     };
 
+    // Matrices of the entity's TransformComponent, composed with its parent's. TransformSystem adds it to every
+    // entity with a transform and recomputes it only for entities tagged TransformDirtyComponent and their subtrees.
+    struct WorldTransformComponent {
+        glm::mat4 world{1.0f};
+        glm::mat3 normal{1.0f}; // Inverse transpose of the upper 3x3 of world
+        glm::mat4 local{1.0f};  // TransformComponent as a matrix; cached so a parent move does not rebuild it
+        glm::mat3 localNormal{1.0f};
+    };
+
+    // Parent/child links of the transform hierarchy; change them through TransformSystem::setParent, which keeps
+    // both sides and the depths consistent. Entities without one are roots.
+    struct HierarchyComponent {
+        entt::entity parent{entt::null};
+        std::vector<entt::entity> children;
+        uint32_t depth = 0; // Number of ancestors
+    };
+
+    // Tag: the TransformComponent changed since the last TransformSystem::update
+    struct TransformDirtyComponent {};
 
     struct MaterialComponent {
         glm::vec3 albedo = glm::vec3(0.435f, 0.435f, 0.435f);
@@ -43,6 +68,9 @@ namespace s3Dive {
         float roughness = 0.5f;
         float ao = 1.0f;
         std::shared_ptr<GLTexture> diffuseTexture;
+        // MaterialData block holding the values above, shared by every material with the same values. Rebuilt by
+        // RenderSystem whenever the component is added or patched, so edit the values and patch, never the block.
+        std::shared_ptr<const MaterialUniformBlock> uniforms;
     };
 
     enum class LightType {
@@ -67,13 +95,33 @@ namespace s3Dive {
         glm::vec2 TexCoords;
     };
 
+    // How the vertex shader decodes a quantized vertex buffer; the defaults describe plain float vertices
+    struct VertexQuantization {
+        glm::vec3 positionScale{1.0f, 1.0f, 1.0f};
+        glm::vec3 positionOffset{0.0f, 0.0f, 0.0f};
+        bool octahedralNormals = false;
+    };
+
+    // Geometry loaded once per imported mesh and shared by every entity that references it
+    struct MeshAsset {
+        std::shared_ptr<const GeometryAllocation> geometry; // Ranges in the shared GeometryArena buffers
+        VertexQuantization quantization;
+        MeshBounds bounds;
+        std::shared_ptr<const OccluderMesh> occluder; // Null for meshes too dense to rasterize as an occluder
+    };
+
     struct MeshComponent {
-        std::vector<Vertex> vertices;
-        std::vector<unsigned int> indices;
-        std::shared_ptr<GLVertexArray> vertexArray;
+        std::shared_ptr<const MeshAsset> asset;
         bool isInitialized = false;
     };
 
+    // World-space box of a mesh entity, kept by RenderSystem::update for entities whose world transform or mesh
+    // changed, so culling does not transform every mesh's bounds every frame; SpatialIndexSystem indexes it
+    struct WorldBoundsComponent {
+        glm::vec3 center{0.0f};
+        glm::vec3 extent{0.0f};
+    };
+
     struct ModelComponent {
         std::string filepath;
         std::vector<s3Dive::UUID> meshEntities;  // UUIDs of associated mesh entities
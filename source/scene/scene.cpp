@@ -7,32 +7,56 @@
 namespace s3Dive {
 
     entt::entity Scene::createEntity() {
-        UUID uuid{};
         entt::entity entity = registry_.create();
-        addEntity(uuid, entity);
+        const auto& uuid = registry_.emplace<UUIDComponent>(entity).uuid;
+        entitiesMap_.insertOrAssign(uuid.value(), entity);
         return entity;
     }
 
+    std::vector<entt::entity> Scene::createEntities(std::size_t count) {
+        std::vector<UUID> uuids;
+        uuids.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            uuids.emplace_back();
+        }
+        return createEntities(uuids);
+    }
+
+    std::vector<entt::entity> Scene::createEntities(const std::vector<UUID>& uuids) {
+        std::vector<entt::entity> entities(uuids.size());
+        std::vector<UUIDComponent> components;
+        components.reserve(uuids.size());
+        for (const auto& uuid : uuids) {
+            components.push_back({uuid});
+        }
+        registry_.create(entities.begin(), entities.end());
+        // One pool insertion and at most one rehash for the whole batch
+        registry_.insert<UUIDComponent>(entities.begin(), entities.end(), components.begin());
+        entitiesMap_.reserve(entitiesMap_.size() + uuids.size());
+        for (std::size_t i = 0; i < uuids.size(); ++i) {
+            entitiesMap_.insertOrAssign(uuids[i].value(), entities[i]);
+        }
+        return entities;
+    }
+
     void Scene::destroyEntity(const UUID& uuid) {
-        auto it = entitiesMap_.find(uuid);
-        if (it != entitiesMap_.end()) {
-            registry_.destroy(it->second);
-            entitiesMap_.erase(it);
+        if (const auto* entity = entitiesMap_.find(uuid.value())) {
+            registry_.destroy(*entity);
+            entitiesMap_.erase(uuid.value());
         }
     }
 
     entt::entity Scene::getEntity(const UUID& uuid) const noexcept {
-        auto it = entitiesMap_.find(uuid);
-        return (it != entitiesMap_.end()) ? it->second : entt::null;
+        const auto* entity = entitiesMap_.find(uuid.value());
+        return entity ? *entity : entt::null;
     }
 
     std::optional<UUID> Scene::getEntityUUID(entt::entity entity) const {
-        for (const auto& [uuid, e] : entitiesMap_) {
-            if (e == entity) {
-                return uuid;
-            }
+        if (!registry_.valid(entity)) {
+            return std::nullopt;
         }
-        return std::nullopt;
+        const auto* component = registry_.try_get<UUIDComponent>(entity);
+        return component ? std::optional<UUID>(component->uuid) : std::nullopt;
     }
 
     void Scene::clear() {
@@ -40,8 +64,4 @@ namespace s3Dive {
         entitiesMap_.clear();
     }
 
-    void Scene::addEntity(const UUID& uuid, entt::entity entity) {
-        entitiesMap_[uuid] = entity;
-    }
-
-} // namespace s3Dive
\ No newline at end of file
+} // namespace s3Dive
@@ -1,34 +1,52 @@
 #ifndef THREEDIVE_SCENE_H
 #define THREEDIVE_SCENE_H
 
-#include <unordered_map>
+#include <cstddef>
 #include <optional>
+#include <stdexcept>
+#include <vector>
 #include <entt/entity/registry.hpp>
+#include "../core/flat_hash_map.h"
 #include "../core/uuid.h"
+#include "ChangeTracker.h"
 
 namespace s3Dive {
 
+    // Every entity created through a Scene carries its UUID, so entity to UUID is a component lookup
+    struct UUIDComponent {
+        UUID uuid;
+    };
+
     class Scene {
     public:
-        using EntityMap = std::unordered_map<UUID, entt::entity>;
+        // UUID value to entity
+        using EntityMap = FlatHashMap<uint64_t, entt::entity>;
 
-        Scene() = default;
+        Scene() : changeTracker_(registry_) {}
         ~Scene() = default;
 
+        // Pinned: the change tracker is connected to this registry's signals
         Scene(const Scene&) = delete;
         Scene& operator=(const Scene&) = delete;
-        Scene(Scene&&) noexcept = default;
-        Scene& operator=(Scene&&) noexcept = default;
+        Scene(Scene&&) = delete;
+        Scene& operator=(Scene&&) = delete;
 
         [[nodiscard]] entt::registry& getRegistry() noexcept { return registry_; }
         [[nodiscard]] const entt::registry& getRegistry() const noexcept { return registry_; }
+        [[nodiscard]] ChangeTracker& getChangeTracker() noexcept { return changeTracker_; }
         [[nodiscard]] const EntityMap& getEntities() const noexcept { return entitiesMap_; }
 
         [[nodiscard]] entt::entity createEntity();
+        // Creates count entities at once, each with a fresh UUID; cheaper than as many createEntity calls
+        [[nodiscard]] std::vector<entt::entity> createEntities(std::size_t count);
+        // Same, with UUIDs generated beforehand, e.g. on the worker that staged the entities; none may be in use
+        [[nodiscard]] std::vector<entt::entity> createEntities(const std::vector<UUID>& uuids);
         void destroyEntity(const UUID& uuid);
 
         [[nodiscard]] entt::entity getEntity(const UUID& uuid) const noexcept;
         [[nodiscard]] std::optional<UUID> getEntityUUID(entt::entity entity) const;
+        // For entities known to come from this scene
+        [[nodiscard]] const UUID& getUUID(entt::entity entity) const { return registry_.get<UUIDComponent>(entity).uuid; }
 
         template<typename T, typename... Args>
         T& addComponent(const UUID& uuid, Args&&... args) {
@@ -89,8 +107,7 @@ namespace s3Dive {
     private:
         entt::registry registry_;
         EntityMap entitiesMap_;
-
-        void addEntity(const UUID& uuid, entt::entity entity);
+        ChangeTracker changeTracker_; // After registry_, so it disconnects before the registry goes away
     };
 
 } // namespace s3Dive
@@ -58,13 +58,17 @@ namespace s3Dive {
             calculateVisibility(currentDistanceToTarget);
         }
 
+        if (shaderProgram.getProgramId() != resolvedProgramId_) {
+            detailVisibility1Uniform_ = shaderProgram.getUniformHandle(kDetailVisibility1Uniform);
+            detailVisibility2Uniform_ = shaderProgram.getUniformHandle(kDetailVisibility2Uniform);
+            resolvedProgramId_ = shaderProgram.getProgramId();
+        }
+
         shaderProgram.use();
-        shaderProgram.updateShaderUniform("detailVisibility1", cachedDetailVisibility1_);
-        shaderProgram.updateShaderUniform("detailVisibility2", cachedDetailVisibility2_);
+        shaderProgram.updateShaderUniform(detailVisibility1Uniform_, cachedDetailVisibility1_);
+        shaderProgram.updateShaderUniform(detailVisibility2Uniform_, cachedDetailVisibility2_);
 
         RenderCommand::drawLines(vao_, static_cast<GLint>(grid.vertices.size() / 8));
-
-        shaderProgram.unuse();
     }
 
 } // namespace s3Dive
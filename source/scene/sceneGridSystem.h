@@ -17,6 +17,7 @@ namespace s3Dive {
         ~SceneGridSystem() override = default;
 
         void update(Scene& scene, float deltaTime) override;
+        void declareAccess(SystemAccess& access) const override { access.reads<SceneGridComponent>(); }
         void render(Scene& scene, GLShaderProgram& shaderProgram, const CameraController& cameraController) override;
 
     private:
@@ -27,6 +28,14 @@ namespace s3Dive {
         static constexpr float kDetailVisibilityNear2 = 10.0f;
         static constexpr float kDetailVisibilityFar2 = 20.0f;
 
+        static constexpr UniformName kDetailVisibility1Uniform{"detailVisibility1"};
+        static constexpr UniformName kDetailVisibility2Uniform{"detailVisibility2"};
+
+        // Resolved again only when a different program is passed in
+        GLuint resolvedProgramId_ = 0;
+        UniformHandle detailVisibility1Uniform_;
+        UniformHandle detailVisibility2Uniform_;
+
         // Cached values
         float cachedDistanceToTarget_ = -1.0f;
         float cachedDetailVisibility1_ = 0.0f;
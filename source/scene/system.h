@@ -5,17 +5,74 @@
 #ifndef THREEDIVE_SYSTEM_H
 #define THREEDIVE_SYSTEM_H
 
+#include <algorithm>
+#include <typeindex>
+#include <vector>
 #include "scene.h"
 #include "../platform/openGLRender/gl_shader_program.h"
 #include "../camera/camera_controller.h"
 
 namespace s3Dive {
 
+    // What a system's update touches, so SystemScheduler can run updates that do not conflict side by side
+    class SystemAccess {
+    public:
+        template<typename... Components>
+        SystemAccess& reads() {
+            (reads_.emplace_back(typeid(Components)), ...);
+            return *this;
+        }
+
+        template<typename... Components>
+        SystemAccess& writes() {
+            (writes_.emplace_back(typeid(Components)), ...);
+            return *this;
+        }
+
+        // Creates or destroys entities, or adds or removes components: conflicts with every other system
+        SystemAccess& structural() noexcept {
+            structural_ = true;
+            return *this;
+        }
+
+        // Needs the GL context, so the update runs on the thread that owns it
+        SystemAccess& mainThread() noexcept {
+            mainThread_ = true;
+            return *this;
+        }
+
+        [[nodiscard]] bool isStructural() const noexcept { return structural_; }
+        [[nodiscard]] bool isMainThread() const noexcept { return mainThread_; }
+
+        // Two updates conflict when either is structural or one writes a component the other reads or writes
+        [[nodiscard]] bool conflictsWith(const SystemAccess& other) const {
+            if (structural_ || other.structural_) {
+                return true;
+            }
+            auto intersects = [](const std::vector<std::type_index>& lhs, const std::vector<std::type_index>& rhs) {
+                return std::any_of(lhs.begin(), lhs.end(), [&rhs](const std::type_index& type) {
+                    return std::find(rhs.begin(), rhs.end(), type) != rhs.end();
+                });
+            };
+            return intersects(writes_, other.writes_) || intersects(writes_, other.reads_) ||
+                   intersects(reads_, other.writes_);
+        }
+
+    private:
+        std::vector<std::type_index> reads_;
+        std::vector<std::type_index> writes_;
+        bool structural_ = false;
+        bool mainThread_ = false;
+    };
+
     class System {
     public:
         virtual ~System() = default;
         virtual void update(Scene& scene, float deltaTime) {};
         virtual void render(Scene& scene, GLShaderProgram& shaderProgram, const CameraController& cameraController) {};
+
+        // Systems that do not override this are assumed to touch everything on the main thread, i.e. run alone
+        virtual void declareAccess(SystemAccess& access) const { access.structural().mainThread(); }
     };
 
 } // s3Dive
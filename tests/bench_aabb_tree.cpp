@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "../source/scene/DynamicAabbTree.h"
+
+
+using namespace s3Dive;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    struct Box {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    // Boxes of 0.5 to 2 units in a cube whose volume grows with the count, so the density stays the same
+    std::vector<Box> makeBoxes(std::size_t count, std::mt19937& random) {
+        const float worldSize = 2.0f * std::cbrt(static_cast<float>(count));
+        std::uniform_real_distribution<float> position(-worldSize, worldSize);
+        std::uniform_real_distribution<float> size(0.5f, 2.0f);
+        std::vector<Box> boxes(count);
+        for (auto& box : boxes) {
+            box.min = glm::vec3(position(random), position(random), position(random));
+            box.max = box.min + glm::vec3(size(random), size(random), size(random));
+        }
+        return boxes;
+    }
+
+    void bench(std::size_t count) {
+        std::mt19937 random(13);
+        auto boxes = makeBoxes(count, random);
+        const float worldSize = 2.0f * std::cbrt(static_cast<float>(count));
+
+        DynamicAabbTree tree(0.1f);
+        std::vector<int32_t> leaves(count);
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            leaves[i] = tree.insert(boxes[i].min, boxes[i].max, static_cast<uint32_t>(i));
+        }
+        const double insertMs = millisecondsSince(start);
+
+        // A tenth of the scene moves per frame: most by less than the margin, one in ten far enough to reinsert
+        constexpr int kFrames = 10;
+        std::uniform_real_distribution<float> jitter(-0.05f, 0.05f);
+        std::uniform_real_distribution<float> jump(-5.0f, 5.0f);
+        std::size_t updates = 0;
+        std::size_t reinserted = 0;
+        start = Clock::now();
+        for (int frame = 0; frame < kFrames; ++frame) {
+            for (std::size_t i = static_cast<std::size_t>(frame); i < count; i += kFrames) {
+                const glm::vec3 offset = (i / kFrames) % 10 == 0
+                                         ? glm::vec3(jump(random), jump(random), jump(random))
+                                         : glm::vec3(jitter(random), jitter(random), jitter(random));
+                boxes[i].min += offset;
+                boxes[i].max += offset;
+                reinserted += tree.update(leaves[i], boxes[i].min, boxes[i].max) ? 1 : 0;
+                ++updates;
+            }
+        }
+        const double updateMs = millisecondsSince(start) / kFrames;
+
+        // A camera at the edge of the world looking in, against testing every box
+        const glm::mat4 viewProjection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, worldSize) *
+                                         glm::lookAt(glm::vec3(0.0f, 0.0f, worldSize), glm::vec3(0.0f),
+                                                     glm::vec3(0.0f, 1.0f, 0.0f));
+        const Frustum frustum = Frustum::fromViewProjection(viewProjection);
+        constexpr int kQueries = 10;
+        std::size_t visible = 0;
+        start = Clock::now();
+        for (int query = 0; query < kQueries; ++query) {
+            visible = 0;
+            tree.queryFrustum(frustum, [&visible](uint32_t) { ++visible; });
+        }
+        const double frustumMs = millisecondsSince(start) / kQueries;
+
+        std::size_t bruteVisible = 0;
+        start = Clock::now();
+        for (int query = 0; query < kQueries; ++query) {
+            bruteVisible = 0;
+            for (const auto& box : boxes) {
+                bruteVisible += frustum.intersectsBox((box.min + box.max) * 0.5f, (box.max - box.min) * 0.5f) ? 1 : 0;
+            }
+        }
+        const double bruteMs = millisecondsSince(start) / kQueries;
+
+        // Picking: rays through random points, stopping at the first box entered
+        constexpr int kRays = 1000;
+        std::uniform_real_distribution<float> target(-worldSize, worldSize);
+        int hits = 0;
+        start = Clock::now();
+        for (int ray = 0; ray < kRays; ++ray) {
+            const glm::vec3 origin(0.0f, 0.0f, 2.0f * worldSize);
+            const glm::vec3 direction = glm::vec3(target(random), target(random), 0.0f) - origin;
+            const float distance = tree.raycast(origin, direction, 1.0f, [&boxes, &origin, &direction](uint32_t userData) {
+                // Entry distance into the exact box
+                const Box& box = boxes[userData];
+                float tMin = 0.0f;
+                float tMax = 1.0f;
+                for (int axis = 0; axis < 3; ++axis) {
+                    float t1 = (box.min[axis] - origin[axis]) / direction[axis];
+                    float t2 = (box.max[axis] - origin[axis]) / direction[axis];
+                    tMin = std::max(tMin, std::min(t1, t2));
+                    tMax = std::min(tMax, std::max(t1, t2));
+                }
+                return tMin <= tMax ? tMin : -1.0f;
+            });
+            hits += distance < 1.0f ? 1 : 0;
+        }
+        const double rayUs = millisecondsSince(start) * 1000.0 / kRays;
+
+        std::printf("%8zu boxes  insert %8.1f ms (%5.0f ns each)  height %2d  area ratio %6.1f\n", count, insertMs,
+                    insertMs * 1e6 / static_cast<double>(count), tree.getHeight(), tree.getAreaRatio());
+        std::printf("          update %8.3f ms/frame (%zu moved, %.1f%% reinserted)\n", updateMs, updates / kFrames,
+                    100.0 * static_cast<double>(reinserted) / static_cast<double>(updates));
+        std::printf("          frustum %7.3f ms (%zu boxes)  brute force %7.3f ms (%zu boxes, %.1fx)\n", frustumMs,
+                    visible, bruteMs, bruteVisible, bruteMs / frustumMs);
+        std::printf("          raycast %7.2f us (%d/%d hit)\n", rayUs, hits, kRays);
+    }
+
+} // namespace
+
+int main() {
+    bench(10000);
+    bench(100000);
+    bench(1000000);
+    return 0;
+}
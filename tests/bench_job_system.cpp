@@ -0,0 +1,108 @@
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "../source/core/job_system.h"
+
+
+using namespace s3Dive;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double nanosecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    }
+
+    // Empty jobs spawned from a thread outside the system: push, wake-up and steal costs
+    void benchSpawnFromOutside(JobSystem& jobSystem, int jobCount) {
+        std::atomic<int> counter{0};
+        const auto start = Clock::now();
+        {
+            TaskGroup group(jobSystem);
+            for (int i = 0; i < jobCount; ++i) {
+                group.run([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+            }
+            group.wait();
+        }
+        std::printf("spawn from outside   %8d jobs  %8.1f ns/job\n", jobCount, nanosecondsSince(start) / jobCount);
+    }
+
+    // One job fans out on a worker, so everyone else has to steal from that worker's deque
+    void benchStealFromOneWorker(JobSystem& jobSystem, int jobCount) {
+        jobSystem.resetStatistics();
+        std::atomic<int> counter{0};
+        const auto start = Clock::now();
+        {
+            TaskGroup root(jobSystem);
+            root.run([&jobSystem, &counter, jobCount] {
+                TaskGroup children(jobSystem);
+                for (int i = 0; i < jobCount; ++i) {
+                    children.run([&counter] { counter.fetch_add(1, std::memory_order_relaxed); });
+                }
+                children.wait();
+            });
+            root.wait();
+        }
+        const double elapsed = nanosecondsSince(start);
+
+        uint64_t stolen = 0;
+        for (const auto& worker : jobSystem.getWorkerStatistics()) {
+            stolen += worker.jobsStolen;
+        }
+        std::printf("fan out on a worker  %8d jobs  %8.1f ns/job  %llu stolen\n", jobCount, elapsed / jobCount,
+                    static_cast<unsigned long long>(stolen));
+    }
+
+    void benchParallelFor(JobSystem& jobSystem, std::size_t count) {
+        std::vector<float> values(count, 2.0f);
+        auto work = [&values](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                values[i] = std::sqrt(values[i] * values[i] + 1.0f);
+            }
+        };
+
+        auto start = Clock::now();
+        work(0, count);
+        const double serial = nanosecondsSince(start);
+
+        jobSystem.resetStatistics();
+        start = Clock::now();
+        jobSystem.parallelFor(count, work);
+        const double parallel = nanosecondsSince(start);
+
+        std::printf("parallelFor          %8zu items serial %.2f ms, parallel %.2f ms (x%.2f)\n", count,
+                    serial * 1e-6, parallel * 1e-6, serial / parallel);
+    }
+
+    void printUtilization(const JobSystem& jobSystem) {
+        const auto statistics = jobSystem.getWorkerStatistics();
+        for (std::size_t i = 0; i < statistics.size(); ++i) {
+            const auto& worker = statistics[i];
+            std::printf("  worker %2zu: %8llu jobs, %8llu stolen, %5.1f%% busy\n", i,
+                        static_cast<unsigned long long>(worker.jobsExecuted),
+                        static_cast<unsigned long long>(worker.jobsStolen), worker.getUtilization() * 100.0);
+        }
+    }
+
+} // namespace
+
+int main() {
+    JobSystem jobSystem;
+    std::printf("%zu workers\n", jobSystem.getWorkerCount());
+
+    for (int jobCount : {1000, 100000}) {
+        benchSpawnFromOutside(jobSystem, jobCount);
+    }
+    for (int jobCount : {1000, 100000}) {
+        benchStealFromOneWorker(jobSystem, jobCount);
+    }
+    printUtilization(jobSystem);
+
+    benchParallelFor(jobSystem, std::size_t{1} << 24);
+    printUtilization(jobSystem);
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "../source/scene/scene.h"
+
+
+using namespace s3Dive;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Same shapes as the engine's components, without the GL objects behind them
+    struct Asset {
+        glm::vec3 center{0.0f};
+        glm::vec3 extent{1.0f};
+    };
+    struct WorldTransform {
+        glm::mat4 world{1.0f};
+        glm::mat3 normal{1.0f};
+        glm::mat4 local{1.0f};
+        glm::mat3 localNormal{1.0f};
+    };
+    struct Mesh {
+        std::shared_ptr<const Asset> asset;
+        bool isInitialized = true;
+    };
+    struct Material {
+        glm::vec4 baseColor{1.0f};
+        float metallic = 0.0f;
+        float roughness = 1.0f;
+        std::shared_ptr<int> textures[4];
+    };
+    struct Model {
+        std::vector<UUID> meshEntities;
+    };
+
+    struct Candidate {
+        const Asset* asset;
+        const Material* material;
+        const WorldTransform* transform;
+        glm::vec3 center;
+    };
+
+    // A model import: per node one transform-only entity, and kMeshesPerNode mesh entities under it, so the
+    // transform pool interleaves nodes and meshes as it does in the engine
+    void populate(Scene& scene, std::size_t meshCount) {
+        constexpr std::size_t kMeshesPerNode = 4;
+        const auto asset = std::make_shared<const Asset>();
+        auto& registry = scene.getRegistry();
+        const auto model = scene.createEntity();
+        auto& meshEntities = registry.emplace<Model>(model).meshEntities;
+
+        std::mt19937 random(7);
+        for (std::size_t created = 0; created < meshCount; created += kMeshesPerNode) {
+            registry.emplace<WorldTransform>(scene.createEntity());
+            for (auto entity : scene.createEntities(std::min(kMeshesPerNode, meshCount - created))) {
+                WorldTransform transform;
+                transform.world[3] = glm::vec4(static_cast<float>(random() % 1000), 0.0f, 0.0f, 1.0f);
+                registry.emplace<WorldTransform>(entity, transform);
+                registry.emplace<Mesh>(entity, Mesh{asset});
+                registry.emplace<Material>(entity);
+                meshEntities.push_back(scene.getUUID(entity));
+            }
+        }
+    }
+
+    void push(std::vector<Candidate>& candidates, const WorldTransform& transform, const Mesh& mesh,
+              const Material& material) {
+        if (!mesh.isInitialized || !mesh.asset) {
+            return;
+        }
+        const glm::vec3 center = glm::vec3(transform.world * glm::vec4(mesh.asset->center, 1.0f));
+        candidates.push_back({mesh.asset.get(), &material, &transform, center});
+    }
+
+    // RenderSystem before: per model, resolve every mesh UUID and fetch its components one by one
+    double gatherByModel(Scene& scene, std::vector<Candidate>& candidates, int frames) {
+        const auto& registry = scene.getRegistry();
+        const auto start = Clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            candidates.clear();
+            for (auto modelEntity : registry.view<Model>()) {
+                for (const auto& uuid : registry.get<Model>(modelEntity).meshEntities) {
+                    const auto entity = scene.getEntity(uuid);
+                    if (entity == entt::null) {
+                        continue;
+                    }
+                    const auto* mesh = registry.try_get<Mesh>(entity);
+                    const auto* material = registry.try_get<Material>(entity);
+                    const auto* transform = registry.try_get<WorldTransform>(entity);
+                    if (mesh && material && transform) {
+                        push(candidates, *transform, *mesh, *material);
+                    }
+                }
+            }
+        }
+        return millisecondsSince(start) / frames;
+    }
+
+    // RenderSystem after: an owning group walks three packed arrays in step
+    double gatherByGroup(Scene& scene, std::vector<Candidate>& candidates, int frames) {
+        auto group = scene.getRegistry().group<WorldTransform, Mesh, Material>();
+        const auto start = Clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            candidates.clear();
+            group.each([&candidates](const WorldTransform& transform, const Mesh& mesh, const Material& material) {
+                push(candidates, transform, mesh, material);
+            });
+        }
+        return millisecondsSince(start) / frames;
+    }
+
+    void bench(std::size_t meshCount, int frames) {
+        std::vector<Candidate> candidates;
+        candidates.reserve(meshCount);
+
+        Scene scene;
+        populate(scene, meshCount);
+        const double byModel = gatherByModel(scene, candidates, frames);
+        const std::size_t byModelCount = candidates.size();
+        // Created after the by-model run; creating it reorders the pools
+        const double byGroup = gatherByGroup(scene, candidates, frames);
+
+        std::printf("%7zu meshes  by model %8.3f ms  owning group %8.3f ms  (%.1fx, %zu/%zu candidates)\n",
+                    meshCount, byModel, byGroup, byModel / byGroup, byModelCount, candidates.size());
+    }
+
+} // namespace
+
+int main() {
+    bench(10000, 50);
+    bench(100000, 20);
+    return 0;
+}
@@ -0,0 +1,164 @@
+#include <chrono>
+#include <cstdio>
+#include <unordered_map>
+#include <vector>
+
+#include "../source/scene/scene.h"
+
+
+using namespace s3Dive;
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    double millisecondsSince(Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    struct Position { float x, y, z; };
+    struct Velocity { float x, y, z; };
+    struct Color { float r, g, b; };
+
+    // The scene before UUIDs were components: std::unordered_map by UUID, entity to UUID by scanning the map
+    struct LegacyScene {
+        entt::registry registry;
+        std::unordered_map<UUID, entt::entity> entities;
+
+        entt::entity createEntity() {
+            const auto entity = registry.create();
+            entities[UUID{}] = entity;
+            return entity;
+        }
+
+        UUID getEntityUUID(entt::entity entity) const {
+            for (const auto& [uuid, e] : entities) {
+                if (e == entity) {
+                    return uuid;
+                }
+            }
+            return UUID{0};
+        }
+
+        entt::entity getEntity(const UUID& uuid) const {
+            auto it = entities.find(uuid);
+            return it != entities.end() ? it->second : entt::null;
+        }
+    };
+
+    void addComponents(entt::registry& registry, entt::entity entity) {
+        registry.emplace<Position>(entity, Position{1.0f, 2.0f, 3.0f});
+        registry.emplace<Velocity>(entity, Velocity{0.0f, 1.0f, 0.0f});
+        registry.emplace<Color>(entity, Color{1.0f, 1.0f, 1.0f});
+    }
+
+    // What ModelLoadingSystem does per mesh: create, then look the new entity's UUID up
+    void benchImport(std::size_t count) {
+        double legacyMs = -1.0;
+        if (count <= 20000) { // Quadratic; larger counts take minutes
+            LegacyScene legacy;
+            const auto start = Clock::now();
+            for (std::size_t i = 0; i < count; ++i) {
+                volatile auto uuid = legacy.getEntityUUID(legacy.createEntity()).value();
+                (void)uuid;
+            }
+            legacyMs = millisecondsSince(start);
+        }
+
+        Scene single;
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < count; ++i) {
+            volatile auto uuid = single.getUUID(single.createEntity()).value();
+            (void)uuid;
+        }
+        const double singleMs = millisecondsSince(start);
+
+        Scene bulk;
+        start = Clock::now();
+        const auto entities = bulk.createEntities(count);
+        for (auto entity : entities) {
+            volatile auto uuid = bulk.getUUID(entity).value();
+            (void)uuid;
+        }
+        const double bulkMs = millisecondsSince(start);
+
+        if (legacyMs >= 0.0) {
+            std::printf("import %7zu entities  legacy %9.2f ms  createEntity %7.2f ms  createEntities %7.2f ms\n",
+                        count, legacyMs, singleMs, bulkMs);
+        } else {
+            std::printf("import %7zu entities  legacy   skipped     createEntity %7.2f ms  createEntities %7.2f ms\n",
+                        count, singleMs, bulkMs);
+        }
+    }
+
+    // What RenderSystem does per mesh and frame: UUID to entity, then three components
+    void benchFrame(std::size_t count, int frames) {
+        LegacyScene legacy;
+        std::vector<UUID> legacyUUIDs;
+        legacyUUIDs.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            UUID uuid{};
+            const auto entity = legacy.registry.create();
+            legacy.entities[uuid] = entity;
+            addComponents(legacy.registry, entity);
+            legacyUUIDs.push_back(uuid);
+        }
+
+        Scene scene;
+        std::vector<UUID> uuids;
+        uuids.reserve(count);
+        for (auto entity : scene.createEntities(count)) {
+            addComponents(scene.getRegistry(), entity);
+            uuids.push_back(scene.getUUID(entity));
+        }
+
+        float sink = 0.0f;
+        auto start = Clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            for (const auto& uuid : legacyUUIDs) {
+                // hasComponent and getComponent by UUID each resolve the UUID again
+                if (legacy.getEntity(uuid) == entt::null || !legacy.registry.all_of<Position>(legacy.getEntity(uuid)) ||
+                    !legacy.registry.all_of<Velocity>(legacy.getEntity(uuid)) ||
+                    !legacy.registry.all_of<Color>(legacy.getEntity(uuid))) {
+                    continue;
+                }
+                sink += legacy.registry.get<Position>(legacy.getEntity(uuid)).x +
+                        legacy.registry.get<Velocity>(legacy.getEntity(uuid)).y +
+                        legacy.registry.get<Color>(legacy.getEntity(uuid)).r;
+            }
+        }
+        const double legacyMs = millisecondsSince(start) / frames;
+
+        const auto& registry = scene.getRegistry();
+        start = Clock::now();
+        for (int frame = 0; frame < frames; ++frame) {
+            for (const auto& uuid : uuids) {
+                const auto entity = scene.getEntity(uuid);
+                if (entity == entt::null) {
+                    continue;
+                }
+                const auto* position = registry.try_get<Position>(entity);
+                const auto* velocity = registry.try_get<Velocity>(entity);
+                const auto* color = registry.try_get<Color>(entity);
+                if (position && velocity && color) {
+                    sink += position->x + velocity->y + color->r;
+                }
+            }
+        }
+        const double flatMs = millisecondsSince(start) / frames;
+
+        std::printf("frame  %7zu meshes    legacy %9.3f ms  flat map + try_get %7.3f ms  (%.0f)\n",
+                    count, legacyMs, flatMs, static_cast<double>(sink));
+    }
+
+} // namespace
+
+int main() {
+    for (std::size_t count : {1000, 10000, 20000, 100000}) {
+        benchImport(count);
+    }
+    for (std::size_t count : {1000, 10000, 100000}) {
+        benchFrame(count, 20);
+    }
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "../source/scene/DynamicAabbTree.h"
+
+
+using namespace s3Dive;
+
+namespace {
+
+    struct Box {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    Box randomBox(std::mt19937& random, float worldSize) {
+        std::uniform_real_distribution<float> position(-worldSize, worldSize);
+        std::uniform_real_distribution<float> size(0.1f, 2.0f);
+        const glm::vec3 min(position(random), position(random), position(random));
+        return {min, min + glm::vec3(size(random), size(random), size(random))};
+    }
+
+    bool overlaps(const Box& a, const glm::vec3& min, const glm::vec3& max) {
+        return a.min.x <= max.x && a.min.y <= max.y && a.min.z <= max.z &&
+               a.max.x >= min.x && a.max.y >= min.y && a.max.z >= min.z;
+    }
+
+    // Brute-force reference, over the same fat boxes the tree stores
+    Box fatten(const Box& box, float margin) {
+        return {box.min - glm::vec3(margin), box.max + glm::vec3(margin)};
+    }
+
+    std::vector<uint32_t> sorted(std::vector<uint32_t> values) {
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+
+} // namespace
+
+TEST(DynamicAabbTreeTest, EmptyTreeReturnsNothing) {
+    DynamicAabbTree tree;
+    int calls = 0;
+    tree.queryBox(glm::vec3(-1.0f), glm::vec3(1.0f), [&](uint32_t) { ++calls; });
+    const float distance = tree.raycast(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), 10.0f,
+                                        [&](uint32_t) { ++calls; return 0.0f; });
+    EXPECT_EQ(calls, 0);
+    EXPECT_EQ(distance, 10.0f);
+    EXPECT_EQ(tree.getHeight(), 0);
+    EXPECT_TRUE(tree.validate());
+}
+
+TEST(DynamicAabbTreeTest, StaysBalancedUnderSortedInsertion) {
+    // Inserting along a line is the worst case for a tree without rotations
+    DynamicAabbTree tree(0.0f);
+    constexpr int kCount = 4096;
+    for (int i = 0; i < kCount; ++i) {
+        const glm::vec3 min(static_cast<float>(i), 0.0f, 0.0f);
+        tree.insert(min, min + glm::vec3(0.5f), static_cast<uint32_t>(i));
+    }
+    EXPECT_TRUE(tree.validate());
+    EXPECT_EQ(tree.getLeafCount(), static_cast<std::size_t>(kCount));
+    EXPECT_LE(tree.getHeight(), 2 * 12 + 2);
+}
+
+TEST(DynamicAabbTreeTest, BoxQueryMatchesBruteForce) {
+    std::mt19937 random(11);
+    constexpr float kMargin = 0.1f;
+    DynamicAabbTree tree(kMargin);
+    std::vector<Box> boxes;
+    for (uint32_t i = 0; i < 2000; ++i) {
+        boxes.push_back(randomBox(random, 50.0f));
+        tree.insert(boxes.back().min, boxes.back().max, i);
+    }
+    ASSERT_TRUE(tree.validate());
+
+    for (int query = 0; query < 50; ++query) {
+        const Box region = randomBox(random, 50.0f);
+        const glm::vec3 min = region.min - glm::vec3(5.0f);
+        const glm::vec3 max = region.max + glm::vec3(5.0f);
+        std::vector<uint32_t> found;
+        tree.queryBox(min, max, [&](uint32_t userData) { found.push_back(userData); });
+
+        std::vector<uint32_t> expected;
+        for (uint32_t i = 0; i < boxes.size(); ++i) {
+            if (overlaps(fatten(boxes[i], kMargin), min, max)) {
+                expected.push_back(i);
+            }
+        }
+        EXPECT_EQ(sorted(found), expected);
+    }
+}
+
+TEST(DynamicAabbTreeTest, UpdateOnlyReinsertsBoxesThatLeaveTheirFatBox) {
+    DynamicAabbTree tree(0.5f);
+    const int32_t leaf = tree.insert(glm::vec3(0.0f), glm::vec3(1.0f), 7);
+    tree.insert(glm::vec3(10.0f), glm::vec3(11.0f), 8);
+
+    EXPECT_FALSE(tree.update(leaf, glm::vec3(0.25f), glm::vec3(1.25f)));
+    EXPECT_TRUE(tree.update(leaf, glm::vec3(5.0f), glm::vec3(6.0f)));
+    EXPECT_TRUE(tree.validate());
+    EXPECT_EQ(tree.getUserData(leaf), 7u);
+    EXPECT_EQ(tree.getFatMin(leaf), glm::vec3(4.5f));
+
+    std::vector<uint32_t> found;
+    tree.queryBox(glm::vec3(5.5f), glm::vec3(5.6f), [&](uint32_t userData) { found.push_back(userData); });
+    EXPECT_EQ(found, std::vector<uint32_t>{7});
+}
+
+TEST(DynamicAabbTreeTest, RandomEditsKeepTheTreeValid) {
+    std::mt19937 random(3);
+    DynamicAabbTree tree(0.1f);
+    std::vector<int32_t> leaves;
+    for (int step = 0; step < 20000; ++step) {
+        const auto action = random() % 4;
+        if (action == 0 && !leaves.empty()) {
+            const std::size_t index = random() % leaves.size();
+            tree.remove(leaves[index]);
+            leaves[index] = leaves.back();
+            leaves.pop_back();
+        } else if (action == 1 && !leaves.empty()) {
+            const Box box = randomBox(random, 20.0f);
+            tree.update(leaves[random() % leaves.size()], box.min, box.max);
+        } else {
+            const Box box = randomBox(random, 20.0f);
+            leaves.push_back(tree.insert(box.min, box.max, static_cast<uint32_t>(step)));
+        }
+        if (step % 1000 == 0) {
+            ASSERT_TRUE(tree.validate()) << step;
+        }
+    }
+    EXPECT_TRUE(tree.validate());
+    EXPECT_EQ(tree.getLeafCount(), leaves.size());
+}
+
+TEST(DynamicAabbTreeTest, FrustumQueryMatchesBruteForce) {
+    std::mt19937 random(5);
+    constexpr float kMargin = 0.1f;
+    DynamicAabbTree tree(kMargin);
+    std::vector<Box> boxes;
+    for (uint32_t i = 0; i < 3000; ++i) {
+        boxes.push_back(randomBox(random, 100.0f));
+        tree.insert(boxes.back().min, boxes.back().max, i);
+    }
+
+    const glm::mat4 viewProjection = glm::perspective(glm::radians(60.0f), 1.5f, 0.1f, 80.0f) *
+                                     glm::lookAt(glm::vec3(0.0f, 0.0f, 20.0f), glm::vec3(10.0f, 0.0f, 0.0f),
+                                                 glm::vec3(0.0f, 1.0f, 0.0f));
+    const Frustum frustum = Frustum::fromViewProjection(viewProjection);
+
+    std::vector<uint32_t> found;
+    tree.queryFrustum(frustum, [&](uint32_t userData) { found.push_back(userData); });
+
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+        const Box fat = fatten(boxes[i], kMargin);
+        if (frustum.intersectsBox((fat.min + fat.max) * 0.5f, (fat.max - fat.min) * 0.5f)) {
+            expected.push_back(i);
+        }
+    }
+    EXPECT_FALSE(expected.empty());
+    EXPECT_LT(expected.size(), boxes.size());
+    EXPECT_EQ(sorted(found), expected);
+}
+
+TEST(DynamicAabbTreeTest, RaycastFindsNearestHit) {
+    DynamicAabbTree tree(0.0f);
+    // A row of unit boxes along +X, at x = 2, 4, 6, ...
+    std::vector<Box> boxes;
+    for (uint32_t i = 0; i < 100; ++i) {
+        const glm::vec3 min(2.0f * static_cast<float>(i + 1), -0.5f, -0.5f);
+        boxes.push_back({min, min + glm::vec3(1.0f)});
+        tree.insert(boxes.back().min, boxes.back().max, i);
+    }
+    // And one off the ray
+    tree.insert(glm::vec3(0.0f, 5.0f, 0.0f), glm::vec3(1.0f, 6.0f, 1.0f), 1000);
+
+    std::vector<uint32_t> visited;
+    const float distance = tree.raycast(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), 1000.0f,
+                                        [&](uint32_t userData) {
+                                            visited.push_back(userData);
+                                            return boxes[userData].min.x;
+                                        });
+    EXPECT_FLOAT_EQ(distance, 2.0f);
+    // Nearest first, so the first hit clips the ray and the far boxes are never tested
+    ASSERT_FALSE(visited.empty());
+    EXPECT_EQ(visited.front(), 0u);
+    EXPECT_LT(visited.size(), 10u);
+
+    // Misses leave the ray as it was
+    const float missed = tree.raycast(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f), 50.0f,
+                                      [](uint32_t) { return -1.0f; });
+    EXPECT_EQ(missed, 50.0f);
+}
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <unordered_map>
+
+#include "../source/core/flat_hash_map.h"
+
+
+using namespace s3Dive;
+
+TEST(FlatHashMapTest, InsertFindAndOverwrite) {
+    FlatHashMap<uint64_t, uint32_t> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.find(42), nullptr);
+
+    EXPECT_TRUE(map.insertOrAssign(42, 1));
+    EXPECT_FALSE(map.insertOrAssign(42, 2));
+    ASSERT_NE(map.find(42), nullptr);
+    EXPECT_EQ(*map.find(42), 2u);
+    EXPECT_EQ(map.size(), 1u);
+    EXPECT_FALSE(map.contains(43));
+}
+
+TEST(FlatHashMapTest, GrowsPastLoadFactor) {
+    FlatHashMap<uint64_t, uint64_t> map;
+    for (uint64_t key = 0; key < 10000; ++key) {
+        map.insertOrAssign(key, key * 3);
+    }
+    EXPECT_EQ(map.size(), 10000u);
+    EXPECT_GE(map.capacity() * 3, map.size() * 4);
+    for (uint64_t key = 0; key < 10000; ++key) {
+        ASSERT_NE(map.find(key), nullptr);
+        EXPECT_EQ(*map.find(key), key * 3);
+    }
+}
+
+TEST(FlatHashMapTest, ReserveAvoidsRehash) {
+    FlatHashMap<uint64_t, uint32_t> map;
+    map.reserve(1000);
+    const auto capacity = map.capacity();
+    for (uint64_t key = 0; key < 1000; ++key) {
+        map.insertOrAssign(key, 0);
+    }
+    EXPECT_EQ(map.capacity(), capacity);
+}
+
+TEST(FlatHashMapTest, EraseKeepsProbeRunsReachable) {
+    FlatHashMap<uint64_t, uint32_t> map;
+    for (uint64_t key = 0; key < 12; ++key) {
+        map.insertOrAssign(key, static_cast<uint32_t>(key));
+    }
+    // Erasing from the middle of runs must not hide the entries probed past them
+    for (uint64_t key = 0; key < 12; key += 2) {
+        EXPECT_TRUE(map.erase(key));
+    }
+    EXPECT_FALSE(map.erase(0));
+    EXPECT_EQ(map.size(), 6u);
+    for (uint64_t key = 0; key < 12; ++key) {
+        EXPECT_EQ(map.contains(key), key % 2 == 1) << key;
+    }
+}
+
+TEST(FlatHashMapTest, MatchesUnorderedMapUnderRandomEdits) {
+    FlatHashMap<uint64_t, uint64_t> map;
+    std::unordered_map<uint64_t, uint64_t> reference;
+    std::mt19937_64 random(7);
+    for (int i = 0; i < 200000; ++i) {
+        // A small key range keeps the map dense and its probe runs long
+        const uint64_t key = random() % 4096;
+        if (random() % 3 == 0) {
+            EXPECT_EQ(map.erase(key), reference.erase(key) == 1);
+        } else {
+            EXPECT_EQ(map.insertOrAssign(key, i), reference.insert_or_assign(key, i).second);
+        }
+    }
+    EXPECT_EQ(map.size(), reference.size());
+    std::size_t visited = 0;
+    map.forEach([&](uint64_t key, uint64_t value) {
+        ++visited;
+        ASSERT_EQ(reference.count(key), 1u);
+        EXPECT_EQ(reference.at(key), value);
+    });
+    EXPECT_EQ(visited, reference.size());
+}
+
+TEST(FlatHashMapTest, ClearKeepsCapacity) {
+    FlatHashMap<uint64_t, uint32_t> map;
+    for (uint64_t key = 0; key < 100; ++key) {
+        map.insertOrAssign(key, 0);
+    }
+    const auto capacity = map.capacity();
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.capacity(), capacity);
+    EXPECT_FALSE(map.contains(5));
+    map.insertOrAssign(5, 1);
+    EXPECT_TRUE(map.contains(5));
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "../source/renderer/OcclusionCuller.h"
+
+
+using namespace s3Dive;
+
+namespace {
+
+    // Camera at the origin looking down -Z, matching the engine's right-handed convention
+    glm::mat4 makeViewProjection(const OcclusionSettings& settings) {
+        const float aspect = static_cast<float>(settings.width) / static_cast<float>(settings.height);
+        return glm::perspective(glm::radians(60.0f), aspect, 0.1f, 100.0f) *
+               glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    }
+
+    // Unit quad in the XY plane, split along its diagonal
+    OccluderMesh makeQuad(bool counterClockwise = true) {
+        OccluderMesh quad;
+        quad.positions = {{-1.0f, -1.0f, 0.0f}, {1.0f, -1.0f, 0.0f}, {1.0f, 1.0f, 0.0f}, {-1.0f, 1.0f, 0.0f}};
+        quad.indices = counterClockwise ? std::vector<uint32_t>{0, 1, 2, 0, 2, 3}
+                                        : std::vector<uint32_t>{0, 2, 1, 0, 3, 2};
+        return quad;
+    }
+
+    glm::mat4 placeQuad(const glm::vec3& position, const glm::vec3& scale) {
+        return glm::scale(glm::translate(glm::mat4(1.0f), position), scale);
+    }
+
+} // namespace
+
+TEST(OcclusionCullerTest, EmptyDepthBufferHidesNothing) {
+    OcclusionCuller culler;
+    culler.beginFrame(makeViewProjection(culler.getSettings()));
+    culler.rasterize();
+
+    EXPECT_TRUE(culler.isVisible({0.0f, 0.0f, -20.0f}, {1.0f, 1.0f, 1.0f}));
+    EXPECT_FLOAT_EQ(culler.getDepth(0, 0), 1.0f);
+}
+
+TEST(OcclusionCullerTest, FullScreenOccluderHidesBoxesBehindIt) {
+    OcclusionCuller culler;
+    culler.beginFrame(makeViewProjection(culler.getSettings()));
+    culler.addOccluder(makeQuad(), placeQuad({0.0f, 0.0f, -5.0f}, {10.0f, 10.0f, 1.0f}));
+    culler.rasterize();
+
+    EXPECT_EQ(culler.getStatistics().trianglesRasterized, 2u);
+    EXPECT_LT(culler.getDepth(culler.getWidth() / 2, culler.getHeight() / 2), 1.0f);
+
+    EXPECT_FALSE(culler.isVisible({0.0f, 0.0f, -20.0f}, {1.0f, 1.0f, 1.0f}));
+    EXPECT_TRUE(culler.isVisible({0.0f, 0.0f, -3.0f}, {0.5f, 0.5f, 0.5f}));
+    // Pokes through the occluder
+    EXPECT_TRUE(culler.isVisible({0.0f, 0.0f, -6.0f}, {1.0f, 1.0f, 2.0f}));
+    // The occluder's own bounds must survive its own depth
+    EXPECT_TRUE(culler.isVisible({0.0f, 0.0f, -5.0f}, {10.0f, 10.0f, 0.0f}));
+    EXPECT_EQ(culler.getStatistics().occluded, 1u);
+}
+
+TEST(OcclusionCullerTest, WindingDoesNotMatter) {
+    OcclusionCuller culler;
+    culler.beginFrame(makeViewProjection(culler.getSettings()));
+    culler.addOccluder(makeQuad(false), placeQuad({0.0f, 0.0f, -5.0f}, {10.0f, 10.0f, 1.0f}));
+    culler.rasterize();
+
+    EXPECT_FALSE(culler.isVisible({0.0f, 0.0f, -20.0f}, {1.0f, 1.0f, 1.0f}));
+}
+
+TEST(OcclusionCullerTest, PartialOccluderOnlyHidesWhatItCovers) {
+    OcclusionCuller culler;
+    culler.beginFrame(makeViewProjection(culler.getSettings()));
+    // Covers the left half of the screen
+    culler.addOccluder(makeQuad(), placeQuad({-5.0f, 0.0f, -5.0f}, {5.0f, 10.0f, 1.0f}));
+    culler.rasterize();
+
+    EXPECT_FALSE(culler.isVisible({-3.0f, 0.0f, -20.0f}, {1.0f, 1.0f, 1.0f}));
+    EXPECT_TRUE(culler.isVisible({0.0f, 0.0f, -20.0f}, {2.0f, 2.0f, 2.0f}));
+    EXPECT_TRUE(culler.isVisible({3.0f, 0.0f, -20.0f}, {1.0f, 1.0f, 1.0f}));
+}
+
+TEST(OcclusionCullerTest, BoxesCrossingTheNearPlaneAreVisible) {
+    OcclusionCuller culler;
+    culler.beginFrame(makeViewProjection(culler.getSettings()));
+    culler.addOccluder(makeQuad(), placeQuad({0.0f, 0.0f, -5.0f}, {10.0f, 10.0f, 1.0f}));
+    culler.rasterize();
+
+    EXPECT_TRUE(culler.isVisible({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}));
+    EXPECT_FLOAT_EQ(culler.getScreenArea({0.0f, 0.0f, 0.0f}, {1.0f, 1.0f, 1.0f}), 1.0f);
+}
+
+TEST(OcclusionCullerTest, OccluderBehindTheCameraIsDropped) {
+    OcclusionCuller culler;
+    culler.beginFrame(makeViewProjection(culler.getSettings()));
+    culler.addOccluder(makeQuad(), placeQuad({0.0f, 0.0f, 5.0f}, {10.0f, 10.0f, 1.0f}));
+    culler.rasterize();
+
+    EXPECT_EQ(culler.getStatistics().trianglesRasterized, 0u);
+    EXPECT_TRUE(culler.isVisible({0.0f, 0.0f, -20.0f}, {1.0f, 1.0f, 1.0f}));
+}
+
+TEST(OcclusionCullerTest, BeginFrameClearsPreviousOccluders) {
+    OcclusionCuller culler;
+    const auto viewProjection = makeViewProjection(culler.getSettings());
+    culler.beginFrame(viewProjection);
+    culler.addOccluder(makeQuad(), placeQuad({0.0f, 0.0f, -5.0f}, {10.0f, 10.0f, 1.0f}));
+    culler.rasterize();
+    ASSERT_FALSE(culler.isVisible({0.0f, 0.0f, -20.0f}, {1.0f, 1.0f, 1.0f}));
+
+    culler.beginFrame(viewProjection);
+    culler.rasterize();
+    EXPECT_TRUE(culler.isVisible({0.0f, 0.0f, -20.0f}, {1.0f, 1.0f, 1.0f}));
+    EXPECT_EQ(culler.getStatistics().occluders, 0u);
+}